@@ -211,6 +211,26 @@ eventfd_write(fd, value);
 }
 ")
 
+# epoll
+qt_config_compile_test(epoll
+    LABEL "epoll"
+    CODE
+"#include <sys/epoll.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct epoll_event ev;
+ev.events = EPOLLIN;
+ev.data.fd = 0;
+int fd = epoll_create1(EPOLL_CLOEXEC);
+epoll_ctl(fd, EPOLL_CTL_ADD, 0, &ev);
+epoll_wait(fd, &ev, 1, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # futimens
 qt_config_compile_test(futimens
     LABEL "futimens()"
@@ -372,6 +392,29 @@ linkat(AT_FDCWD, \"foo\", AT_FDCWD, \"bar\", AT_SYMLINK_FOLLOW);
 }
 ")
 
+# io_uring
+qt_config_compile_test(io_uring
+    LABEL "io_uring"
+    CODE
+"#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct io_uring_params params = {};
+int fd = syscall(__NR_io_uring_setup, 1, &params);
+syscall(__NR_io_uring_enter, fd, 0, 1, IORING_ENTER_GETEVENTS, 0, 0);
+struct io_uring_sqe sqe = {};
+sqe.opcode = IORING_OP_READV;
+(void) (params.features & IORING_FEAT_SINGLE_MMAP);
+(void) IORING_OFF_SQES;
+    /* END TEST: */
+    return 0;
+}
+")
+
 # ppoll
 qt_config_compile_test(ppoll
     LABEL "ppoll()"
@@ -427,6 +470,26 @@ poll(&pfd, 1, 0);
 }
 ")
 
+# getdents64
+qt_config_compile_test(getdents64
+    LABEL "getdents64()"
+    CODE
+"#define _GNU_SOURCE 1
+#include <dirent.h>
+#include <fcntl.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+char buffer[4096];
+struct dirent64 *entry = (struct dirent64 *)buffer;
+int fd = open(\".\", O_RDONLY | O_DIRECTORY);
+return getdents64(fd, buffer, sizeof(buffer)) > 0 ? entry->d_type : 0;
+    /* END TEST: */
+    return 0;
+}
+")
+
 # renameat2
 qt_config_compile_test(renameat2
     LABEL "renameat2()"
@@ -569,6 +632,11 @@ qt_feature("eventfd" PUBLIC
     CONDITION NOT WASM AND TEST_eventfd
 )
 qt_feature_definition("eventfd" "QT_NO_EVENTFD" NEGATE VALUE "1")
+qt_feature("epoll" PRIVATE
+    LABEL "epoll"
+    PURPOSE "Lets the generic Unix event dispatcher (QT_NO_GLIB=1) watch socket notifiers with epoll() when QT_EVENT_DISPATCHER_EPOLL=1 is set."
+    CONDITION LINUX AND TEST_epoll
+)
 qt_feature("futimens" PRIVATE
     LABEL "futimens()"
     CONDITION NOT WIN32 AND TEST_futimens
@@ -656,6 +724,10 @@ qt_feature("system-pcre2" PRIVATE
     ENABLE INPUT_pcre STREQUAL 'system'
     DISABLE INPUT_pcre STREQUAL 'no' OR INPUT_pcre STREQUAL 'qt'
 )
+qt_feature("io_uring" PRIVATE
+    LABEL "io_uring"
+    CONDITION LINUX AND QT_FEATURE_future AND QT_FEATURE_cxx11_future AND TEST_io_uring
+)
 qt_feature("poll_ppoll" PRIVATE
     LABEL "Native ppoll()"
     CONDITION NOT WASM AND TEST_ppoll
@@ -682,6 +754,10 @@ qt_feature("qqnx_pps" PRIVATE
     CONDITION PPS_FOUND
     EMIT_IF QNX
 )
+qt_feature("getdents64" PRIVATE
+    LABEL "getdents64()"
+    CONDITION LINUX AND QT_FEATURE_largefile AND TEST_getdents64
+)
 qt_feature("renameat2" PRIVATE
     LABEL "renameat2()"
     CONDITION ( LINUX OR HURD ) AND TEST_renameat2
@@ -723,6 +799,13 @@ qt_feature("sharedmemory" PUBLIC
     CONDITION ( ANDROID OR WIN32 OR ( NOT VXWORKS AND ( TEST_ipc_sysv OR TEST_ipc_posix ) ) )
 )
 qt_feature_definition("sharedmemory" "QT_NO_SHAREDMEMORY" NEGATE VALUE "1")
+qt_feature("sharedmemorychannel" PUBLIC
+    SECTION "Kernel"
+    LABEL "QSharedMemoryChannel"
+    PURPOSE "Provides a lock-free message queue between processes in shared memory."
+    CONDITION QT_FEATURE_sharedmemory AND UNIX AND NOT ANDROID AND NOT WASM
+)
+qt_feature_definition("sharedmemorychannel" "QT_NO_SHAREDMEMORYCHANNEL" NEGATE VALUE "1")
 qt_feature("shortcut" PUBLIC
     SECTION "Kernel"
     LABEL "QShortcut"
@@ -89,6 +89,7 @@
 #else
 #define QT_FEATURE_getauxval -1
 #endif
+#define QT_FEATURE_getdents64 -1
 #define QT_FEATURE_getentropy -1
 #define QT_NO_GEOM_VARIANT
 #define QT_FEATURE_hijricalendar -1
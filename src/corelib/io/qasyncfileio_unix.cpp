@@ -0,0 +1,490 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include "qplatformdefs.h"
+#include "qasyncfileio_p.h"
+
+#include <QtCore/qmutex.h>
+#include <QtCore/qpromise.h>
+#include <QtCore/qthread.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qcore_unix_p.h>
+
+#if QT_CONFIG(io_uring)
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <sys/uio.h>
+#endif
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+// Linux never transfers more than this in a single read(2) or write(2)
+constexpr qint64 MaxTransferSize = 0x7ffff000;
+
+struct Request
+{
+    enum Kind { Read, Write };
+
+    Request(Kind kind, int fd, qint64 offset, const QByteArray &buffer)
+        : kind(kind), fd(fd), offset(offset), buffer(buffer)
+    { }
+
+    qint64 remaining() const { return buffer.size() - transferred; }
+    char *position()
+    { return const_cast<char *>(buffer.constData()) + transferred; }
+
+    bool advance(qint64 result);
+    void transferBlocking();
+    void finish();
+
+    const Kind kind;
+    const int fd;
+    const qint64 offset;
+    QByteArray buffer; // destination of reads, source of writes
+    qint64 transferred = 0;
+    bool failed = false;
+    QPromise<QByteArray> readPromise;
+    QPromise<qint64> writePromise;
+#if QT_CONFIG(io_uring)
+    iovec iov;
+#endif
+};
+
+// Accounts for the result of one transfer. Returns true if the request is
+// complete, false if the rest of it still needs to be transferred.
+bool Request::advance(qint64 result)
+{
+    if (result < 0) {
+        failed = true;
+        return true;
+    }
+    transferred += result;
+    return result == 0 || remaining() == 0;
+}
+
+void Request::transferBlocking()
+{
+    qint64 result;
+    do {
+        const size_t length = size_t(qMin(remaining(), MaxTransferSize));
+        const QT_OFF_T position = QT_OFF_T(offset + transferred);
+        if (kind == Read)
+            EINTR_LOOP(result, ::pread(fd, this->position(), length, position));
+        else
+            EINTR_LOOP(result, ::pwrite(fd, this->position(), length, position));
+    } while (!advance(result));
+}
+
+void Request::finish()
+{
+    if (kind == Read) {
+        if (failed) {
+            buffer = QByteArray();
+        } else {
+            buffer.truncate(transferred);
+            if (buffer.isNull())
+                buffer = QByteArray("", 0);
+        }
+        readPromise.addResult(std::move(buffer));
+        readPromise.finish();
+    } else {
+        writePromise.addResult(failed ? qint64(-1) : transferred);
+        writePromise.finish();
+    }
+}
+
+static void transferOnThreadPool(QThreadPool *threadPool, Request *request)
+{
+    threadPool->start([request] {
+        request->transferBlocking();
+        request->finish();
+        delete request;
+    });
+}
+
+#if QT_CONFIG(io_uring)
+template <typename T> static T *ringField(void *ring, quint32 offset)
+{
+    return reinterpret_cast<T *>(static_cast<char *>(ring) + offset);
+}
+
+// A single io_uring instance shared by all threads. Submissions are
+// serialized by a mutex; completions are collected by a dedicated thread,
+// started on the first submission, that sleeps in the kernel while no
+// requests are in flight. It doesn't occupy one of the threads of the pool,
+// which only runs the requests that io_uring can't take.
+class QIoUring
+{
+    Q_DISABLE_COPY_MOVE(QIoUring)
+public:
+    explicit QIoUring(QThreadPool *threadPool);
+    ~QIoUring();
+
+    bool isValid() const { return ringFd != -1; }
+    bool submit(Request *request);
+    void stop();
+
+private:
+    enum { RingEntries = 256 };
+
+    bool queue(Request *request);
+    bool push(const io_uring_sqe &entry);
+    void reap();
+    void destroy();
+
+    QThreadPool *threadPool;
+    int ringFd = -1;
+    void *sqRing = MAP_FAILED;
+    void *cqRing = MAP_FAILED;
+    size_t sqRingSize = 0;
+    size_t cqRingSize = 0;
+    io_uring_sqe *sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    size_t sqesSize = 0;
+
+    unsigned *sqTail = nullptr;
+    unsigned *sqMask = nullptr;
+    unsigned *sqArray = nullptr;
+    unsigned *cqHead = nullptr;
+    unsigned *cqTail = nullptr;
+    unsigned *cqMask = nullptr;
+    io_uring_cqe *cqes = nullptr;
+    unsigned cqEntries = 0;
+
+    QMutex mutex;
+    unsigned inFlight = 0;
+    bool stopping = false;
+    std::unique_ptr<QThread> reaper;
+};
+
+QIoUring::QIoUring(QThreadPool *threadPool)
+    : threadPool(threadPool)
+{
+    io_uring_params params = {};
+    ringFd = int(syscall(__NR_io_uring_setup, RingEntries, &params));
+    if (ringFd == -1)
+        return; // not supported by the kernel, or disabled by policy
+
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap)
+        sqRingSize = cqRingSize = qMax(sqRingSize, cqRingSize);
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                  ringFd, IORING_OFF_SQ_RING);
+    if (sqRing == MAP_FAILED) {
+        destroy();
+        return;
+    }
+
+    if (singleMmap) {
+        cqRing = sqRing;
+    } else {
+        cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_CQ_RING);
+        if (cqRing == MAP_FAILED) {
+            destroy();
+            return;
+        }
+    }
+
+    sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    sqes = static_cast<io_uring_sqe *>(mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+    if (sqes == MAP_FAILED) {
+        destroy();
+        return;
+    }
+
+    sqTail = ringField<unsigned>(sqRing, params.sq_off.tail);
+    sqMask = ringField<unsigned>(sqRing, params.sq_off.ring_mask);
+    sqArray = ringField<unsigned>(sqRing, params.sq_off.array);
+    cqHead = ringField<unsigned>(cqRing, params.cq_off.head);
+    cqTail = ringField<unsigned>(cqRing, params.cq_off.tail);
+    cqMask = ringField<unsigned>(cqRing, params.cq_off.ring_mask);
+    cqes = ringField<io_uring_cqe>(cqRing, params.cq_off.cqes);
+    cqEntries = params.cq_entries;
+}
+
+QIoUring::~QIoUring()
+{
+    stop();
+    destroy();
+}
+
+// Lets the requests in flight finish and ends the reaper thread. Requests
+// submitted afterwards are rejected.
+void QIoUring::stop()
+{
+    QMutexLocker locker(&mutex);
+    if (stopping)
+        return;
+    stopping = true;
+    if (!reaper)
+        return;
+
+    // a no-op without a request wakes the reaper up
+    io_uring_sqe wakeUp = {};
+    wakeUp.opcode = IORING_OP_NOP;
+    const bool woken = push(wakeUp);
+    locker.unlock();
+
+    if (woken) {
+        reaper->wait();
+    } else {
+        qErrnoWarning("QAsyncFileIO: Failed to stop the io_uring reaper");
+        Q_UNUSED(reaper.release()); // still blocked in the kernel
+    }
+}
+
+void QIoUring::destroy()
+{
+    if (sqes != MAP_FAILED)
+        munmap(sqes, sqesSize);
+    if (cqRing != MAP_FAILED && cqRing != sqRing)
+        munmap(cqRing, cqRingSize);
+    if (sqRing != MAP_FAILED)
+        munmap(sqRing, sqRingSize);
+    sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+    sqRing = cqRing = MAP_FAILED;
+
+    if (ringFd != -1)
+        qt_safe_close(ringFd);
+    ringFd = -1;
+}
+
+bool QIoUring::submit(Request *request)
+{
+    QMutexLocker locker(&mutex);
+
+    // never have more requests in flight than the completion queue can hold,
+    // keeping room for the completion that stops the reaper
+    if (stopping || inFlight >= cqEntries - 1 || !queue(request))
+        return false;
+
+    ++inFlight;
+    if (!reaper) {
+        reaper.reset(QThread::create([this] { reap(); }));
+        reaper->setObjectName(QStringLiteral("QAsyncFileIO io_uring reaper"));
+        reaper->start();
+    }
+    return true;
+}
+
+// Must be called with the mutex held.
+bool QIoUring::queue(Request *request)
+{
+    request->iov.iov_base = request->position();
+    request->iov.iov_len = size_t(qMin(request->remaining(), MaxTransferSize));
+
+    io_uring_sqe entry = {};
+    entry.opcode = request->kind == Request::Read ? IORING_OP_READV : IORING_OP_WRITEV;
+    entry.fd = request->fd;
+    entry.off = quint64(request->offset + request->transferred);
+    entry.addr = quintptr(&request->iov);
+    entry.len = 1;
+    entry.user_data = quintptr(request);
+    return push(entry);
+}
+
+// Must be called with the mutex held.
+bool QIoUring::push(const io_uring_sqe &entry)
+{
+    // the kernel consumes all entries inside io_uring_enter(), so the
+    // submission queue is always empty at this point
+    const unsigned tail = *sqTail;
+    const unsigned index = tail & *sqMask;
+
+    sqes[index] = entry;
+    sqArray[index] = index;
+    __atomic_store_n(sqTail, tail + 1, __ATOMIC_RELEASE);
+
+    int ret;
+    EINTR_LOOP(ret, int(syscall(__NR_io_uring_enter, ringFd, 1, 0, 0, nullptr, 0)));
+    if (ret != 1) {
+        // nothing was consumed, take the entry back
+        __atomic_store_n(sqTail, tail, __ATOMIC_RELEASE);
+        return false;
+    }
+    return true;
+}
+
+void QIoUring::reap()
+{
+    QVarLengthArray<Request *, 64> finished;
+    QVarLengthArray<Request *, 16> fallback;
+
+    forever {
+        if (syscall(__NR_io_uring_enter, ringFd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0) == -1
+                && errno != EINTR) {
+            qErrnoWarning("QAsyncFileIO: Failed to wait for io_uring completions");
+        }
+
+        QMutexLocker locker(&mutex);
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        for ( ; head != tail; ++head) {
+            const io_uring_cqe &cqe = cqes[head & *cqMask];
+            Request *request = reinterpret_cast<Request *>(quintptr(cqe.user_data));
+            if (!request)
+                continue; // woken up by stop()
+
+            const bool retry = cqe.res == -EINTR || cqe.res == -EAGAIN;
+            if (!retry && request->advance(cqe.res)) {
+                finished.append(request);
+            } else if (!queue(request)) {
+                fallback.append(request);
+            } else {
+                continue;
+            }
+            --inFlight;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+
+        const bool done = stopping && inFlight == 0;
+        locker.unlock();
+
+        // finishing may run continuations, which may submit new requests
+        for (Request *request : std::as_const(finished)) {
+            request->finish();
+            delete request;
+        }
+        for (Request *request : std::as_const(fallback))
+            transferOnThreadPool(threadPool, request);
+        finished.clear();
+        fallback.clear();
+
+        if (done)
+            return;
+    }
+}
+#endif // QT_CONFIG(io_uring)
+
+class QAsyncFileIOEngine
+{
+public:
+    QAsyncFileIOEngine()
+    {
+#if QT_CONFIG(io_uring)
+        if (qEnvironmentVariableIsEmpty("QT_NO_IO_URING")) {
+            ring = std::make_unique<QIoUring>(&threadPool);
+            if (!ring->isValid())
+                ring.reset();
+        }
+#endif
+    }
+
+    ~QAsyncFileIOEngine()
+    {
+        // let the requests in flight finish; those submitted meanwhile by
+        // continuations go to the thread pool
+#if QT_CONFIG(io_uring)
+        if (ring)
+            ring->stop();
+#endif
+        threadPool.waitForDone();
+    }
+
+    void submit(Request *request)
+    {
+#if QT_CONFIG(io_uring)
+        if (ring && ring->submit(request))
+            return;
+#endif
+        transferOnThreadPool(&threadPool, request);
+    }
+
+    QThreadPool threadPool;
+#if QT_CONFIG(io_uring)
+    std::unique_ptr<QIoUring> ring;
+#endif
+};
+
+} // unnamed namespace
+
+Q_GLOBAL_STATIC(QAsyncFileIOEngine, asyncFileIOEngine)
+
+static void submitRequest(Request *request)
+{
+    if (QAsyncFileIOEngine *engine = asyncFileIOEngine()) {
+        engine->submit(request);
+    } else {
+        // late during application shutdown
+        request->transferBlocking();
+        request->finish();
+        delete request;
+    }
+}
+
+QAsyncFileIO::Backend QAsyncFileIO::backend()
+{
+#if QT_CONFIG(io_uring)
+    if (QAsyncFileIOEngine *engine = asyncFileIOEngine(); engine && engine->ring)
+        return IoUringBackend;
+#endif
+    return ThreadPoolBackend;
+}
+
+QFuture<QByteArray> QAsyncFileIO::read(int fd, qint64 offset, qint64 maxSize)
+{
+    Q_ASSERT(offset >= 0 && maxSize >= 0);
+    auto request = new Request(Request::Read, fd, offset, QByteArray(maxSize, Qt::Uninitialized));
+    request->readPromise.start();
+    QFuture<QByteArray> future = request->readPromise.future();
+    submitRequest(request);
+    return future;
+}
+
+QFuture<qint64> QAsyncFileIO::write(int fd, qint64 offset, const QByteArray &data)
+{
+    Q_ASSERT(offset >= 0);
+    auto request = new Request(Request::Write, fd, offset, data);
+    request->writePromise.start();
+    QFuture<qint64> future = request->writePromise.future();
+    submitRequest(request);
+    return future;
+}
+
+QT_END_NAMESPACE
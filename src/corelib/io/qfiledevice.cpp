@@ -41,6 +41,14 @@
 #include "qfiledevice.h"
 #include "qfiledevice_p.h"
 #include "qfsfileengine_p.h"
+#include "private/qbytearray_p.h"
+
+#if QT_CONFIG(future)
+#include <QtCore/qfuture.h>
+#ifdef Q_OS_UNIX
+#include "qasyncfileio_p.h"
+#endif
+#endif
 
 #ifdef QT_NO_QOBJECT
 #define tr(X) QString::fromLatin1(X)
@@ -805,6 +813,101 @@ bool QFileDevice::setFileTime(const QDateTime &newDate, QFileDevice::FileTime fi
     return true;
 }
 
+#if QT_CONFIG(future)
+/*!
+    \since 6.4
+
+    Reads at most \a maxSize bytes from the file, starting at \a offset, and
+    returns a QFuture that provides the data once the read has completed.
+    The function returns immediately; the read itself does not block the
+    calling thread, so any number of reads and writes can be in flight at the
+    same time.
+
+    The read does not move the current position and does not interact with
+    the buffering done by read() and write(), except that data still
+    buffered by write() is flushed before the read is started.
+
+    The resulting QByteArray is shorter than \a maxSize if the end of the
+    file was reached, and empty if \a offset is at or past the end of the
+    file. If an error occurs, or the file does not support asynchronous
+    access, the result is a null QByteArray.
+
+    On Linux, the reads are carried out by io_uring where it is available,
+    and by a pool of worker threads otherwise. Asynchronous access requires
+    a file that has a native handle() and is not sequential.
+
+    \note The file must stay open until the returned future has finished.
+    Include <QFuture> to access the result.
+
+    \sa writeAsync(), read(), handle()
+*/
+QFuture<QByteArray> QFileDevice::readAsync(qint64 offset, qint64 maxSize)
+{
+    if (offset < 0 || maxSize < 0) {
+        qWarning("QFileDevice::readAsync: Called with negative offset or maxSize");
+        return QtFuture::makeReadyFuture(QByteArray());
+    }
+    if (!isOpen()) {
+        qWarning("QFileDevice::readAsync: device not open");
+        return QtFuture::makeReadyFuture(QByteArray());
+    }
+    if (!isReadable()) {
+        qWarning("QFileDevice::readAsync: WriteOnly device");
+        return QtFuture::makeReadyFuture(QByteArray());
+    }
+    if (maxSize >= MaxByteArraySize)
+        maxSize = MaxByteArraySize - 1;
+
+#ifdef Q_OS_UNIX
+    if (!isSequential() && handle() != -1 && (!isWritable() || flush()))
+        return QAsyncFileIO::read(handle(), offset, maxSize);
+#endif
+    return QtFuture::makeReadyFuture(QByteArray());
+}
+
+/*!
+    \since 6.4
+
+    Writes the contents of \a data to the file, starting at \a offset, and
+    returns a QFuture that provides the number of bytes written once the
+    write has completed, or -1 if an error occurred or the file does not
+    support asynchronous access. The function returns immediately; the
+    write itself does not block the calling thread.
+
+    The write does not move the current position and does not interact with
+    the buffering done by read() and write(), except that data still
+    buffered by write() is flushed before the write is started. Writes that
+    are in flight at the same time and overlap each other complete in an
+    unspecified order.
+
+    \note The file must stay open until the returned future has finished.
+    Include <QFuture> to access the result.
+
+    \sa readAsync(), write(), handle()
+*/
+QFuture<qint64> QFileDevice::writeAsync(qint64 offset, const QByteArray &data)
+{
+    if (offset < 0) {
+        qWarning("QFileDevice::writeAsync: Called with negative offset");
+        return QtFuture::makeReadyFuture(qint64(-1));
+    }
+    if (!isOpen()) {
+        qWarning("QFileDevice::writeAsync: device not open");
+        return QtFuture::makeReadyFuture(qint64(-1));
+    }
+    if (!isWritable()) {
+        qWarning("QFileDevice::writeAsync: ReadOnly device");
+        return QtFuture::makeReadyFuture(qint64(-1));
+    }
+
+#ifdef Q_OS_UNIX
+    if (!isSequential() && handle() != -1 && flush())
+        return QAsyncFileIO::write(handle(), offset, data);
+#endif
+    return QtFuture::makeReadyFuture(qint64(-1));
+}
+#endif // QT_CONFIG(future)
+
 QT_END_NAMESPACE
 
 #ifndef QT_NO_QOBJECT
@@ -47,6 +47,9 @@ QT_BEGIN_NAMESPACE
 
 class QDateTime;
 class QFileDevicePrivate;
+#if QT_CONFIG(future)
+template <typename T> class QFuture;
+#endif
 
 class Q_CORE_EXPORT QFileDevice : public QIODevice
 {
@@ -130,6 +133,11 @@ public:
     QDateTime fileTime(QFileDevice::FileTime time) const;
     bool setFileTime(const QDateTime &newDate, QFileDevice::FileTime fileTime);
 
+#if QT_CONFIG(future)
+    QFuture<QByteArray> readAsync(qint64 offset, qint64 maxSize);
+    QFuture<qint64> writeAsync(qint64 offset, const QByteArray &data);
+#endif
+
 protected:
     QFileDevice();
 #ifdef QT_NO_QOBJECT
@@ -64,7 +64,7 @@
 
 // Platform-specific headers
 #if !defined(Q_OS_WIN)
-#include <QtCore/qscopedpointer.h>
+#include <memory>
 #endif
 
 QT_BEGIN_NAMESPACE
@@ -80,6 +80,11 @@ public:
     bool advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData);
 
 private:
+#if !defined(Q_OS_WIN)
+    bool fillEntry(const QT_DIRENT &dirEntry, QFileSystemEntry &fileEntry,
+                   QFileSystemMetaData &metaData);
+#endif
+
     QFileSystemEntry::NativePath nativePath;
 
     // Platform-specific data
@@ -90,9 +95,17 @@ private:
     bool uncFallback;
     int uncShareIndex;
     bool onlyDirs;
+#else
+    QString dirPath;
+#if QT_CONFIG(getdents64)
+    int dirFd;
+    std::unique_ptr<char[]> buffer;
+    qsizetype bufferSize;
+    qsizetype bufferPos;
 #else
     QT_DIR *dir;
     QT_DIRENT *dirEntry;
+#endif
     int lastError;
 #endif
 
@@ -40,6 +40,7 @@
 #include "qplatformdefs.h"
 #include "qfilesystemiterator_p.h"
 
+#include <private/qcore_unix_p.h>
 #include <private/qstringconverter_p.h>
 
 #ifndef QT_NO_FILESYSTEMITERATOR
@@ -51,6 +52,16 @@
 
 QT_BEGIN_NAMESPACE
 
+#if QT_CONFIG(getdents64)
+// getdents64() fills the buffer with struct dirent64 records, which
+// fillFromDirEnt() gets to see as QT_DIRENT.
+static_assert(std::is_same_v<QT_DIRENT, struct dirent64>);
+
+// Large enough for a few hundred entries per system call; opendir() in
+// glibc reads 32 KiB at a time.
+static constexpr size_t DirentBufferSize = 64 * 1024;
+#endif
+
 static bool checkNameDecodable(const char *d_name, qsizetype len)
 {
     // This function is called in a loop from advance() below, but the loop is
@@ -62,30 +73,72 @@ static bool checkNameDecodable(const char *d_name, qsizetype len)
 QFileSystemIterator::QFileSystemIterator(const QFileSystemEntry &entry, QDir::Filters filters,
                                          const QStringList &nameFilters, QDirIterator::IteratorFlags flags)
     : nativePath(entry.nativeFilePath())
+    , dirPath(entry.filePath())
+#if QT_CONFIG(getdents64)
+    , dirFd(-1)
+    , bufferSize(0)
+    , bufferPos(0)
+#else
     , dir(nullptr)
     , dirEntry(nullptr)
+#endif
     , lastError(0)
 {
     Q_UNUSED(filters);
     Q_UNUSED(nameFilters);
     Q_UNUSED(flags);
 
+#if QT_CONFIG(getdents64)
+    if ((dirFd = qt_safe_open(nativePath.constData(), QT_OPEN_RDONLY | O_DIRECTORY)) == -1) {
+#else
     if ((dir = QT_OPENDIR(nativePath.constData())) == nullptr) {
+#endif
         lastError = errno;
     } else {
+#if QT_CONFIG(getdents64)
+        buffer.reset(new char[DirentBufferSize]);
+#endif
         if (!nativePath.endsWith('/'))
             nativePath.append('/');
+        if (!dirPath.endsWith(u'/'))
+            dirPath.append(u'/');
     }
 }
 
 QFileSystemIterator::~QFileSystemIterator()
 {
+#if QT_CONFIG(getdents64)
+    if (dirFd != -1)
+        qt_safe_close(dirFd);
+#else
     if (dir)
         QT_CLOSEDIR(dir);
+#endif
 }
 
 bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaData &metaData)
 {
+#if QT_CONFIG(getdents64)
+    if (dirFd == -1)
+        return false;
+
+    for (;;) {
+        if (bufferPos >= bufferSize) {
+            const ssize_t n = ::getdents64(dirFd, buffer.get(), DirentBufferSize);
+            if (n <= 0) {
+                lastError = n == 0 ? 0 : errno;
+                return false;
+            }
+            bufferSize = n;
+            bufferPos = 0;
+        }
+
+        const auto *dirEntry = reinterpret_cast<const QT_DIRENT *>(buffer.get() + bufferPos);
+        bufferPos += dirEntry->d_reclen;
+        if (fillEntry(*dirEntry, fileEntry, metaData))
+            return true;
+    }
+#else
     if (!dir)
         return false;
 
@@ -93,12 +146,8 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
         dirEntry = QT_READDIR(dir);
 
         if (dirEntry) {
-            qsizetype len = strlen(dirEntry->d_name);
-            if (checkNameDecodable(dirEntry->d_name, len)) {
-                fileEntry = QFileSystemEntry(nativePath + QByteArray(dirEntry->d_name, len), QFileSystemEntry::FromNativePath());
-                metaData.fillFromDirEnt(*dirEntry);
+            if (fillEntry(*dirEntry, fileEntry, metaData))
                 return true;
-            }
         } else {
             break;
         }
@@ -106,6 +155,22 @@ bool QFileSystemIterator::advance(QFileSystemEntry &fileEntry, QFileSystemMetaDa
 
     lastError = errno;
     return false;
+#endif
+}
+
+bool QFileSystemIterator::fillEntry(const QT_DIRENT &dirEntry, QFileSystemEntry &fileEntry,
+                                    QFileSystemMetaData &metaData)
+{
+    qsizetype len = strlen(dirEntry.d_name);
+    if (!checkNameDecodable(dirEntry.d_name, len))
+        return false;
+
+    // The name is valid UTF-8, so only it needs decoding; the directory's
+    // path has been decoded once for all of its entries.
+    fileEntry = QFileSystemEntry(dirPath + QString::fromUtf8(dirEntry.d_name, len),
+                                 nativePath + QByteArray::fromRawData(dirEntry.d_name, len));
+    metaData.fillFromDirEnt(dirEntry);
+    return true;
 }
 
 QT_END_NAMESPACE
@@ -360,6 +360,8 @@ Q_CONSTINIT bool QCoreApplicationPrivate::is_app_closing = false;
 Q_CORE_EXPORT uint qGlobalPostedEventsCount()
 {
     QThreadData *currentThreadData = QThreadData::current();
+    const auto locker = qt_scoped_lock(currentThreadData->postEventList.mutex);
+    currentThreadData->postEventList.takeIncomingEvents();
     return currentThreadData->postEventList.size() - currentThreadData->postEventList.startOffset;
 }
 
@@ -508,6 +510,7 @@ void QCoreApplicationPrivate::cleanupThreadData()
 
         // need to clear the state of the mainData, just in case a new QCoreApplication comes along.
         const auto locker = qt_scoped_lock(thisThreadData->postEventList.mutex);
+        thisThreadData->postEventList.takeIncomingEvents();
         for (int i = 0; i < thisThreadData->postEventList.size(); ++i) {
             const QPostEvent &pe = thisThreadData->postEventList.at(i);
             if (pe.event) {
@@ -1509,6 +1512,7 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     if (!object) {
         locker.threadData = QThreadData::current();
         locker.locker = qt_unique_lock(locker.threadData->postEventList.mutex);
+        locker.threadData->postEventList.takeIncomingEvents();
         return locker;
     }
 
@@ -1531,9 +1535,83 @@ QCoreApplicationPrivate::QPostEventListLocker QCoreApplicationPrivate::lockThrea
     }
 
     Q_ASSERT(locker.threadData);
+    locker.threadData->postEventList.takeIncomingEvents();
     return locker;
 }
 
+#if QT_CONFIG(thread)
+/*!
+    \internal
+
+    Tries to post \a event to \a receiver without locking the post event
+    list of the receiver's thread. The event is stored in a lock-free queue
+    that is merged into the sorted post event list the next time the list is
+    locked, so priorities are honored. Only used for events that are never
+    compressed.
+
+    Returns \c false if the queue is full or QObject::moveToThread() is
+    moving an object out of the receiver's thread, and the event has to be
+    posted the usual way.
+
+    The incomingPushers count lets QObject::moveToThread() wait for posters
+    that raced with the change of the receiver's thread. While it waits, it
+    sets QPostEventList::PushersBlocked so that no new posters come in and
+    the wait is bounded.
+*/
+bool QCoreApplicationPrivate::postEventLockFree(QObject *receiver, QEvent *event, int priority)
+{
+    auto &threadData = QObjectPrivate::get(receiver)->threadData;
+    QThreadData *data;
+    for (;;) {
+        data = threadData.loadAcquire();
+        if (!data) {
+            // posting during destruction? just delete the event to prevent a leak
+            delete event;
+            return true;
+        }
+
+        const int pushers = data->postEventList.incomingPushers.fetchAndAddOrdered(1);
+        if (pushers & QPostEventList::PushersBlocked) {
+            data->postEventList.incomingPushers.deref();
+            return false;
+        }
+        // pairs with the fence in QObject::moveToThread(): either we see the
+        // new thread data here or moveToThread() waits for us to finish
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (data == threadData.loadRelaxed())
+            break;
+        data->postEventList.incomingPushers.deref();
+    }
+
+    QPostEventList &list = data->postEventList;
+    QPostEventList::IncomingQueue *queue = list.incoming.loadAcquire();
+    if (!queue) {
+        auto *newQueue = new QPostEventList::IncomingQueue;
+        if (list.incoming.testAndSetOrdered(nullptr, newQueue, queue))
+            queue = newQueue;
+        else
+            delete newQueue;
+    }
+
+    Q_TRACE(QCoreApplication_postEvent_event_posted, receiver, event, event->type());
+    event->m_posted = true;
+    ++receiver->d_func()->postedEvents;
+    // the event may be delivered (and receiver deleted) as soon as it is pushed
+    if (!queue->push(QPostEvent(receiver, event, priority))) {
+        event->m_posted = false;
+        --receiver->d_func()->postedEvents;
+        list.incomingPushers.deref();
+        return false;
+    }
+    list.incomingPushers.deref();
+
+    QAbstractEventDispatcher* dispatcher = data->eventDispatcher.loadAcquire();
+    if (dispatcher)
+        dispatcher->wakeUp();
+    return true;
+}
+#endif
+
 /*!
     \since 4.3
 
@@ -1572,6 +1650,14 @@ void QCoreApplication::postEvent(QObject *receiver, QEvent *event, int priority)
         return;
     }
 
+#if QT_CONFIG(thread)
+    // queued meta-calls are never compressed, they can bypass the mutex
+    if (event->type() == QEvent::MetaCall
+        && QCoreApplicationPrivate::postEventLockFree(receiver, event, priority)) {
+        return;
+    }
+#endif
+
     auto locker = QCoreApplicationPrivate::lockThreadPostEventList(receiver);
     if (!locker.threadData) {
         // posting during destruction? just delete the event to prevent a leak
@@ -1726,6 +1812,7 @@ void QCoreApplicationPrivate::sendPostedEvents(QObject *receiver, int event_type
     ++data->postEventList.recursion;
 
     auto locker = qt_unique_lock(data->postEventList.mutex);
+    data->postEventList.takeIncomingEvents();
 
     // by default, we assume that the event dispatcher can go to sleep after
     // processing all events. if any new events are posted while we send
@@ -1943,6 +2030,7 @@ void QCoreApplicationPrivate::removePostedEvent(QEvent * event)
     QThreadData *data = QThreadData::current();
 
     const auto locker = qt_scoped_lock(data->postEventList.mutex);
+    data->postEventList.takeIncomingEvents();
 
     if (data->postEventList.size() == 0) {
 #if defined(QT_DEBUG)
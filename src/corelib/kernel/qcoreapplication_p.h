@@ -153,6 +153,9 @@ public:
         void unlock() { locker.unlock(); }
     };
     static QPostEventListLocker lockThreadPostEventList(QObject *object);
+#if QT_CONFIG(thread)
+    static bool postEventLockFree(QObject *receiver, QEvent *event, int priority);
+#endif
 #endif // QT_NO_QOBJECT
 
     int &argc;
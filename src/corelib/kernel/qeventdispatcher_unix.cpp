@@ -56,10 +56,20 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include <limits>
+
 #ifndef QT_NO_EVENTFD
 #  include <sys/eventfd.h>
 #endif
 
+#if QT_CONFIG(epoll)
+// QSocketNotifierSetUNIX::events() and markPendingSocketNotifiers() deal in
+// poll(2) flags; the epoll(7) ones are interchangeable on Linux
+static_assert(EPOLLIN == POLLIN && EPOLLOUT == POLLOUT && EPOLLPRI == POLLPRI
+              && EPOLLERR == POLLERR && EPOLLHUP == POLLHUP,
+              "epoll and poll event flags differ");
+#endif
+
 // VxWorks doesn't correctly set the _POSIX_... options
 #if defined(Q_OS_VXWORKS)
 #  if defined(_POSIX_MONOTONIC_CLOCK) && (_POSIX_MONOTONIC_CLOCK <= 0)
@@ -227,12 +237,19 @@ QEventDispatcherUNIXPrivate::QEventDispatcherUNIXPrivate()
 {
     if (Q_UNLIKELY(threadPipe.init() == false))
         qFatal("QEventDispatcherUNIXPrivate(): Cannot continue without a thread pipe");
+
+#if QT_CONFIG(epoll)
+    if (qEnvironmentVariableIntValue("QT_EVENT_DISPATCHER_EPOLL") > 0)
+        initEpoll();
+#endif
 }
 
 QEventDispatcherUNIXPrivate::~QEventDispatcherUNIXPrivate()
 {
-    // cleanup timers
-    qDeleteAll(timerList);
+#if QT_CONFIG(epoll)
+    if (epollFd >= 0)
+        qt_safe_close(epollFd);
+#endif
 }
 
 void QEventDispatcherUNIXPrivate::setSocketNotifierPending(QSocketNotifier *notifier)
@@ -259,36 +276,166 @@ void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers()
         auto it = socketNotifiers.find(pfd.fd);
         Q_ASSERT(it != socketNotifiers.end());
 
-        const QSocketNotifierSetUNIX &sn_set = it.value();
+        markPendingSocketNotifiers(it.value(), pfd.fd, pfd.revents);
+    }
+
+    pollfds.clear();
+}
 
-        static const struct {
-            QSocketNotifier::Type type;
-            short flags;
-        } notifiers[] = {
-            { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
-            { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
-            { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
-        };
+void QEventDispatcherUNIXPrivate::markPendingSocketNotifiers(const QSocketNotifierSetUNIX &sn_set,
+                                                             int fd, short revents)
+{
+    static const struct {
+        QSocketNotifier::Type type;
+        short flags;
+    } notifiers[] = {
+        { QSocketNotifier::Read,      POLLIN  | POLLHUP | POLLERR },
+        { QSocketNotifier::Write,     POLLOUT | POLLHUP | POLLERR },
+        { QSocketNotifier::Exception, POLLPRI | POLLHUP | POLLERR }
+    };
+
+    for (const auto &n : notifiers) {
+        QSocketNotifier *notifier = sn_set.notifiers[n.type];
+
+        if (!notifier)
+            continue;
 
-        for (const auto &n : notifiers) {
-            QSocketNotifier *notifier = sn_set.notifiers[n.type];
+        if (revents & POLLNVAL) {
+            qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
+                     fd, socketType(n.type));
+            notifier->setEnabled(false);
+        }
 
-            if (!notifier)
-                continue;
+        if (revents & n.flags)
+            setSocketNotifierPending(notifier);
+    }
+}
 
-            if (pfd.revents & POLLNVAL) {
-                qWarning("QSocketNotifier: Invalid socket %d with type %s, disabling...",
-                         it.key(), socketType(n.type));
-                notifier->setEnabled(false);
-            }
+#if QT_CONFIG(epoll)
+bool QEventDispatcherUNIXPrivate::initEpoll()
+{
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1) {
+        qErrnoWarning("QEventDispatcherUNIX: Unable to create epoll instance, using poll() instead");
+        return false;
+    }
+
+    epoll_event ev = {};
+    ev.events = EPOLLIN;
+    ev.data.fd = threadPipe.fds[0];
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, threadPipe.fds[0], &ev) == -1) {
+        qErrnoWarning("QEventDispatcherUNIX: Unable to watch thread pipe, using poll() instead");
+        qt_safe_close(epollFd);
+        epollFd = -1;
+        return false;
+    }
+
+    return true;
+}
+
+void QEventDispatcherUNIXPrivate::updateEpollRegistration(int fd, short oldEvents, short newEvents)
+{
+    if (oldEvents == newEvents)
+        return;
+
+    if (newEvents == 0) {
+        if (nonPollableFds.removeOne(fd) || invalidFds.removeOne(fd))
+            return;
+        // if the fd has already been closed, the kernel has dropped it from
+        // the interest list on its own and this fails harmlessly
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        return;
+    }
 
-            if (pfd.revents & n.flags)
-                setSocketNotifierPending(notifier);
+    if (oldEvents != 0 && (nonPollableFds.contains(fd) || invalidFds.contains(fd)))
+        return;
+
+    epoll_event ev = {};
+    ev.events = quint32(newEvents);
+    ev.data.fd = fd;
+
+    int ret = epoll_ctl(epollFd, oldEvents ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, fd, &ev);
+    if (ret == -1 && errno == ENOENT) {
+        // the fd was closed and reused while a notifier was still registered
+        ret = epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+    } else if (ret == -1 && errno == EEXIST) {
+        ret = epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &ev);
+    }
+
+    if (ret == -1) {
+        if (errno == EPERM)
+            nonPollableFds.append(fd);
+        else if (errno == EBADF)
+            invalidFds.append(fd);
+        else
+            qErrnoWarning("QSocketNotifier: Unable to watch socket %d", fd);
+    }
+}
+
+int QEventDispatcherUNIXPrivate::epollWait(const timespec *tm)
+{
+    // readiness is level-triggered, so fds that do not fit into the buffer
+    // are simply reported again by the next call
+    constexpr qsizetype MaxEpollEvents = 1024;
+    epollEvents.resize(qMin(socketNotifiers.size() + 1, MaxEpollEvents));
+
+    timespec zero = { 0, 0 };
+    if (!nonPollableFds.isEmpty() || !invalidFds.isEmpty())
+        tm = &zero;
+
+    const timespec start = tm ? qt_gettime() : timespec();
+    forever {
+        int timeout = -1;
+        if (tm) {
+            timespec remaining = *tm + start - qt_gettime();
+            if (remaining.tv_sec < 0) {
+                timeout = 0;
+            } else {
+                // round up, so that we do not wake up before the timer is due
+                const qint64 msecs = qint64(remaining.tv_sec) * 1000
+                                     + (remaining.tv_nsec + 999999) / 1000000;
+                timeout = int(qMin(msecs, qint64(std::numeric_limits<int>::max())));
+            }
         }
+
+        const int ret = epoll_wait(epollFd, epollEvents.data(), int(epollEvents.size()), timeout);
+        if (ret != -1 || errno != EINTR)
+            return ret;
     }
+}
 
-    pollfds.clear();
+void QEventDispatcherUNIXPrivate::markPendingEpollNotifiers(int nready)
+{
+    for (int i = 0; i < nready; ++i) {
+        const epoll_event &ev = epollEvents.at(i);
+        if (ev.data.fd == threadPipe.fds[0])
+            continue;
+
+        auto it = socketNotifiers.constFind(ev.data.fd);
+        if (it == socketNotifiers.cend())
+            continue; // epoll keeps reporting a closed fd while a duplicate of it is open
+
+        markPendingSocketNotifiers(it.value(), ev.data.fd, short(ev.events));
+    }
+
+    for (int fd : qAsConst(nonPollableFds)) {
+        auto it = socketNotifiers.constFind(fd);
+        if (it != socketNotifiers.cend())
+            markPendingSocketNotifiers(it.value(), fd, it.value().events());
+    }
+
+    // disabling the notifiers unregisters them, which updates invalidFds
+    // and may remove their set from socketNotifiers
+    const QList<int> closedFds = invalidFds;
+    for (int fd : closedFds) {
+        auto it = socketNotifiers.constFind(fd);
+        if (it == socketNotifiers.cend())
+            continue;
+        const QSocketNotifierSetUNIX sn_set = it.value();
+        markPendingSocketNotifiers(sn_set, fd, POLLNVAL);
+    }
 }
+#endif // QT_CONFIG(epoll)
 
 int QEventDispatcherUNIXPrivate::activateSocketNotifiers()
 {
@@ -412,7 +559,16 @@ void QEventDispatcherUNIX::registerSocketNotifier(QSocketNotifier *notifier)
         qWarning("%s: Multiple socket notifiers for same socket %d and type %s",
                  Q_FUNC_INFO, sockfd, socketType(type));
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = notifier;
+
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollRegistration(sockfd, oldEvents, sn_set.events());
+#endif
 }
 
 void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
@@ -451,8 +607,17 @@ void QEventDispatcherUNIX::unregisterSocketNotifier(QSocketNotifier *notifier)
         return;
     }
 
+#if QT_CONFIG(epoll)
+    const short oldEvents = sn_set.events();
+#endif
+
     sn_set.notifiers[type] = nullptr;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0)
+        d->updateEpollRegistration(sockfd, oldEvents, sn_set.events());
+#endif
+
     if (sn_set.isEmpty())
         d->socketNotifiers.erase(i);
 }
@@ -488,6 +653,34 @@ bool QEventDispatcherUNIX::processEvents(QEventLoop::ProcessEventsFlags flags)
     if (!canWait || (include_timers && d->timerList.timerWait(wait_tm)))
         tm = &wait_tm;
 
+#if QT_CONFIG(epoll)
+    if (d->epollFd >= 0 && include_notifiers) {
+        int nevents = 0;
+
+        const int nready = d->epollWait(tm);
+        if (nready == -1) {
+            perror("epoll_wait");
+        } else {
+            for (int i = 0; i < nready; ++i) {
+                const epoll_event &ev = d->epollEvents.at(i);
+                if (ev.data.fd == d->threadPipe.fds[0]) {
+                    pollfd pfd = d->threadPipe.prepare();
+                    pfd.revents = short(ev.events);
+                    nevents += d->threadPipe.check(pfd);
+                }
+            }
+            d->markPendingEpollNotifiers(nready);
+            nevents += d->activateSocketNotifiers();
+        }
+
+        if (include_timers)
+            nevents += d->activateTimers();
+
+        // return true if we handled events, false otherwise
+        return (nevents > 0);
+    }
+#endif
+
     d->pollfds.clear();
     d->pollfds.reserve(1 + (include_notifiers ? d->socketNotifiers.size() : 0));
 
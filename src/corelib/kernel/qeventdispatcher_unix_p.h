@@ -59,6 +59,10 @@
 #include "QtCore/qhash.h"
 #include "private/qtimerinfo_unix_p.h"
 
+#if QT_CONFIG(epoll)
+#  include <sys/epoll.h>
+#endif
+
 QT_BEGIN_NAMESPACE
 
 class QEventDispatcherUNIXPrivate;
@@ -138,10 +142,31 @@ public:
     void markPendingSocketNotifiers();
     int activateSocketNotifiers();
     void setSocketNotifierPending(QSocketNotifier *notifier);
+    void markPendingSocketNotifiers(const QSocketNotifierSetUNIX &sn_set, int fd, short revents);
+
+#if QT_CONFIG(epoll)
+    bool initEpoll();
+    void updateEpollRegistration(int fd, short oldEvents, short newEvents);
+    int epollWait(const timespec *tm);
+    void markPendingEpollNotifiers(int nready);
+#endif
 
     QThreadPipe threadPipe;
     QList<pollfd> pollfds;
 
+#if QT_CONFIG(epoll)
+    // when epoll is in use, socketNotifiers is mirrored in the kernel's
+    // interest list and only the ready fds are returned in epollEvents
+    int epollFd = -1;
+    QList<epoll_event> epollEvents;
+    // fds that epoll refuses (e.g. regular files); poll() reports them as
+    // always ready, so we do the same
+    QList<int> nonPollableFds;
+    // fds that were closed when they were registered; poll() reports
+    // POLLNVAL for them, so we do the same
+    QList<int> invalidFds;
+#endif
+
     QHash<int, QSocketNotifierSetUNIX> socketNotifiers;
     QList<QSocketNotifier *> pendingNotifiers;
 
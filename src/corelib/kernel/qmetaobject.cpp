@@ -644,6 +644,30 @@ QMetaMethod QMetaObjectPrivate::firstMethod(const QMetaObject *baseObject, QByte
     return QMetaMethod{};
 }
 
+/*!
+    \internal
+    Calls \a candidate with the relative index of each method, or property if
+    \a properties is \c true, of \a m that may be called \a name according to
+    the name index emitted by moc. Returns \c false if \a m has no such index.
+ */
+template <typename Candidate>
+static bool findInMemberNameIndex(const QMetaObject *m, bool properties, QByteArrayView name,
+                                  Candidate candidate)
+{
+    if (!(priv(m->d.data)->flags & MemberNameIndex))
+        return false;
+    const uint *index = m->d.data + MetaObjectPrivateFieldCount;
+    const uint methodBuckets = index[0];
+    const uint buckets = properties ? index[1] : methodBuckets;
+    const uint *table = index + 2 + (properties ? methodBuckets : 0);
+    if (buckets) {
+        const uint mask = buckets - 1;
+        for (uint i = QMetaObjectPrivate::memberNameHash(name) & mask; table[i]; i = (i + 1) & mask)
+            candidate(int(table[i] - 1));
+    }
+    return true;
+}
+
 /**
 * \internal
 * helper function for indexOf{Method,Slot,Signal}, returns the relative index of the method within
@@ -662,6 +686,22 @@ inline int QMetaObjectPrivate::indexOfMethodRelative(const QMetaObject **baseObj
         const int end = (MethodType == MethodSlot)
                         ? (priv(m->d.data)->signalCount) : 0;
 
+        // the last matching method wins, as for the linear search below
+        int found = -1;
+        const auto candidate = [&](int index) {
+            if (index >= end && index <= i && index > found
+                    && methodMatch(m, QMetaMethod::fromRelativeMethodIndex(m, index), name, argc, types)) {
+                found = index;
+            }
+        };
+        if (findInMemberNameIndex(m, false, name, candidate)) {
+            if (found >= 0) {
+                *baseObject = m;
+                return found;
+            }
+            continue;
+        }
+
         for (; i >= end; --i) {
             auto data = QMetaMethod::fromRelativeMethodIndex(m, i);
             if (methodMatch(m, data, name, argc, types)) {
@@ -1066,12 +1106,24 @@ int QMetaObject::indexOfProperty(const char *name) const
     const QMetaObject *m = this;
     while (m) {
         const QMetaObjectPrivate *d = priv(m->d.data);
-        for (int i = 0; i < d->propertyCount; ++i) {
+        const auto matches = [&](int i) {
             const QMetaProperty::Data data = QMetaProperty::getMetaPropertyData(m, i);
             const char *prop = rawStringData(m, data.name());
-            if (name[0] == prop[0] && strcmp(name + 1, prop + 1) == 0) {
-                i += m->propertyOffset();
-                return i;
+            return name[0] == prop[0] && strcmp(name + 1, prop + 1) == 0;
+        };
+        // the first matching property wins, as for the linear search below
+        int found = -1;
+        const auto candidate = [&](int i) {
+            if ((found < 0 || i < found) && matches(i))
+                found = i;
+        };
+        if (findInMemberNameIndex(m, true, name, candidate)) {
+            if (found >= 0)
+                return found + m->propertyOffset();
+        } else {
+            for (int i = 0; i < d->propertyCount; ++i) {
+                if (matches(i))
+                    return i + m->propertyOffset();
             }
         }
         m = m->d.superdata;
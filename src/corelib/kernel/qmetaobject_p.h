@@ -106,7 +106,8 @@ enum MethodFlags {
 enum MetaObjectFlag {
     DynamicMetaObject = 0x01,
     RequiresVariantMetaObject = 0x02,
-    PropertyAccessInStaticMetaCall = 0x04 // since Qt 5.5, property code is in the static metacall
+    PropertyAccessInStaticMetaCall = 0x04, // since Qt 5.5, property code is in the static metacall
+    MemberNameIndex = 0x08 // since Qt 6.4, the header is followed by hash tables of the member names
 };
 Q_DECLARE_FLAGS(MetaObjectFlags, MetaObjectFlag)
 Q_DECLARE_OPERATORS_FOR_FLAGS(MetaObjectFlags)
@@ -259,6 +260,24 @@ struct QMetaObjectPrivate
                             const QArgumentType *types);
     Q_CORE_EXPORT static QMetaMethod firstMethod(const QMetaObject *baseObject, QByteArrayView name);
 
+    /*
+        With the MemberNameIndex flag, the header is followed by the number
+        of buckets of the method name table and of the property name table,
+        and then by the two tables. Each bucket holds 0 if it is empty, or
+        the relative index + 1 of a member. The bucket of a member is its
+        memberNameHash() modulo the number of buckets, which is a power of
+        two, or the next empty one after that.
+
+        The tables are part of the moc output of applications, so the hash
+        function must never change.
+    */
+    static uint memberNameHash(QByteArrayView name) noexcept
+    {
+        uint h = 2166136261u;
+        for (char c : name)
+            h = (h ^ uchar(c)) * 16777619u;
+        return h;
+    }
 };
 
 // For meta-object generators
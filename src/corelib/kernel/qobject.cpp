@@ -164,8 +164,15 @@ Q_DECLARE_TYPEINFO(QObjectPrivate::Connection, Q_RELOCATABLE_TYPE);
 
 struct QObjectPrivate::SignalVector : public ConnectionOrSignalVector
 {
-    quintptr allocated;
+    // number of signals in a dense vector, capacity of a sparse one
+    uint allocated;
+    // -1 for a dense vector, which is indexed by signal index. Otherwise the
+    // number of lists in use in a sparse vector, which stores the signal index
+    // of each list in an array after the lists. Lists are only ever appended to
+    // it, so readers can search it without locking.
+    QBasicAtomicInt sparseCount;
     // ConnectionList signals[]
+    // int sparseSignals[]
     ConnectionList &at(int i)
     {
         return reinterpret_cast<ConnectionList *>(this + 1)[i + 1];
@@ -174,7 +181,51 @@ struct QObjectPrivate::SignalVector : public ConnectionOrSignalVector
     {
         return reinterpret_cast<const ConnectionList *>(this + 1)[i + 1];
     }
-    int count() const { return static_cast<int>(allocated); }
+    bool isSparse() const { return sparseCount.loadRelaxed() >= 0; }
+    int *sparseSignals()
+    {
+        return reinterpret_cast<int *>(&at(int(allocated)));
+    }
+    const int *sparseSignals() const
+    {
+        return reinterpret_cast<const int *>(&at(int(allocated)));
+    }
+    // number of lists, which are at(0) ... at(count() - 1)
+    int count() const
+    {
+        const int n = sparseCount.loadAcquire();
+        return n < 0 ? int(allocated) : n;
+    }
+    int signalAt(int i) const
+    {
+        return isSparse() ? sparseSignals()[i] : i;
+    }
+
+    // returns the list for \a signal, or nullptr if the vector has none
+    ConnectionList *find(int signal)
+    {
+        return const_cast<ConnectionList *>(std::as_const(*this).find(signal));
+    }
+    const ConnectionList *find(int signal) const
+    {
+        if (signal < 0)
+            return &at(-1);
+        const int n = sparseCount.loadAcquire();
+        if (n < 0)
+            return signal < int(allocated) ? &at(signal) : nullptr;
+        const int *indexes = sparseSignals();
+        for (int i = 0; i < n; ++i) {
+            if (indexes[i] == signal)
+                return &at(i);
+        }
+        return nullptr;
+    }
+
+    static size_t allocationSize(uint allocated, bool sparse)
+    {
+        return sizeof(SignalVector) + (allocated + 1) * sizeof(ConnectionList)
+                + (sparse ? allocated * sizeof(int) : 0);
+    }
 };
 static_assert(std::is_trivial_v<QObjectPrivate::SignalVector>); // it doesn't need to be, but it helps
 
@@ -219,34 +270,113 @@ struct QObjectPrivate::ConnectionData
     }
     void cleanOrphanedConnectionsImpl(QObject *sender, LockPolicy lockPolicy);
 
+    // returns the existing list for \a signal; there must be one
     ConnectionList &connectionsForSignal(int signal)
     {
-        return signalVector.loadRelaxed()->at(signal);
+        ConnectionList *list = signalVector.loadRelaxed()->find(signal);
+        Q_ASSERT(list);
+        return *list;
+    }
+    // returns the list for \a signal, or nullptr if nothing was ever connected to it
+    const ConnectionList *findConnectionsForSignal(int signal) const
+    {
+        const SignalVector *vector = signalVector.loadRelaxed();
+        return vector ? vector->find(signal) : nullptr;
+    }
+
+    enum : int { NoSignal = -2 };
+    /*
+        Returns the lowest signal index above \a signal that has a list, or
+        NoSignal if there is none. Starting from NoSignal, this visits -1 (the
+        connections to all signals) first. It does not keep any state, so it
+        can be used while the lock is temporarily released.
+    */
+    int nextSignalIndex(int signal) const
+    {
+        const SignalVector *vector = signalVector.loadRelaxed();
+        if (!vector)
+            return NoSignal;
+        if (signal < -1)
+            return -1;
+        if (!vector->isSparse())
+            return signal + 1 < int(vector->allocated) ? signal + 1 : NoSignal;
+        int next = NoSignal;
+        const int *indexes = vector->sparseSignals();
+        for (int i = 0, n = vector->count(); i < n; ++i) {
+            if (indexes[i] > signal && (next == NoSignal || indexes[i] < next))
+                next = indexes[i];
+        }
+        return next;
     }
 
-    void resizeSignalVector(uint size)
+    /*
+        Senders with connections to only a few signals get a sparse vector
+        that stores the signal index next to each list, as a dense vector
+        would need a list for every signal up to the highest connected one.
+        Each step of a sparse vector's growth is compared against the size
+        of the dense vector, and it is converted once the dense one is
+        smaller or more than MaxSparseSignals signals are connected.
+    */
+    enum : uint { MaxSparseSignals = 8 };
+    ConnectionList &ensureConnectionsForSignal(int signal)
     {
         SignalVector *vector = this->signalVector.loadRelaxed();
-        if (vector && vector->allocated > size)
-            return;
-        size = (size + 7) & ~7;
-        void *ptr = malloc(sizeof(SignalVector) + (size + 1) * sizeof(ConnectionList));
+        if (vector) {
+            if (ConnectionList *list = vector->find(signal))
+                return *list;
+            const int n = vector->sparseCount.loadRelaxed();
+            if (n >= 0 && uint(n) < vector->allocated) {
+                // publishing the count makes the new list visible to activate()
+                vector->sparseSignals()[n] = signal;
+                vector->sparseCount.storeRelease(n + 1);
+                return vector->at(n);
+            }
+        }
+
+        const int count = vector ? vector->count() : 0;
+        int highest = signal;
+        for (int i = 0; i < count; ++i)
+            highest = qMax(highest, vector->signalAt(i));
+        const uint denseSize = (uint(highest) + 8) & ~7u;
+        uint sparseSize = 0;
+        if (!vector || vector->isSparse()) {
+            sparseSize = vector ? vector->allocated * 2 : 1;
+            if (sparseSize > MaxSparseSignals
+                    || SignalVector::allocationSize(denseSize, false)
+                        <= SignalVector::allocationSize(sparseSize, true)) {
+                sparseSize = 0;
+            }
+        }
+
+        const uint size = sparseSize ? sparseSize : denseSize;
+        void *ptr = malloc(SignalVector::allocationSize(size, sparseSize != 0));
         auto newVector = new (ptr) SignalVector;
+        newVector->next = nullptr;
+        newVector->allocated = size;
+        newVector->sparseCount.storeRelaxed(sparseSize ? 0 : -1);
+        for (int i = -1; i < int(size); ++i)
+            new (&newVector->at(i)) ConnectionList();
 
-        int start = -1;
         if (vector) {
             // not (yet) existing trait:
-            //static_assert(std::is_relocatable_v<SignalVector>);
             //static_assert(std::is_relocatable_v<ConnectionList>);
-            memcpy(newVector, vector, sizeof(SignalVector) + (vector->allocated + 1) * sizeof(ConnectionList));
-            start = vector->count();
+            memcpy(static_cast<void *>(&newVector->at(-1)), &vector->at(-1), sizeof(ConnectionList));
+            if (sparseSize) {
+                memcpy(static_cast<void *>(&newVector->at(0)), &vector->at(0), count * sizeof(ConnectionList));
+                memcpy(newVector->sparseSignals(), vector->sparseSignals(), count * sizeof(int));
+            } else {
+                for (int i = 0; i < count; ++i)
+                    memcpy(static_cast<void *>(&newVector->at(vector->signalAt(i))), &vector->at(i), sizeof(ConnectionList));
+            }
+        }
+        ConnectionList *list = &newVector->at(signal);
+        if (sparseSize && signal >= 0) {
+            newVector->sparseSignals()[count] = signal;
+            newVector->sparseCount.storeRelaxed(count + 1);
+            list = &newVector->at(count);
         }
-        for (int i = start; i < int(size); ++i)
-            new (&newVector->at(i)) ConnectionList();
-        newVector->next = nullptr;
-        newVector->allocated = size;
 
-        signalVector.storeRelaxed(newVector);
+        signalVector.storeRelease(newVector);
         if (vector) {
             Connection *o = nullptr;
             /* No ABA issue here: When adding a node, we only care about the list head, it doesn't
@@ -258,10 +388,7 @@ struct QObjectPrivate::ConnectionData
             } while (!orphaned.testAndSetRelease(o, ConnectionOrSignalVector::fromSignalVector(vector)));
 
         }
-    }
-    int signalVectorCount() const
-    {
-        return signalVector.loadAcquire() ? signalVector.loadRelaxed()->count() : -1;
+        return *list;
     }
 
     static void deleteOrphaned(ConnectionOrSignalVector *c);
@@ -470,8 +597,8 @@ bool QObjectPrivate::isSender(const QObject *receiver, const char *signal) const
     if (signal_index < 0 || !cd)
         return false;
     QBasicMutexLocker locker(signalSlotLock(q));
-    if (signal_index < cd->signalVectorCount()) {
-        const QObjectPrivate::Connection *c = cd->signalVector.loadRelaxed()->at(signal_index).first.loadRelaxed();
+    if (const ConnectionList *list = cd->findConnectionsForSignal(signal_index)) {
+        const QObjectPrivate::Connection *c = list->first.loadRelaxed();
 
         while (c) {
             if (c->receiver.loadRelaxed() == receiver)
@@ -490,8 +617,8 @@ QObjectList QObjectPrivate::receiverList(const char *signal) const
     ConnectionData *cd = connections.loadRelaxed();
     if (signal_index < 0 || !cd)
         return returnValue;
-    if (signal_index < cd->signalVectorCount()) {
-        const QObjectPrivate::Connection *c = cd->signalVector.loadRelaxed()->at(signal_index).first.loadRelaxed();
+    if (const ConnectionList *list = cd->findConnectionsForSignal(signal_index)) {
+        const QObjectPrivate::Connection *c = list->first.loadRelaxed();
 
         while (c) {
             QObject *r = c->receiver.loadRelaxed();
@@ -540,9 +667,7 @@ void QObjectPrivate::addConnection(int signal, Connection *c)
     Q_ASSERT(c->sender == q_ptr);
     ensureConnectionData();
     ConnectionData *cd = connections.loadRelaxed();
-    cd->resizeSignalVector(signal + 1);
-
-    ConnectionList &connectionList = cd->connectionsForSignal(signal);
+    ConnectionList &connectionList = cd->ensureConnectionsForSignal(signal);
     if (connectionList.last.loadRelaxed()) {
         Q_ASSERT(connectionList.last.loadRelaxed()->receiver.loadRelaxed());
         connectionList.last.loadRelaxed()->nextConnectionList.storeRelaxed(c);
@@ -566,7 +691,7 @@ void QObjectPrivate::addConnection(int signal, Connection *c)
 void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection *c)
 {
     Q_ASSERT(c->receiver.loadRelaxed());
-    ConnectionList &connections = signalVector.loadRelaxed()->at(c->signal_index);
+    ConnectionList &connections = connectionsForSignal(c->signal_index);
     c->receiver.storeRelaxed(nullptr);
     QThreadData *td = c->receiverThreadData.loadRelaxed();
     if (td)
@@ -594,8 +719,8 @@ void QObjectPrivate::ConnectionData::removeConnection(QObjectPrivate::Connection
         connections.first.storeRelaxed(c->nextConnectionList.loadRelaxed());
     if (connections.last.loadRelaxed() == c)
         connections.last.storeRelaxed(c->prevConnectionList);
-    Q_ASSERT(signalVector.loadRelaxed()->at(c->signal_index).first.loadRelaxed() != c);
-    Q_ASSERT(signalVector.loadRelaxed()->at(c->signal_index).last.loadRelaxed() != c);
+    Q_ASSERT(connections.first.loadRelaxed() != c);
+    Q_ASSERT(connections.last.loadRelaxed() != c);
 
     // keep c->nextConnectionList intact, as it might still get accessed by activate
     Connection *n = c->nextConnectionList.loadRelaxed();
@@ -697,8 +822,8 @@ bool QObjectPrivate::isSignalConnected(uint signalIndex, bool checkDeclarative)
     if (signalVector->at(-1).first.loadRelaxed())
         return true;
 
-    if (signalIndex < uint(cd->signalVectorCount())) {
-        const QObjectPrivate::Connection *c = signalVector->at(signalIndex).first.loadRelaxed();
+    if (const ConnectionList *list = signalVector->find(int(signalIndex))) {
+        const QObjectPrivate::Connection *c = list->first.loadRelaxed();
         while (c) {
             if (c->receiver.loadRelaxed())
                 return true;
@@ -720,10 +845,8 @@ bool QObjectPrivate::maybeSignalConnected(uint signalIndex) const
     if (signalVector->at(-1).first.loadAcquire())
         return true;
 
-    if (signalIndex < uint(cd->signalVectorCount())) {
-        const QObjectPrivate::Connection *c = signalVector->at(signalIndex).first.loadAcquire();
-        return c != nullptr;
-    }
+    if (const ConnectionList *list = signalVector->find(int(signalIndex)))
+        return list->first.loadAcquire() != nullptr;
     return false;
 }
 
@@ -1253,8 +1376,9 @@ QObject::~QObject()
         QBasicMutexLocker locker(signalSlotMutex);
 
         // disconnect all receivers
-        int receiverCount = cd->signalVectorCount();
-        for (int signal = -1; signal < receiverCount; ++signal) {
+        for (int signal = cd->nextSignalIndex(QObjectPrivate::ConnectionData::NoSignal);
+             signal != QObjectPrivate::ConnectionData::NoSignal;
+             signal = cd->nextSignalIndex(signal)) {
             QObjectPrivate::ConnectionList &connectionList = cd->connectionsForSignal(signal);
 
             while (QObjectPrivate::Connection *c = connectionList.first.loadRelaxed()) {
@@ -1886,6 +2010,10 @@ void QObject::moveToThread(QThread *targetThread)
     // keep currentData alive (since we've got it locked)
     currentData->ref();
 
+    // events posted without locking must be in the lists before they are moved
+    currentData->postEventList.takeIncomingEvents();
+    targetData->postEventList.takeIncomingEvents();
+
     // move the object
     auto threadPrivate =  targetThread
         ? static_cast<QThreadPrivate *>(QThreadPrivate::get(targetThread))
@@ -1898,6 +2026,34 @@ void QObject::moveToThread(QThread *targetThread)
     }
     d_func()->setThreadData_helper(currentData, targetData, bindingStatus);
 
+#if QT_CONFIG(thread)
+    // A thread posting with QCoreApplicationPrivate::postEventLockFree() may
+    // have read the old thread data before it was changed above. Wait for it
+    // and hand the events it pushed to the thread now owning the receiver.
+    // Posters arriving in the meantime take the locked path, otherwise a
+    // steady stream of events to other objects of this thread could keep us
+    // waiting with both lists locked.
+    QAtomicInt &pushers = currentData->postEventList.incomingPushers;
+    pushers.fetchAndOrOrdered(QPostEventList::PushersBlocked);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    while (pushers.loadAcquire() & ~QPostEventList::PushersBlocked)
+        QThread::yieldCurrentThread();
+    pushers.fetchAndAndRelease(~QPostEventList::PushersBlocked);
+    int eventsMoved = 0;
+    currentData->postEventList.takeIncomingEvents([&](const QPostEvent &pe) {
+        if (QObjectPrivate::get(pe.receiver)->threadData.loadRelaxed() == targetData) {
+            targetData->postEventList.addEvent(pe);
+            ++eventsMoved;
+        } else {
+            currentData->postEventList.addEvent(pe);
+        }
+    });
+    if (eventsMoved > 0 && targetData->hasEventDispatcher()) {
+        targetData->canWait = false;
+        targetData->eventDispatcher.loadRelaxed()->wakeUp();
+    }
+#endif
+
     locker.unlock();
 
     // now currentData can commit suicide if it wants to
@@ -2852,8 +3008,8 @@ int QObject::receivers(const char *signal) const
 
         QObjectPrivate::ConnectionData *cd = d->connections.loadRelaxed();
         QBasicMutexLocker locker(signalSlotLock(this));
-        if (cd && signal_index < cd->signalVectorCount()) {
-            const QObjectPrivate::Connection *c = cd->signalVector.loadRelaxed()->at(signal_index).first.loadRelaxed();
+        if (const QObjectPrivate::ConnectionList *list = cd ? cd->findConnectionsForSignal(signal_index) : nullptr) {
+            const QObjectPrivate::Connection *c = list->first.loadRelaxed();
             while (c) {
                 receivers += c->receiver.loadRelaxed() ? 1 : 0;
                 c = c->nextConnectionList.loadRelaxed();
@@ -3668,8 +3824,8 @@ QObjectPrivate::Connection *QMetaObjectPrivate::connect(const QObject *sender,
 
     QObjectPrivate::ConnectionData *scd  = QObjectPrivate::get(s)->connections.loadRelaxed();
     if (type & Qt::UniqueConnection && scd) {
-        if (scd->signalVectorCount() > signal_index) {
-            const QObjectPrivate::Connection *c2 = scd->signalVector.loadRelaxed()->at(signal_index).first.loadRelaxed();
+        if (const QObjectPrivate::ConnectionList *list = scd->findConnectionsForSignal(signal_index)) {
+            const QObjectPrivate::Connection *c2 = list->first.loadRelaxed();
 
             int method_index_absolute = method_index + method_offset;
 
@@ -3810,11 +3966,13 @@ bool QMetaObjectPrivate::disconnect(const QObject *sender,
 
         if (signal_index < 0) {
             // remove from all connection lists
-            for (int sig_index = -1; sig_index < scd->signalVectorCount(); ++sig_index) {
+            for (int sig_index = scd->nextSignalIndex(QObjectPrivate::ConnectionData::NoSignal);
+                 sig_index != QObjectPrivate::ConnectionData::NoSignal;
+                 sig_index = scd->nextSignalIndex(sig_index)) {
                 if (disconnectHelper(connections.data(), sig_index, receiver, method_index, slot, senderMutex, disconnectType))
                     success = true;
             }
-        } else if (signal_index < scd->signalVectorCount()) {
+        } else if (scd->findConnectionsForSignal(signal_index)) {
             if (disconnectHelper(connections.data(), signal_index, receiver, method_index, slot, senderMutex, disconnectType))
                 success = true;
         }
@@ -4109,10 +4267,8 @@ void doActivate(QObject *sender, int signal_index, void **argv)
     QObjectPrivate::ConnectionDataPointer connections(sp->connections.loadRelaxed());
     QObjectPrivate::SignalVector *signalVector = connections->signalVector.loadRelaxed();
 
-    const QObjectPrivate::ConnectionList *list;
-    if (signal_index < signalVector->count())
-        list = &signalVector->at(signal_index);
-    else
+    const QObjectPrivate::ConnectionList *list = signalVector->find(signal_index);
+    if (!list)
         list = &signalVector->at(-1);
 
     Qt::HANDLE currentThreadId = QThread::currentThreadId();
@@ -4476,10 +4632,11 @@ void QObject::dumpObjectInfo() const
     qDebug("  SIGNALS OUT");
 
     QObjectPrivate::ConnectionData *cd = d->connections.loadRelaxed();
-    if (cd && cd->signalVectorCount() > 0) {
-        QObjectPrivate::SignalVector *signalVector = cd->signalVector.loadRelaxed();
-        for (int signal_index = 0; signal_index < signalVector->count(); ++signal_index) {
-            const QObjectPrivate::Connection *c = signalVector->at(signal_index).first.loadRelaxed();
+    if (cd) {
+        for (int signal_index = cd->nextSignalIndex(-1);
+             signal_index != QObjectPrivate::ConnectionData::NoSignal;
+             signal_index = cd->nextSignalIndex(signal_index)) {
+            const QObjectPrivate::Connection *c = cd->connectionsForSignal(signal_index).first.loadRelaxed();
             if (!c)
                 continue;
             const QMetaMethod signal = QMetaObjectPrivate::signal(metaObject(), signal_index);
@@ -5299,8 +5456,8 @@ QMetaObject::Connection QObjectPrivate::connectImpl(const QObject *sender, int s
 
     if (type & Qt::UniqueConnection && slot && QObjectPrivate::get(s)->connections.loadRelaxed()) {
         QObjectPrivate::ConnectionData *connections = QObjectPrivate::get(s)->connections.loadRelaxed();
-        if (connections->signalVectorCount() > signal_index) {
-            const QObjectPrivate::Connection *c2 = connections->signalVector.loadRelaxed()->at(signal_index).first.loadRelaxed();
+        if (const QObjectPrivate::ConnectionList *list = connections->findConnectionsForSignal(signal_index)) {
+            const QObjectPrivate::Connection *c2 = list->first.loadRelaxed();
 
             while (c2) {
                 if (c2->receiver.loadRelaxed() == receiver && c2->isSlotObject && c2->slotObj->compare(slot)) {
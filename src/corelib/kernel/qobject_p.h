@@ -147,7 +147,8 @@ public:
         The signalVector contains the lists of connections for a given signal. The index in the vector correspond
         to the signal index. The signal index is the one returned by QObjectPrivate::signalIndex (not
         QMetaObject::indexOfSignal). allsignals contains a list of special connections that will get invoked on
-        any signal emission. This is done by connecting to signal index -1.
+        any signal emission. This is done by connecting to signal index -1. Objects with connections to only a few
+        signals use a sparse signalVector instead, which stores the signal index next to each list.
 
         This vector is protected by the object mutex (signalSlotLock())
 
@@ -0,0 +1,835 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qsharedmemorychannel.h"
+#include "qsharedmemorychannel_p.h"
+
+#include <qcryptographichash.h>
+#include <qdeadlinetimer.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qmetaobject.h>
+#include <qsocketnotifier.h>
+
+#include <private/qcore_unix_p.h>
+
+#include <atomic>
+
+#include <errno.h>
+#include <sys/stat.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+using namespace QSharedMemoryChannelLayout;
+
+/*!
+    \class QSharedMemoryChannel
+    \inmodule QtCore
+    \since 6.4
+    \reentrant
+    \brief The QSharedMemoryChannel class passes messages between processes
+    through shared memory.
+
+    \ingroup ipc
+
+    QSharedMemoryChannel is a bounded queue of messages that lives in a
+    shared memory segment. One process creates the channel with create(),
+    giving the number of message slots and the largest message size; other
+    processes attach() to it using the same key(). Every object attached to
+    the channel can both write and read messages, and any number of
+    producers and consumers, in any number of processes and threads, can
+    use the channel at the same time. Each message is delivered to exactly
+    one consumer, in the order in which the slots were reserved.
+
+    Writing and reading messages never takes a lock and never enters the
+    kernel, unless a consumer is waiting for messages. This makes the
+    latency of a channel much lower than that of QLocalSocket, at the price
+    of a fixed maximum message size and a fixed capacity.
+
+    Messages can be written without copying: reserve() returns a pointer
+    into the next free slot, and commit() publishes the message once it has
+    been filled in. Similarly, beginRead() returns a view of the next message
+    in place, and endRead() gives its slot back to the producers. The
+    convenience functions write() and read() copy the data.
+
+    \code
+    QSharedMemoryChannel channel("market-data");
+    channel.create(1024, sizeof(Quote));
+    ...
+    if (char *slot = channel.reserve(sizeof(Quote))) {
+        new (slot) Quote(symbol, bid, ask);
+        channel.commit();
+    }
+    \endcode
+
+    \code
+    QSharedMemoryChannel channel("market-data");
+    channel.attach();
+    connect(&channel, &QSharedMemoryChannel::readyRead, this, [&] {
+        for (QByteArrayView message = channel.beginRead(); !message.isNull();
+             message = channel.beginRead()) {
+            process(reinterpret_cast<const Quote *>(message.data()));
+            channel.endRead();
+        }
+    });
+    \endcode
+
+    Consumers either connect to the readyRead() signal, which is emitted by
+    the event loop, or block in waitForReadyRead(). Both are woken through a
+    named pipe that is created next to the shared memory segment, so that
+    they cost nothing while messages are being consumed as fast as they are
+    produced. A consumer should read all pending messages when it is woken,
+    as readyRead() is only emitted again when a message is written to an
+    empty channel.
+
+    The process that created the channel owns it: once it detaches, no other
+    process can attach to it any more, although the processes that are
+    already attached can continue to use it. A producer that reserved a slot
+    must commit it quickly, as the consumers cannot read past a slot that
+    was reserved but not committed yet. Slots that were reserved but never
+    committed, because the object was detached or destroyed, are skipped.
+
+    Like QSharedMemory, the channel only stores raw bytes. The processes
+    using it must agree on the format of the messages, and must not store
+    pointers in them.
+
+    \sa QSharedMemory, QLocalSocket
+*/
+
+/*!
+    \enum QSharedMemoryChannel::ChannelError
+
+    \value NoError No error occurred.
+    \value PermissionDenied The operation failed because the caller didn't
+        have the required permissions.
+    \value InvalidSize The requested slot count or message size is invalid,
+        or a message is larger than maxMessageSize().
+    \value KeyError The operation failed because of an invalid key.
+    \value AlreadyExists A create() operation failed because a channel with
+        the specified key already existed, or the object was already
+        attached.
+    \value NotFound An attach() failed because no channel with the specified
+        key could be found, or the object is not attached to a channel.
+    \value IncompatibleChannel An attach() failed because the shared memory
+        segment does not hold a channel, or one created by an incompatible
+        version of Qt.
+    \value OutOfResources A create() operation failed because there was not
+        enough memory available.
+    \value UnknownError Something else happened and it was bad.
+*/
+
+/*!
+    \fn void QSharedMemoryChannel::readyRead()
+
+    This signal is emitted when a message is written to the channel while
+    it was empty. It is only emitted if the object is attached to a channel,
+    and is emitted by the event loop of the thread the object lives in.
+
+    Connecting to this signal makes the object wait for messages in its
+    event loop; producers then have to wake it up with a system call
+    whenever they write to an empty channel.
+*/
+
+static QString fifoPathForKey(const QString &key)
+{
+    if (key.isEmpty())
+        return QString();
+
+    // same scheme as QSharedMemory's native keys
+    QString result = QDir::tempPath() + "/qipc_channel_"_L1;
+    for (QChar ch : key) {
+        if ((ch >= u'a' && ch <= u'z') || (ch >= u'A' && ch <= u'Z'))
+            result += ch;
+    }
+    result += QLatin1StringView(
+            QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Sha1).toHex());
+    return result;
+}
+
+/*!
+    Constructs a channel object with the given \a parent. Call setKey()
+    before create() or attach().
+*/
+QSharedMemoryChannel::QSharedMemoryChannel(QObject *parent)
+    : QObject(*new QSharedMemoryChannelPrivate, parent)
+{
+}
+
+/*!
+    Constructs a channel object with the given \a parent, for the channel
+    identified by \a key. The channel is neither created nor attached.
+
+    \sa setKey(), create(), attach()
+*/
+QSharedMemoryChannel::QSharedMemoryChannel(const QString &key, QObject *parent)
+    : QSharedMemoryChannel(parent)
+{
+    setKey(key);
+}
+
+/*!
+    Destroys the object, detaching it from the channel first.
+
+    \sa detach()
+*/
+QSharedMemoryChannel::~QSharedMemoryChannel()
+{
+    Q_D(QSharedMemoryChannel);
+    d->cleanup();
+}
+
+/*!
+    Sets the platform independent \a key of the channel, detaching from the
+    current channel first.
+
+    \sa key()
+*/
+void QSharedMemoryChannel::setKey(const QString &key)
+{
+    Q_D(QSharedMemoryChannel);
+    if (key == d->key)
+        return;
+    if (isAttached())
+        detach();
+    d->key = key;
+    d->memory.setKey(key.isEmpty() ? QString() : "qipc_channel_"_L1 + key);
+    d->fifoPath = fifoPathForKey(key);
+}
+
+/*!
+    Returns the key of the channel.
+
+    \sa setKey()
+*/
+QString QSharedMemoryChannel::key() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->key;
+}
+
+/*!
+    Creates the channel identified by key(), with room for \a slotCount
+    messages of up to \a maxMessageSize bytes each, and attaches to it.
+    \a slotCount is rounded up to the next power of two. Returns \c true on
+    success; otherwise returns \c false and sets error().
+
+    \sa attach(), slotCount(), maxMessageSize()
+*/
+bool QSharedMemoryChannel::create(qsizetype slotCount, qsizetype maxMessageSize)
+{
+    Q_D(QSharedMemoryChannel);
+    const QString function = "QSharedMemoryChannel::create"_L1;
+    if (isAttached()) {
+        d->setError(AlreadyExists, tr("%1: already attached").arg(function));
+        return false;
+    }
+    if (d->key.isEmpty()) {
+        d->setError(KeyError, tr("%1: key is empty").arg(function));
+        return false;
+    }
+    if (slotCount <= 0 || slotCount > (1 << 30) || maxMessageSize < 0
+            || maxMessageSize > (1 << 30)) {
+        d->setError(InvalidSize, tr("%1: invalid size").arg(function));
+        return false;
+    }
+
+    const quint32 count = slotCount == 1 ? 1 : qNextPowerOfTwo(quint32(slotCount - 1));
+    const quint32 slotSize = (sizeof(Slot) + maxMessageSize + CacheLineSize - 1)
+            & ~(CacheLineSize - 1);
+    qsizetype size;
+    if (qMulOverflow(qsizetype(count), qsizetype(slotSize), &size)
+            || qAddOverflow(size, HeaderSize, &size)) {
+        d->setError(InvalidSize, tr("%1: invalid size").arg(function));
+        return false;
+    }
+
+    if (!d->memory.create(size)) {
+        d->setErrorFromMemory();
+        return false;
+    }
+
+    Header *header = static_cast<Header *>(d->memory.data());
+    header->version = Version;
+    header->slotCount = count;
+    header->slotSize = slotSize;
+    header->tail.storeRelaxed(0);
+    header->head.storeRelaxed(0);
+    header->sleepers.storeRelaxed(0);
+    d->header = header;
+    d->slotCount = count;
+    d->slotSize = slotSize;
+    for (quint32 i = 0; i < count; ++i)
+        d->slotAt(i)->sequence.storeRelaxed(i);
+
+    // we own the key now, so a pipe with the same name was left behind by a
+    // previous owner that crashed
+    const QByteArray fifoPath = QFile::encodeName(d->fifoPath);
+    ::unlink(fifoPath);
+    if (::mkfifo(fifoPath, 0600) == -1) {
+        d->setError(errno == EACCES ? PermissionDenied : UnknownError,
+                    tr("%1: %2").arg(function, qt_error_string(errno)));
+        d->header = nullptr;
+        d->memory.detach();
+        return false;
+    }
+    d->isCreator = true;
+    if (!d->openFifo(function)) {
+        d->cleanup();
+        return false;
+    }
+
+    header->magic.storeRelease(Magic);
+    d->error = NoError;
+    d->errorString.clear();
+    d->setNotificationsEnabled(isSignalConnected(QMetaMethod::fromSignal(&QSharedMemoryChannel::readyRead)));
+    return true;
+}
+
+/*!
+    Attaches to the channel identified by key(), which must have been
+    created by create(). Returns \c true on success; otherwise returns
+    \c false and sets error().
+
+    \sa create(), detach()
+*/
+bool QSharedMemoryChannel::attach()
+{
+    Q_D(QSharedMemoryChannel);
+    const QString function = "QSharedMemoryChannel::attach"_L1;
+    if (isAttached()) {
+        d->setError(AlreadyExists, tr("%1: already attached").arg(function));
+        return false;
+    }
+    if (!d->memory.attach()) {
+        d->setErrorFromMemory();
+        return false;
+    }
+
+    Header *header = static_cast<Header *>(d->memory.data());
+    bool valid = d->memory.size() >= HeaderSize && header->magic.loadAcquire() == Magic
+            && header->version == Version;
+    const quint32 count = valid ? header->slotCount : 0;
+    const quint32 slotSize = valid ? header->slotSize : 0;
+    if (valid) {
+        valid = count && (count & (count - 1)) == 0 && slotSize >= sizeof(Slot)
+                && slotSize % CacheLineSize == 0
+                && (d->memory.size() - HeaderSize) / slotSize >= count;
+    }
+    if (!valid) {
+        d->setError(IncompatibleChannel, tr("%1: not a compatible channel").arg(function));
+        d->memory.detach();
+        return false;
+    }
+
+    d->header = header;
+    d->slotCount = count;
+    d->slotSize = slotSize;
+    if (!d->openFifo(function)) {
+        d->cleanup();
+        return false;
+    }
+
+    d->error = NoError;
+    d->errorString.clear();
+    d->setNotificationsEnabled(isSignalConnected(QMetaMethod::fromSignal(&QSharedMemoryChannel::readyRead)));
+    return true;
+}
+
+/*!
+    Returns \c true if this object is attached to a channel.
+
+    \sa attach(), detach()
+*/
+bool QSharedMemoryChannel::isAttached() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header != nullptr;
+}
+
+/*!
+    Detaches from the channel. A slot that was reserved but not committed
+    is skipped by the consumers, and a message that was being read is
+    released. If this object created the channel, no other object can
+    attach to it any more. Returns \c false if the object was not attached.
+
+    \sa attach(), isAttached()
+*/
+bool QSharedMemoryChannel::detach()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!isAttached())
+        return false;
+    d->cleanup();
+    return true;
+}
+
+/*!
+    Returns the number of messages the channel can hold, or 0 if the object
+    is not attached.
+
+    \sa create()
+*/
+qsizetype QSharedMemoryChannel::slotCount() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header ? qsizetype(d->slotCount) : 0;
+}
+
+/*!
+    Returns the size of the largest message that fits in the channel, or 0
+    if the object is not attached. The size may be larger than the one
+    passed to create().
+
+    \sa create()
+*/
+qsizetype QSharedMemoryChannel::maxMessageSize() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header ? qsizetype(d->slotSize - sizeof(Slot)) : 0;
+}
+
+/*!
+    Reserves the next free slot of the channel for a message of \a size
+    bytes and returns a pointer to it. The message must be written there
+    and then published with commit(). Returns \nullptr if the channel is
+    full, or if \a size is larger than maxMessageSize().
+
+    Only one slot can be reserved at a time by each object.
+
+    \sa commit(), write()
+*/
+char *QSharedMemoryChannel::reserve(qsizetype size)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header) {
+        d->setError(NotFound, tr("%1: not attached").arg("QSharedMemoryChannel::reserve"_L1));
+        return nullptr;
+    }
+    if (d->writeSlot) {
+        qWarning("QSharedMemoryChannel::reserve: The previous reservation was not committed");
+        return nullptr;
+    }
+    if (size < 0 || size > maxMessageSize()) {
+        d->setError(InvalidSize, tr("%1: message too large").arg("QSharedMemoryChannel::reserve"_L1));
+        return nullptr;
+    }
+
+    Header *header = d->header;
+    quint32 position = header->tail.loadRelaxed();
+    for (;;) {
+        Slot *slot = d->slotAt(position);
+        const qint32 diff = qint32(slot->sequence.loadAcquire() - position);
+        if (diff == 0) {
+            if (header->tail.testAndSetRelaxed(position, position + 1, position)) {
+                d->writeSlot = slot;
+                d->writePosition = position;
+                d->writeSize = quint32(size);
+                return slot->data();
+            }
+        } else if (diff < 0) {
+            return nullptr;     // full: the slot still holds the message of the previous lap
+        } else {
+            position = header->tail.loadRelaxed();
+        }
+    }
+}
+
+/*!
+    Publishes the message written to the slot returned by reserve(), and
+    wakes up a consumer if one is waiting. Returns \c false if no slot was
+    reserved.
+
+    \sa reserve()
+*/
+bool QSharedMemoryChannel::commit()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->writeSlot)
+        return false;
+    d->publish(d->writeSlot, d->writePosition, d->writeSize);
+    d->writeSlot = nullptr;
+    return true;
+}
+
+/*!
+    Copies \a message into the next free slot of the channel and publishes
+    it. Returns \c false if the channel is full or the message is too large.
+
+    \sa reserve(), read()
+*/
+bool QSharedMemoryChannel::write(QByteArrayView message)
+{
+    char *slot = reserve(message.size());
+    if (!slot)
+        return false;
+    memcpy(slot, message.data(), message.size());
+    return commit();
+}
+
+/*!
+    Returns \c true if a message is waiting to be read.
+
+    \sa beginRead(), waitForReadyRead()
+*/
+bool QSharedMemoryChannel::hasPendingMessages() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->header && !d->isEmpty();
+}
+
+/*!
+    Takes the next message from the channel and returns a view of it,
+    without copying it. The view remains valid until endRead() is called,
+    which must be done before the next message can be read by this object.
+    Returns a null view if no message is pending.
+
+    \sa endRead(), read()
+*/
+QByteArrayView QSharedMemoryChannel::beginRead()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header)
+        return QByteArrayView();
+    if (d->readSlot) {
+        qWarning("QSharedMemoryChannel::beginRead: endRead() was not called for the previous message");
+        return QByteArrayView();
+    }
+
+    Header *header = d->header;
+    quint32 position = header->head.loadRelaxed();
+    for (;;) {
+        Slot *slot = d->slotAt(position);
+        const qint32 diff = qint32(slot->sequence.loadAcquire() - (position + 1));
+        if (diff == 0) {
+            if (header->head.testAndSetOrdered(position, position + 1, position)) {
+                // read the size only once: a broken producer could still
+                // change it, and must not make us read out of the slot
+                const quint32 size = slot->size;
+                if (size <= d->slotSize - sizeof(Slot)) {
+                    d->readSlot = slot;
+                    d->readPosition = position;
+                    return QByteArrayView(slot->data(), qsizetype(size));
+                }
+                if (size != SkippedMessage)
+                    qWarning("QSharedMemoryChannel::beginRead: skipping a message of invalid size %u", size);
+                slot->sequence.storeRelease(position + d->slotCount);
+                position = header->head.loadRelaxed();
+            }
+        } else if (diff < 0) {
+            return QByteArrayView();    // empty
+        } else {
+            position = header->head.loadRelaxed();
+        }
+    }
+}
+
+/*!
+    Releases the slot of the message returned by beginRead(), so that
+    producers can reuse it. The view returned by beginRead() becomes
+    invalid.
+
+    \sa beginRead()
+*/
+void QSharedMemoryChannel::endRead()
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->readSlot)
+        return;
+    d->readSlot->sequence.storeRelease(d->readPosition + d->slotCount);
+    d->readSlot = nullptr;
+}
+
+/*!
+    Takes the next message from the channel and returns a copy of it.
+    Returns a null QByteArray if no message is pending; use beginRead() to
+    tell empty messages apart.
+
+    \sa beginRead(), write()
+*/
+QByteArray QSharedMemoryChannel::read()
+{
+    const QByteArrayView message = beginRead();
+    if (message.isNull())
+        return QByteArray();
+    QByteArray result = message.toByteArray();
+    endRead();
+    return result;
+}
+
+/*!
+    Blocks until a message is pending or \a msecs milliseconds have passed.
+    If \a msecs is -1, this function will not time out. Returns \c true if a
+    message is pending; note that another consumer may take it before this
+    object calls beginRead().
+
+    \sa readyRead(), hasPendingMessages()
+*/
+bool QSharedMemoryChannel::waitForReadyRead(int msecs)
+{
+    Q_D(QSharedMemoryChannel);
+    if (!d->header)
+        return false;
+    if (!d->isEmpty())
+        return true;
+
+    QDeadlineTimer deadline(msecs);
+    d->header->sleepers.ref();
+    bool ready = false;
+    for (;;) {
+        // check again now that producers know that we are about to sleep
+        if (!d->isEmpty()) {
+            ready = true;
+            break;
+        }
+        pollfd pfd = qt_make_pollfd(d->fifo, POLLIN);
+        const int ret = qt_poll_msecs(&pfd, 1, deadline.remainingTime());
+        if (ret == -1) {
+            d->setError(UnknownError, tr("%1: %2").arg("QSharedMemoryChannel::waitForReadyRead"_L1,
+                                                      qt_error_string(errno)));
+            break;
+        }
+        if (ret == 0) {
+            ready = !d->isEmpty();
+            break;
+        }
+        d->drainFifo();
+    }
+    d->header->sleepers.deref();
+    return ready;
+}
+
+/*!
+    Returns a value indicating whether an error occurred, and, if so, which
+    error it was.
+
+    \sa errorString()
+*/
+QSharedMemoryChannel::ChannelError QSharedMemoryChannel::error() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->error;
+}
+
+/*!
+    Returns a text description of the last error that occurred.
+
+    \sa error()
+*/
+QString QSharedMemoryChannel::errorString() const
+{
+    Q_D(const QSharedMemoryChannel);
+    return d->errorString;
+}
+
+/*!
+    \reimp
+*/
+void QSharedMemoryChannel::connectNotify(const QMetaMethod &signal)
+{
+    Q_D(QSharedMemoryChannel);
+    if (signal == QMetaMethod::fromSignal(&QSharedMemoryChannel::readyRead))
+        d->setNotificationsEnabled(true);
+}
+
+/*!
+    \reimp
+*/
+void QSharedMemoryChannel::disconnectNotify(const QMetaMethod &)
+{
+    Q_D(QSharedMemoryChannel);
+    // the signal may be invalid, when disconnecting everything
+    if (!isSignalConnected(QMetaMethod::fromSignal(&QSharedMemoryChannel::readyRead)))
+        d->setNotificationsEnabled(false);
+}
+
+bool QSharedMemoryChannelPrivate::isEmpty() const
+{
+    quint32 position = header->head.loadRelaxed();
+    for (;;) {
+        const qint32 diff = qint32(slotAt(position)->sequence.loadAcquire() - (position + 1));
+        if (diff <= 0)
+            return diff < 0;
+        position = header->head.loadRelaxed();     // another consumer took the message
+    }
+}
+
+void QSharedMemoryChannelPrivate::publish(Slot *slot, quint32 position, quint32 size)
+{
+    slot->size = size;
+    slot->sequence.storeRelease(position + 1);
+    wakeConsumer(position);
+}
+
+void QSharedMemoryChannelPrivate::wakeConsumer(quint32 position)
+{
+    // Pairs with the increment of the sleepers and the update of the head
+    // by the consumers: either they see the new message before going to
+    // sleep, or we see them waiting for it. Consumers that have not read up
+    // to this message yet will find it without being woken up.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (header->sleepers.loadRelaxed() == 0 || header->head.loadRelaxed() != position)
+        return;
+    const char c = 0;
+    qt_safe_write(fifo, &c, 1);     // a full pipe will wake the consumers all the same
+}
+
+void QSharedMemoryChannelPrivate::drainFifo()
+{
+    char buffer[64];
+    while (qt_safe_read(fifo, buffer, sizeof(buffer)) == qint64(sizeof(buffer)))
+        ;
+}
+
+bool QSharedMemoryChannelPrivate::openFifo(const QString &function)
+{
+    // Opening for reading and writing does not block and keeps the pipe
+    // open even when no other process has it open.
+    fifo = qt_safe_open(QFile::encodeName(fifoPath), O_RDWR | O_NONBLOCK);
+    if (fifo != -1)
+        return true;
+
+    QSharedMemoryChannel::ChannelError e = QSharedMemoryChannel::UnknownError;
+    if (errno == ENOENT)
+        e = QSharedMemoryChannel::NotFound;
+    else if (errno == EACCES)
+        e = QSharedMemoryChannel::PermissionDenied;
+    setError(e, QSharedMemoryChannel::tr("%1: %2").arg(function, qt_error_string(errno)));
+    return false;
+}
+
+void QSharedMemoryChannelPrivate::setError(QSharedMemoryChannel::ChannelError e,
+                                           const QString &message)
+{
+    error = e;
+    errorString = message;
+}
+
+void QSharedMemoryChannelPrivate::setErrorFromMemory()
+{
+    switch (memory.error()) {
+    case QSharedMemory::NoError:
+    case QSharedMemory::LockError:
+    case QSharedMemory::UnknownError:
+        error = QSharedMemoryChannel::UnknownError;
+        break;
+    case QSharedMemory::PermissionDenied:
+        error = QSharedMemoryChannel::PermissionDenied;
+        break;
+    case QSharedMemory::InvalidSize:
+        error = QSharedMemoryChannel::InvalidSize;
+        break;
+    case QSharedMemory::KeyError:
+        error = QSharedMemoryChannel::KeyError;
+        break;
+    case QSharedMemory::AlreadyExists:
+        error = QSharedMemoryChannel::AlreadyExists;
+        break;
+    case QSharedMemory::NotFound:
+        error = QSharedMemoryChannel::NotFound;
+        break;
+    case QSharedMemory::OutOfResources:
+        error = QSharedMemoryChannel::OutOfResources;
+        break;
+    }
+    errorString = memory.errorString();
+}
+
+void QSharedMemoryChannelPrivate::setNotificationsEnabled(bool enable)
+{
+    Q_Q(QSharedMemoryChannel);
+    if (enable == (notifier != nullptr) || (enable && !header))
+        return;
+
+    if (enable) {
+        notifier = new QSocketNotifier(fifo, QSocketNotifier::Read, q);
+        QObject::connect(notifier, &QSocketNotifier::activated, q, [this] { notified(); });
+        header->sleepers.ref();
+        // make sure we are told about messages that are already pending
+        if (!isEmpty()) {
+            const char c = 0;
+            qt_safe_write(fifo, &c, 1);
+        }
+    } else {
+        delete notifier;
+        notifier = nullptr;
+        header->sleepers.deref();
+    }
+}
+
+void QSharedMemoryChannelPrivate::notified()
+{
+    Q_Q(QSharedMemoryChannel);
+    drainFifo();
+    if (!isEmpty())
+        emit q->readyRead();
+}
+
+void QSharedMemoryChannelPrivate::cleanup()
+{
+    if (!header)
+        return;
+
+    if (writeSlot) {
+        publish(writeSlot, writePosition, SkippedMessage);
+        writeSlot = nullptr;
+    }
+    if (readSlot) {
+        readSlot->sequence.storeRelease(readPosition + slotCount);
+        readSlot = nullptr;
+    }
+    setNotificationsEnabled(false);
+    if (fifo != -1) {
+        qt_safe_close(fifo);
+        fifo = -1;
+    }
+    if (isCreator) {
+        ::unlink(QFile::encodeName(fifoPath));
+        isCreator = false;
+    }
+    header = nullptr;
+    slotCount = 0;
+    slotSize = 0;
+    memory.detach();
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qsharedmemorychannel.cpp"
@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSHAREDMEMORYCHANNEL_P_H
+#define QSHAREDMEMORYCHANNEL_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include "qsharedmemorychannel.h"
+
+#include <QtCore/qsharedmemory.h>
+#include <QtCore/private/qobject_p.h>
+
+QT_REQUIRE_CONFIG(sharedmemorychannel);
+
+QT_BEGIN_NAMESPACE
+
+class QSocketNotifier;
+
+// The shared segment starts with this header, followed by slotCount slots of
+// slotSize bytes each. The slots form a bounded multi-producer,
+// multi-consumer queue (D. Vyukov's algorithm): the sequence number of a slot
+// tells whether it is free for the producer that claimed position n
+// (sequence == n), holds the message at position n (sequence == n + 1), or is
+// still being read by the consumer of the previous lap. Positions wrap around
+// at 2^32, so they are always compared by their signed difference.
+namespace QSharedMemoryChannelLayout {
+enum : quint32 {
+    Magic = 0x43686e6c,         // "Chnl"
+    Version = 1,
+    SkippedMessage = ~0U,       // size of a reservation that was abandoned
+};
+
+static constexpr qsizetype CacheLineSize = 64;
+
+struct Header
+{
+    QBasicAtomicInteger<quint32> magic;
+    quint32 version;
+    quint32 slotCount;          // a power of two
+    quint32 slotSize;           // including the Slot header, multiple of CacheLineSize
+    alignas(CacheLineSize) QBasicAtomicInteger<quint32> tail;       // next position to write
+    alignas(CacheLineSize) QBasicAtomicInteger<quint32> head;       // next position to read
+    alignas(CacheLineSize) QBasicAtomicInteger<quint32> sleepers;   // consumers waiting for a wakeup
+};
+
+struct Slot
+{
+    QBasicAtomicInteger<quint32> sequence;
+    quint32 size;
+
+    char *data() { return reinterpret_cast<char *>(this + 1); }
+};
+
+static constexpr qsizetype HeaderSize =
+        (sizeof(Header) + CacheLineSize - 1) & ~(CacheLineSize - 1);
+}
+
+class QSharedMemoryChannelPrivate : public QObjectPrivate
+{
+    Q_DECLARE_PUBLIC(QSharedMemoryChannel)
+
+public:
+    using Header = QSharedMemoryChannelLayout::Header;
+    using Slot = QSharedMemoryChannelLayout::Slot;
+
+    QString key;
+    QSharedMemory memory;
+    QString fifoPath;
+    QString errorString;
+    Header *header = nullptr;
+    // Copies of the header's geometry, validated when attaching: the
+    // header itself is writable by every process using the channel.
+    quint32 slotCount = 0;
+    quint32 slotSize = 0;
+    QSocketNotifier *notifier = nullptr;
+    Slot *writeSlot = nullptr;
+    Slot *readSlot = nullptr;
+    quint32 writePosition = 0;
+    quint32 writeSize = 0;
+    quint32 readPosition = 0;
+    int fifo = -1;
+    QSharedMemoryChannel::ChannelError error = QSharedMemoryChannel::NoError;
+    bool isCreator = false;
+
+    Slot *slotAt(quint32 position) const
+    {
+        char *base = reinterpret_cast<char *>(header) + QSharedMemoryChannelLayout::HeaderSize;
+        return reinterpret_cast<Slot *>(base + qsizetype(position & (slotCount - 1)) * slotSize);
+    }
+
+    bool isEmpty() const;
+    void publish(Slot *slot, quint32 position, quint32 size);
+    void wakeConsumer(quint32 position);
+    void drainFifo();
+    bool openFifo(const QString &function);
+    void setError(QSharedMemoryChannel::ChannelError e, const QString &message);
+    void setErrorFromMemory();
+    void setNotificationsEnabled(bool enable);
+    void notified();
+    void cleanup();
+};
+
+QT_END_NAMESPACE
+
+#endif // QSHAREDMEMORYCHANNEL_P_H
@@ -121,6 +121,16 @@ public:
     QTcpSocket and QUdpSocket provide notification through signals, so
     there is normally no need to use a QSocketNotifier on them.
 
+    On Linux, the generic Unix event dispatcher can watch socket
+    notifiers with epoll(7) instead of poll(2), which scales better to
+    threads with many notifiers. Set the \c QT_EVENT_DISPATCHER_EPOLL
+    environment variable to \c 1 to enable it. The variable only affects
+    that dispatcher: Qt on Linux uses the GLib event dispatcher by
+    default, so unless Qt was built without GLib support, the
+    \c QT_NO_GLIB environment variable must be set as well. GUI
+    applications use the event dispatcher of their platform plugin, which
+    may not be based on the generic Unix one.
+
     \sa QFile, QProcess, QTcpSocket, QUdpSocket
 */
 
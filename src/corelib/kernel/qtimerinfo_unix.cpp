@@ -53,6 +53,8 @@
 
 #include <sys/times.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
@@ -62,6 +64,21 @@ Q_CORE_EXPORT bool qt_disable_lowpriority_timers=false;
  * timerBitVec array is used for keeping track of timer identifiers.
  */
 
+static inline qint64 toMilliseconds(const timespec &t)
+{
+    return qint64(t.tv_sec) * 1000 + t.tv_nsec / (1000 * 1000);
+}
+
+// the order in which timers are activated
+static bool timerLessThan(const QTimerInfo *t1, const QTimerInfo *t2)
+{
+    if (t1->timeout < t2->timeout)
+        return true;
+    if (t2->timeout < t1->timeout)
+        return false;
+    return t1->sequence < t2->sequence;
+}
+
 QTimerInfoList::QTimerInfoList()
 {
 #if (_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)
@@ -83,7 +100,17 @@ QTimerInfoList::QTimerInfoList()
     }
 #endif
 
-    firstTimerInfo = nullptr;
+    std::fill(std::begin(wheel), std::end(wheel), nullptr);
+    std::fill(std::begin(occupiedSlots), std::end(occupiedSlots), 0);
+    wheelTime = toMilliseconds(updateCurrentTime());
+    nextSequence = 0;
+    firstTimer = nullptr;
+    firstTimerValid = true;
+}
+
+QTimerInfoList::~QTimerInfoList()
+{
+    qDeleteAll(timers);
 }
 
 timespec QTimerInfoList::updateCurrentTime()
@@ -147,10 +174,9 @@ bool QTimerInfoList::timeChanged(timespec *delta)
 void QTimerInfoList::timerRepair(const timespec &diff)
 {
     // repair all timers
-    for (int i = 0; i < size(); ++i) {
-        QTimerInfo *t = at(i);
+    for (QTimerInfo *t : qAsConst(timers))
         t->timeout = t->timeout + diff;
-    }
+    rebuildWheel();
 }
 
 void QTimerInfoList::repairTimersIfNeeded()
@@ -171,17 +197,154 @@ void QTimerInfoList::repairTimersIfNeeded()
 #endif
 
 /*
-  insert timer info into list
+  Put the timer into the wheel slot for its timeout: the lowest level at
+  which the timeout has the same higher digits as the wheel time. Overdue
+  timers go into the current slot of level 0.
 */
-void QTimerInfoList::timerInsert(QTimerInfo *ti)
+void QTimerInfoList::wheelInsert(QTimerInfo *t)
 {
-    int index = size();
-    while (index--) {
-        const QTimerInfo * const t = at(index);
-        if (!(ti->timeout < t->timeout))
-            break;
+    const qint64 expires = qMax(toMilliseconds(t->timeout), wheelTime);
+    const quint64 diff = quint64(expires) ^ quint64(wheelTime);
+    int level = diff ? (63 - qCountLeadingZeroBits(diff)) / WheelSlotBits : 0;
+    int index;
+    if (level < WheelLevels) {
+        index = int(expires >> (level * WheelSlotBits)) & (WheelSlots - 1);
+    } else {
+        // further away than the wheel reaches, park it in the last slot
+        level = WheelLevels - 1;
+        index = WheelSlots - 1;
+    }
+
+    t->slot = level * WheelSlots + index;
+    t->next = wheel[t->slot];
+    if (t->next)
+        t->next->prev = &t->next;
+    t->prev = &wheel[t->slot];
+    wheel[t->slot] = t;
+    occupiedSlots[level] |= quint64(1) << index;
+}
+
+void QTimerInfoList::wheelRemove(QTimerInfo *t)
+{
+    Q_ASSERT(t->slot >= 0);
+    *t->prev = t->next;
+    if (t->next)
+        t->next->prev = t->prev;
+    if (!wheel[t->slot])
+        occupiedSlots[t->slot / WheelSlots] &= ~(quint64(1) << (t->slot % WheelSlots));
+}
+
+/*
+  Move the wheel to the current time. The timers of all slots that were
+  reached or passed are inserted again, which moves them down to a lower
+  level, or into the current slot if they are due.
+*/
+void QTimerInfoList::advanceWheel()
+{
+    const qint64 now = toMilliseconds(currentTime);
+    if (now <= wheelTime)
+        return;
+    const qint64 then = std::exchange(wheelTime, now);
+
+    QTimerInfo *cascade = nullptr;
+    for (int level = 0; level < WheelLevels; ++level) {
+        const int shift = level * WheelSlotBits;
+        if ((then >> shift) == (now >> shift))
+            break; // nothing changes on this level and above
+
+        quint64 reached = ~quint64(0);
+        if ((then >> (shift + WheelSlotBits)) == (now >> (shift + WheelSlotBits))) {
+            // still in the same range of the level above: only the slots
+            // between the old and the new position were reached
+            const int from = int(then >> shift) & (WheelSlots - 1);
+            const int to = int(now >> shift) & (WheelSlots - 1);
+            reached = (~quint64(0) << from) & (~quint64(0) >> (WheelSlots - 1 - to));
+        }
+        reached &= occupiedSlots[level];
+        occupiedSlots[level] &= ~reached;
+
+        while (reached) {
+            QTimerInfo *t = std::exchange(wheel[level * WheelSlots + qCountTrailingZeroBits(reached)], nullptr);
+            reached &= reached - 1;
+            while (t) {
+                QTimerInfo *next = t->next;
+                t->next = cascade;
+                cascade = t;
+                t = next;
+            }
+        }
+    }
+
+    while (cascade) {
+        QTimerInfo *t = cascade;
+        cascade = t->next;
+        wheelInsert(t);
+    }
+}
+
+void QTimerInfoList::rebuildWheel()
+{
+    std::fill(std::begin(wheel), std::end(wheel), nullptr);
+    std::fill(std::begin(occupiedSlots), std::end(occupiedSlots), 0);
+    wheelTime = toMilliseconds(currentTime);
+    for (QTimerInfo *t : qAsConst(timers)) {
+        if (t->slot >= 0)
+            wheelInsert(t);
     }
-    insert(index+1, ti);
+    firstTimerValid = false;
+}
+
+/*
+  Returns the earliest timer that is not being activated. Slots are
+  visited in the order of their timeouts; all timers of a level expire
+  before those of the next level.
+*/
+QTimerInfo *QTimerInfoList::findFirstTimer() const
+{
+    for (int level = 0; level < WheelLevels; ++level) {
+        const int current = int(wheelTime >> (level * WheelSlotBits)) & (WheelSlots - 1);
+        quint64 pending = occupiedSlots[level] & (~quint64(0) << current);
+        while (pending) {
+            QTimerInfo *first = nullptr;
+            for (QTimerInfo *t = wheel[level * WheelSlots + qCountTrailingZeroBits(pending)]; t; t = t->next) {
+                if (!t->activateRef && (!first || timerLessThan(t, first)))
+                    first = t;
+            }
+            if (first)
+                return first;
+            pending &= pending - 1;
+        }
+    }
+    return nullptr;
+}
+
+void QTimerInfoList::updateFirstTimer(QTimerInfo *t)
+{
+    if (firstTimerValid && !t->activateRef && (!firstTimer || timerLessThan(t, firstTimer)))
+        firstTimer = t;
+}
+
+/*
+  insert timer info into the wheel
+*/
+void QTimerInfoList::timerInsert(QTimerInfo *ti)
+{
+    ti->sequence = nextSequence++;
+    wheelInsert(ti);
+    updateFirstTimer(ti);
+}
+
+/*
+  take timer info out of the wheel or the list of due timers
+*/
+void QTimerInfoList::removeTimer(QTimerInfo *t)
+{
+    if (t->slot < 0)
+        dueTimers.removeOne(t);
+    else
+        wheelRemove(t);
+    if (t == firstTimer)
+        firstTimerValid = false;
 }
 
 inline timespec &operator+=(timespec &t1, int ms)
@@ -390,16 +553,21 @@ bool QTimerInfoList::timerWait(timespec &tm)
 {
     timespec currentTime = updateCurrentTime();
     repairTimersIfNeeded();
+    advanceWheel();
 
-    // Find first waiting timer not already active
-    QTimerInfo *t = nullptr;
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (!(*it)->activateRef) {
-            t = *it;
-            break;
-        }
+    // timers collected by activateTimers() are overdue
+    if (!dueTimers.isEmpty()) {
+        tm.tv_sec  = 0;
+        tm.tv_nsec = 0;
+        return true;
     }
 
+    // Find first waiting timer not already active
+    if (!firstTimerValid) {
+        firstTimer = findFirstTimer();
+        firstTimerValid = true;
+    }
+    QTimerInfo *t = firstTimer;
     if (!t)
       return false;
 
@@ -426,16 +594,13 @@ int QTimerInfoList::timerRemainingTime(int timerId)
     repairTimersIfNeeded();
     timespec tm = {0, 0};
 
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            if (currentTime < t->timeout) {
-                // time to wait
-                tm = roundToMillisecond(t->timeout - currentTime);
-                return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
-            } else {
-                return 0;
-            }
+    if (const QTimerInfo *t = timers.value(timerId)) {
+        if (currentTime < t->timeout) {
+            // time to wait
+            tm = roundToMillisecond(t->timeout - currentTime);
+            return tm.tv_sec*1000 + tm.tv_nsec/1000/1000;
+        } else {
+            return 0;
         }
     }
 
@@ -496,7 +661,9 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
             ++t->timeout.tv_sec;
     }
 
+    advanceWheel();
     timerInsert(t);
+    timers.insert(timerId, t);
 
 #ifdef QTIMERINFO_DEBUG
     t->expected = expected;
@@ -511,39 +678,32 @@ void QTimerInfoList::registerTimer(int timerId, qint64 interval, Qt::TimerType t
 bool QTimerInfoList::unregisterTimer(int timerId)
 {
     // set timer inactive
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
-        if (t->id == timerId) {
-            // found it
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
-            if (t->activateRef)
-                *(t->activateRef) = nullptr;
-            delete t;
-            return true;
-        }
-    }
-    // id not found
-    return false;
+    QTimerInfo *t = timers.take(timerId);
+    if (!t)
+        return false; // id not found
+
+    removeTimer(t);
+    if (t->activateRef)
+        *(t->activateRef) = nullptr;
+    delete t;
+    return true;
 }
 
 bool QTimerInfoList::unregisterTimers(QObject *object)
 {
     if (isEmpty())
         return false;
-    for (int i = 0; i < count(); ++i) {
-        QTimerInfo *t = at(i);
+    for (auto it = timers.begin(); it != timers.end(); ) {
+        QTimerInfo *t = it.value();
         if (t->obj == object) {
             // object found
-            removeAt(i);
-            if (t == firstTimerInfo)
-                firstTimerInfo = nullptr;
+            it = timers.erase(it);
+            removeTimer(t);
             if (t->activateRef)
                 *(t->activateRef) = nullptr;
             delete t;
-            // move back one so that we don't skip the new current item
-            --i;
+        } else {
+            ++it;
         }
     }
     return true;
@@ -551,16 +711,21 @@ bool QTimerInfoList::unregisterTimers(QObject *object)
 
 QList<QAbstractEventDispatcher::TimerInfo> QTimerInfoList::registeredTimers(QObject *object) const
 {
+    QList<const QTimerInfo *> objectTimers;
+    for (const QTimerInfo *t : timers) {
+        if (t->obj == object)
+            objectTimers << t;
+    }
+    std::sort(objectTimers.begin(), objectTimers.end(), timerLessThan);
+
     QList<QAbstractEventDispatcher::TimerInfo> list;
-    for (int i = 0; i < count(); ++i) {
-        const QTimerInfo * const t = at(i);
-        if (t->obj == object) {
-            list << QAbstractEventDispatcher::TimerInfo(t->id,
-                                                        (t->timerType == Qt::VeryCoarseTimer
-                                                         ? t->interval * 1000
-                                                         : t->interval),
-                                                        t->timerType);
-        }
+    list.reserve(objectTimers.size());
+    for (const QTimerInfo *t : qAsConst(objectTimers)) {
+        list << QAbstractEventDispatcher::TimerInfo(t->id,
+                                                    (t->timerType == Qt::VeryCoarseTimer
+                                                     ? t->interval * 1000
+                                                     : t->interval),
+                                                    t->timerType);
     }
     return list;
 }
@@ -573,42 +738,31 @@ int QTimerInfoList::activateTimers()
     if (qt_disable_lowpriority_timers || isEmpty())
         return 0; // nothing to do
 
-    int n_act = 0, maxCount = 0;
-    firstTimerInfo = nullptr;
+    int n_act = 0;
 
     timespec currentTime = updateCurrentTime();
     // qDebug() << "Thread" << QThread::currentThreadId() << "woken up at" << currentTime;
     repairTimersIfNeeded();
-
-
-    // Find out how many timer have expired
-    for (QTimerInfoList::const_iterator it = constBegin(); it != constEnd(); ++it) {
-        if (currentTime < (*it)->timeout)
-            break;
-        maxCount++;
+    advanceWheel();
+
+    // Find out which timers have expired, they are all in the current slot.
+    // Each of them is sent at most once, even if it expires again meanwhile.
+    for (QTimerInfo *t = wheel[wheelTime & (WheelSlots - 1)]; t; ) {
+        QTimerInfo *next = t->next;
+        if (!(currentTime < t->timeout)) {
+            wheelRemove(t);
+            if (t == firstTimer)
+                firstTimerValid = false;
+            t->slot = -1;
+            dueTimers.append(t);
+        }
+        t = next;
     }
+    std::sort(dueTimers.begin(), dueTimers.end(), timerLessThan);
 
     //fire the timers.
-    while (maxCount--) {
-        if (isEmpty())
-            break;
-
-        QTimerInfo *currentTimerInfo = constFirst();
-        if (currentTime < currentTimerInfo->timeout)
-            break; // no timer has expired
-
-        if (!firstTimerInfo) {
-            firstTimerInfo = currentTimerInfo;
-        } else if (firstTimerInfo == currentTimerInfo) {
-            // avoid sending the same timer multiple times
-            break;
-        } else if (currentTimerInfo->interval <  firstTimerInfo->interval
-                   || currentTimerInfo->interval == firstTimerInfo->interval) {
-            firstTimerInfo = currentTimerInfo;
-        }
-
-        // remove from list
-        removeFirst();
+    while (!dueTimers.isEmpty()) {
+        QTimerInfo *currentTimerInfo = dueTimers.takeFirst();
 
 #ifdef QTIMERINFO_DEBUG
         float diff;
@@ -641,6 +795,8 @@ int QTimerInfoList::activateTimers()
         // Send event, but don't allow it to recurse:
         if (!currentTimerInfo->activateRef) {
             currentTimerInfo->activateRef = &currentTimerInfo;
+            if (currentTimerInfo == firstTimer)
+                firstTimerValid = false;
 
             QTimerEvent e(currentTimerInfo->id);
             QCoreApplication::sendEvent(currentTimerInfo->obj, &e);
@@ -648,12 +804,13 @@ int QTimerInfoList::activateTimers()
             // Storing currentTimerInfo's address in its activateRef allows the
             // handling of that event to clear this local variable on deletion
             // of the object it points to - if it didn't, clear activateRef:
-            if (currentTimerInfo)
+            if (currentTimerInfo) {
                 currentTimerInfo->activateRef = nullptr;
+                updateFirstTimer(currentTimerInfo);
+            }
         }
     }
 
-    firstTimerInfo = nullptr;
     // qDebug() << "Thread" << QThread::currentThreadId() << "activated" << n_act << "timers";
     return n_act;
 }
@@ -56,6 +56,8 @@
 // #define QTIMERINFO_DEBUG
 
 #include "qabstracteventdispatcher.h"
+#include "qhash.h"
+#include "qlist.h"
 
 #include <sys/time.h> // struct timeval
 
@@ -70,6 +72,11 @@ struct QTimerInfo {
     QObject *obj;     // - object to receive event
     QTimerInfo **activateRef; // - ref from activateTimers
 
+    QTimerInfo *next;  // - next timer in the same wheel slot
+    QTimerInfo **prev; // - link pointing to this timer
+    quint64 sequence;  // - insertion order, for timers with equal timeouts
+    int slot;          // - wheel slot, or -1 if about to be activated
+
 #ifdef QTIMERINFO_DEBUG
     timeval expected; // when timer is expected to fire
     float cumulativeError;
@@ -77,7 +84,14 @@ struct QTimerInfo {
 #endif
 };
 
-class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
+// Timers are kept in a hierarchical timing wheel: WheelLevels levels of
+// WheelSlots slots each, level 0 having a resolution of one millisecond and
+// each further level covering the whole range of the one below it. A timer
+// is stored in the lowest level where its timeout shares all higher digits
+// with the current wheel time, so inserting and removing a timer are O(1).
+// When the wheel time advances, timers of the slots it reached are moved
+// down to the lower levels.
+class Q_CORE_EXPORT QTimerInfoList
 {
 #if ((_POSIX_MONOTONIC_CLOCK-0 <= 0) && !defined(Q_OS_MAC)) || defined(QT_BOOTSTRAPPED)
     timespec previousTime;
@@ -89,11 +103,34 @@ class Q_CORE_EXPORT QTimerInfoList : public QList<QTimerInfo*>
     void timerRepair(const timespec &);
 #endif
 
+    static constexpr int WheelSlotBits = 6;
+    static constexpr int WheelSlots = 1 << WheelSlotBits;
+    static constexpr int WheelLevels = 8;
+
+    QTimerInfo *wheel[WheelLevels * WheelSlots];
+    quint64 occupiedSlots[WheelLevels];
+    qint64 wheelTime;
+    quint64 nextSequence;
+
+    QHash<int, QTimerInfo *> timers;
     // state variables used by activateTimers()
-    QTimerInfo *firstTimerInfo;
+    QList<QTimerInfo *> dueTimers;
+
+    // earliest timer not being activated, if firstTimerValid
+    QTimerInfo *firstTimer;
+    bool firstTimerValid;
+
+    void advanceWheel();
+    void rebuildWheel();
+    void wheelInsert(QTimerInfo *);
+    void wheelRemove(QTimerInfo *);
+    void removeTimer(QTimerInfo *);
+    void updateFirstTimer(QTimerInfo *);
+    QTimerInfo *findFirstTimer() const;
 
 public:
     QTimerInfoList();
+    ~QTimerInfoList();
 
     timespec currentTime;
     timespec updateCurrentTime();
@@ -112,6 +149,12 @@ public:
     QList<QAbstractEventDispatcher::TimerInfo> registeredTimers(QObject *object) const;
 
     int activateTimers();
+
+    bool isEmpty() const { return timers.isEmpty(); }
+    qsizetype size() const { return timers.size(); }
+
+private:
+    Q_DISABLE_COPY(QTimerInfoList)
 };
 
 QT_END_NAMESPACE
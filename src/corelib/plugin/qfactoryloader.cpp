@@ -64,6 +64,7 @@
 
 #if QT_CONFIG(library)
 #  include "qlibrary_p.h"
+#  include "qpluginmetadatacache_p.h"
 #endif
 
 #include <qtcore_tracepoints_p.h>
@@ -266,6 +267,8 @@ inline void QFactoryLoaderPrivate::updateSinglePath(const QString &path)
             libraryList += library.release();
         }
     };
+
+    QPluginMetaDataCache::sync();
 }
 
 void QFactoryLoader::update()
@@ -63,6 +63,7 @@
 #include "qelfparser_p.h"
 #include "qfactoryloader_p.h"
 #include "qmachparser_p.h"
+#include "qpluginmetadatacache_p.h"
 
 #include <qtcore_tracepoints_p.h>
 
@@ -245,6 +246,18 @@ static QLibraryScanResult qt_find_pattern(const char *s, qsizetype s_len, QStrin
 */
 static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
 {
+    QPluginMetaDataCache *cache = QPluginMetaDataCache::instance();
+    QPluginMetaDataCache::FileStamp stamp;
+    if (cache) {
+        stamp = QPluginMetaDataCache::stamp(library);
+        const QByteArray cached = cache->value(library, stamp);
+        if (!cached.isNull() && lib->metaData.parse(cached)) {
+            qCDebug(qt_lcDebugPlugins, "Found cached metadata for lib %ls",
+                    qUtf16Printable(library));
+            return true;
+        }
+    }
+
     QFile file(library);
     if (!file.open(QIODevice::ReadOnly)) {
         if (lib)
@@ -293,6 +306,8 @@ static bool findPatternUnloaded(const QString &library, QLibraryPrivate *lib)
             qCDebug(qt_lcDebugPlugins, "Found metadata in lib %ls, metadata=\n%s\n",
                     qUtf16Printable(library),
                     QJsonDocument(lib->metaData.toJson()).toJson().constData());
+            if (cache)
+                cache->insert(library, stamp, QByteArrayView(filedata + r.pos, r.length));
             return true;
         }
     } else {
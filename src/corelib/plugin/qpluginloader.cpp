@@ -99,6 +99,16 @@ using namespace Qt::StringLiterals;
     every instance has called unload(). Right before the unloading
     happens, the root component will also be deleted.
 
+    Before a plugin is loaded, its metadata has to be read from the file,
+    which requires opening and scanning it. Applications that start often
+    and look at many plugins can avoid that by setting the
+    \c QT_PLUGIN_METADATA_CACHE environment variable to the path of a cache
+    file. Qt then stores the metadata of each plugin it scans in that file,
+    and reuses it as long as the plugin file has the same size and
+    modification time. The cache file can be shared by several
+    applications, and is written when plugin directories have been scanned
+    and when the application exits.
+
     See \l{How to Create Qt Plugins} for more information about
     how to make your application extensible through plugins.
 
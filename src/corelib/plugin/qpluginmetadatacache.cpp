@@ -0,0 +1,265 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qpluginmetadatacache_p.h"
+
+#include "qlibrary_p.h"
+
+#include <qcborarray.h>
+#include <qcoreapplication.h>
+#include <qcbormap.h>
+#include <qcborvalue.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfileinfo.h>
+#include <qplugin.h>
+#include <qsavefile.h>
+
+#include <private/qfilesystemengine_p.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+// Layout of the cache file (CBOR):
+//  {
+//      "version": 1,
+//      "directories": {
+//          <directory>: {
+//              <file name>: [ <size>, <modification time in ms since epoch>, <raw metadata> ]
+//          }
+//      }
+//  }
+// The raw metadata is the QPluginMetaData::Header followed by the CBOR
+// stream, exactly as found in the plugin file.
+static constexpr int CacheFormatVersion = 1;
+
+Q_GLOBAL_STATIC(QPluginMetaDataCache, pluginMetaDataCache)
+
+static std::pair<QString, QString> splitFileName(const QString &fileName)
+{
+    const qsizetype slash = fileName.lastIndexOf(u'/');
+    return { fileName.left(slash + 1), fileName.mid(slash + 1) };
+}
+
+/*!
+    \internal
+
+    Returns the cache used by the current process, or \nullptr if caching
+    is disabled. The \c QT_PLUGIN_METADATA_CACHE environment variable is
+    re-read on every call; if it names a different file than before,
+    pending changes are written out and the new file is loaded.
+*/
+QPluginMetaDataCache *QPluginMetaDataCache::instance()
+{
+    const QString path = qEnvironmentVariable("QT_PLUGIN_METADATA_CACHE");
+    if (path.isEmpty())
+        return nullptr;
+    QPluginMetaDataCache *cache = pluginMetaDataCache();
+    if (cache)
+        cache->setCacheFile(path);
+    return cache;
+}
+
+/*!
+    \internal
+
+    Returns the size and modification time of \a fileName, or an invalid
+    stamp if the file does not exist.
+*/
+QPluginMetaDataCache::FileStamp QPluginMetaDataCache::stamp(const QString &fileName)
+{
+    QFileSystemMetaData metaData;
+    QFileSystemEngine::fillMetaData(QFileSystemEntry(fileName), metaData,
+                                    QFileSystemMetaData::ExistsAttribute
+                                    | QFileSystemMetaData::SizeAttribute
+                                    | QFileSystemMetaData::ModificationTime);
+    if (!metaData.exists())
+        return {};
+    return { metaData.size(), metaData.modificationTime().toMSecsSinceEpoch() };
+}
+
+/*!
+    \internal
+
+    Writes the cache file if entries were added since it was last written.
+*/
+void QPluginMetaDataCache::sync()
+{
+    if (QPluginMetaDataCache *cache = instance()) {
+        QMutexLocker locker(&cache->mutex);
+        if (cache->dirty)
+            cache->save();
+    }
+}
+
+QPluginMetaDataCache::QPluginMetaDataCache()
+{
+    // catch entries added by QPluginLoader and QLibrary
+    qAddPostRoutine(&QPluginMetaDataCache::sync);
+}
+
+/*!
+    \internal
+
+    Returns the raw metadata cached for \a fileName, provided that the file
+    still has the size and modification time given in \a stamp. Otherwise,
+    returns a null QByteArray.
+*/
+QByteArray QPluginMetaDataCache::value(const QString &fileName, FileStamp stamp)
+{
+    if (!stamp.isValid())
+        return QByteArray();
+
+    const auto [dirName, baseName] = splitFileName(fileName);
+    QMutexLocker locker(&mutex);
+    auto dir = directories.constFind(dirName);
+    if (dir == directories.constEnd())
+        return QByteArray();
+    auto entry = dir->constFind(baseName);
+    if (entry == dir->constEnd() || entry->stamp != stamp)
+        return QByteArray();
+    return entry->rawMetaData;
+}
+
+/*!
+    \internal
+
+    Records \a rawMetaData as the metadata of \a fileName, as it was when the
+    file had the size and modification time given in \a stamp.
+*/
+void QPluginMetaDataCache::insert(const QString &fileName, FileStamp stamp,
+                                  QByteArrayView rawMetaData)
+{
+    if (!stamp.isValid())
+        return;
+
+    const auto [dirName, baseName] = splitFileName(fileName);
+    QMutexLocker locker(&mutex);
+    directories[dirName][baseName] = Entry{ stamp, rawMetaData.toByteArray() };
+    dirty = true;
+}
+
+void QPluginMetaDataCache::setCacheFile(const QString &path)
+{
+    QMutexLocker locker(&mutex);
+    if (path == cacheFile)
+        return;
+    if (dirty)
+        save();
+    cacheFile = path;
+    directories.clear();
+    load();
+}
+
+void QPluginMetaDataCache::load()
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return;
+
+    QCborParserError error;
+    const QCborMap root = QCborValue::fromCbor(file.readAll(), &error).toMap();
+    if (error.error != QCborError::NoError
+            || root.value("version"_L1).toInteger() != CacheFormatVersion) {
+        qCDebug(qt_lcDebugPlugins, "Ignoring invalid plugin metadata cache %ls",
+                qUtf16Printable(cacheFile));
+        return;
+    }
+
+    const QCborMap dirs = root.value("directories"_L1).toMap();
+    for (auto dir : dirs) {
+        Directory &entries = directories[dir.first.toString()];
+        const QCborMap files = dir.second.toMap();
+        for (auto file : files) {
+            const QCborArray fields = file.second.toArray();
+            if (fields.size() != 3)
+                continue;
+            FileStamp stamp = { fields.at(0).toInteger(-1), fields.at(1).toInteger() };
+            QByteArray rawMetaData = fields.at(2).toByteArray();
+            if (rawMetaData.size() < qsizetype(sizeof(QPluginMetaData::Header)))
+                continue;
+            entries.insert(file.first.toString(), Entry{ stamp, std::move(rawMetaData) });
+        }
+    }
+}
+
+void QPluginMetaDataCache::save()
+{
+    dirty = false;
+
+    QCborMap dirs;
+    for (auto dir = directories.begin(); dir != directories.end(); ) {
+        QCborMap files;
+        for (auto entry = dir->begin(); entry != dir->end(); ) {
+            // forget plugins that were removed since they were cached
+            if (!stamp(dir.key() + entry.key()).isValid()) {
+                entry = dir->erase(entry);
+                continue;
+            }
+            files.insert(entry.key(), QCborArray{ entry->stamp.size,
+                                                  entry->stamp.modificationTime,
+                                                  entry->rawMetaData });
+            ++entry;
+        }
+        if (files.isEmpty()) {
+            dir = directories.erase(dir);
+            continue;
+        }
+        dirs.insert(dir.key(), files);
+        ++dir;
+    }
+
+    QCborMap root;
+    root.insert("version"_L1, CacheFormatVersion);
+    root.insert("directories"_L1, dirs);
+
+    QDir().mkpath(QFileInfo(cacheFile).absolutePath());
+    QSaveFile file(cacheFile);
+    bool ok = file.open(QIODevice::WriteOnly);
+    ok = ok && file.write(root.toCborValue().toCbor()) >= 0;
+    ok = ok && file.commit();
+    if (!ok) {
+        qCDebug(qt_lcDebugPlugins, "Could not write plugin metadata cache %ls: %ls",
+                qUtf16Printable(cacheFile), qUtf16Printable(file.errorString()));
+    }
+}
+
+QT_END_NAMESPACE
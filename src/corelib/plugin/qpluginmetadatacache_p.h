@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QPLUGINMETADATACACHE_P_H
+#define QPLUGINMETADATACACHE_P_H
+
+//
+//  W A R N I N G
+//  -------------
+//
+// This file is not part of the Qt API.  It exists purely as an
+// implementation detail.  This header file may change from version to
+// version without notice, or even be removed.
+//
+// We mean it.
+//
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+
+QT_REQUIRE_CONFIG(library);
+
+QT_BEGIN_NAMESPACE
+
+// Persistent cache of the raw metadata of plugins, so that unchanged plugins
+// need not be opened and scanned. It is enabled by setting the
+// QT_PLUGIN_METADATA_CACHE environment variable to the path of the cache file.
+// Entries are grouped by directory and validated by size and modification
+// time of the plugin file.
+class Q_AUTOTEST_EXPORT QPluginMetaDataCache
+{
+public:
+    struct FileStamp
+    {
+        qint64 size = -1;
+        qint64 modificationTime = 0;
+
+        bool isValid() const noexcept { return size >= 0; }
+        friend bool operator==(FileStamp lhs, FileStamp rhs) noexcept
+        { return lhs.size == rhs.size && lhs.modificationTime == rhs.modificationTime; }
+        friend bool operator!=(FileStamp lhs, FileStamp rhs) noexcept
+        { return !(lhs == rhs); }
+    };
+
+    static QPluginMetaDataCache *instance();
+    static FileStamp stamp(const QString &fileName);
+    static void sync();
+
+    QByteArray value(const QString &fileName, FileStamp stamp);
+    void insert(const QString &fileName, FileStamp stamp, QByteArrayView rawMetaData);
+
+    QPluginMetaDataCache();
+
+private:
+    struct Entry
+    {
+        FileStamp stamp;
+        QByteArray rawMetaData;
+    };
+    using Directory = QHash<QString, Entry>;
+
+    void setCacheFile(const QString &path);
+    void load();
+    void save();
+
+    QMutex mutex;
+    QString cacheFile;
+    QHash<QString, Directory> directories;
+    bool dirty = false;
+};
+
+QT_END_NAMESPACE
+
+#endif // QPLUGINMETADATACACHE_P_H
@@ -47,6 +47,7 @@
 #include "private/qstringconverter_p.h"
 #include "private/qcborvalue_p.h"
 #include "private/qnumeric_p.h"
+#include "private/qsimd_p.h"
 
 //#define PARSER_DEBUG
 #ifdef PARSER_DEBUG
@@ -60,8 +61,6 @@ Q_CONSTINIT static int indent = 0;
 #define DEBUG if (1) ; else qDebug()
 #endif
 
-static const int nestingLimit = 1024;
-
 QT_BEGIN_NAMESPACE
 
 // error strings for the JSON parser
@@ -223,11 +222,9 @@ private:
 };
 
 Parser::Parser(const char *json, int length)
-    : head(json), json(json)
+    : Tokenizer(json, length)
     , nestingLevel(0)
-    , lastError(QJsonParseError::NoError)
 {
-    end = json + length;
 }
 
 
@@ -258,67 +255,6 @@ ws = *(
 
 */
 
-enum {
-    Space = 0x20,
-    Tab = 0x09,
-    LineFeed = 0x0a,
-    Return = 0x0d,
-    BeginArray = 0x5b,
-    BeginObject = 0x7b,
-    EndArray = 0x5d,
-    EndObject = 0x7d,
-    NameSeparator = 0x3a,
-    ValueSeparator = 0x2c,
-    Quote = 0x22
-};
-
-void Parser::eatBOM()
-{
-    // eat UTF-8 byte order mark
-    uchar utf8bom[3] = { 0xef, 0xbb, 0xbf };
-    if (end - json > 3 &&
-        (uchar)json[0] == utf8bom[0] &&
-        (uchar)json[1] == utf8bom[1] &&
-        (uchar)json[2] == utf8bom[2])
-        json += 3;
-}
-
-bool Parser::eatSpace()
-{
-    while (json < end) {
-        if (*json > Space)
-            break;
-        if (*json != Space &&
-            *json != Tab &&
-            *json != LineFeed &&
-            *json != Return)
-            break;
-        ++json;
-    }
-    return (json < end);
-}
-
-char Parser::nextToken()
-{
-    if (!eatSpace())
-        return 0;
-    char token = *json++;
-    switch (token) {
-    case BeginArray:
-    case BeginObject:
-    case NameSeparator:
-    case ValueSeparator:
-    case EndArray:
-    case EndObject:
-    case Quote:
-        break;
-    default:
-        token = 0;
-        break;
-    }
-    return token;
-}
-
 /*
     JSON-text = object / array
 */
@@ -607,51 +543,26 @@ bool Parser::parseValue()
 
     switch (*json++) {
     case 'n':
-        if (end - json < 4) {
-            lastError = QJsonParseError::IllegalValue;
+        if (!scanLiteral("ull", 3))
             return false;
-        }
-        if (*json++ == 'u' &&
-            *json++ == 'l' &&
-            *json++ == 'l') {
-            container->append(QCborValue(QCborValue::Null));
-            DEBUG << "value: null";
-            END;
-            return true;
-        }
-        lastError = QJsonParseError::IllegalValue;
-        return false;
+        container->append(QCborValue(QCborValue::Null));
+        DEBUG << "value: null";
+        END;
+        return true;
     case 't':
-        if (end - json < 4) {
-            lastError = QJsonParseError::IllegalValue;
+        if (!scanLiteral("rue", 3))
             return false;
-        }
-        if (*json++ == 'r' &&
-            *json++ == 'u' &&
-            *json++ == 'e') {
-            container->append(QCborValue(true));
-            DEBUG << "value: true";
-            END;
-            return true;
-        }
-        lastError = QJsonParseError::IllegalValue;
-        return false;
+        container->append(QCborValue(true));
+        DEBUG << "value: true";
+        END;
+        return true;
     case 'f':
-        if (end - json < 5) {
-            lastError = QJsonParseError::IllegalValue;
+        if (!scanLiteral("alse", 4))
             return false;
-        }
-        if (*json++ == 'a' &&
-            *json++ == 'l' &&
-            *json++ == 's' &&
-            *json++ == 'e') {
-            container->append(QCborValue(false));
-            DEBUG << "value: false";
-            END;
-            return true;
-        }
-        lastError = QJsonParseError::IllegalValue;
-        return false;
+        container->append(QCborValue(false));
+        DEBUG << "value: false";
+        END;
+        return true;
     case Quote: {
         if (!parseString())
             return false;
@@ -713,9 +624,35 @@ bool Parser::parseValue()
 
 */
 
+bool Tokenizer::scanLiteral(const char *rest, qsizetype restLength)
+{
+    // a document cannot end with a literal, so there must be at least one
+    // more character after it
+    if (end - json <= restLength) {
+        lastError = QJsonParseError::IllegalValue;
+        return false;
+    }
+    for (qsizetype i = 0; i < restLength; ++i) {
+        if (*json++ != rest[i]) {
+            lastError = QJsonParseError::IllegalValue;
+            return false;
+        }
+    }
+    return true;
+}
+
 bool Parser::parseNumber()
 {
-    BEGIN << "parseNumber" << json;
+    QCborValue number;
+    if (!scanNumber(&number))
+        return false;
+    container->append(number);
+    return true;
+}
+
+bool Tokenizer::scanNumber(QCborValue *result)
+{
+    BEGIN << "scanNumber" << json;
 
     const char *start = json;
     bool isInt = true;
@@ -763,7 +700,7 @@ bool Parser::parseNumber()
         bool ok;
         qlonglong n = number.toLongLong(&ok);
         if (ok) {
-            container->append(QCborValue(n));
+            *result = QCborValue(n);
             END;
             return true;
         }
@@ -779,9 +716,9 @@ bool Parser::parseNumber()
 
     qint64 n;
     if (convertDoubleTo(d, &n))
-        container->append(QCborValue(n));
+        *result = QCborValue(n);
     else
-        container->append(QCborValue(d));
+        *result = QCborValue(d);
 
     END;
     return true;
@@ -881,85 +818,165 @@ static inline bool scanUtf8Char(const char *&json, const char *end, char32_t *re
     return true;
 }
 
-bool Parser::parseString()
+/*
+    Returns a pointer to the first byte in [json, end) that is a quotation
+    mark, a backslash or not US-ASCII. Everything before it can be taken
+    verbatim as string contents.
+*/
+static const char *skipUnescapedAscii(const char *json, const char *end)
 {
-    const char *start = json;
-
-    // try to parse a utf-8 string without escape sequences, and note whether it's 7bit ASCII.
-
-    BEGIN << "parse string" << json;
-    bool isUtf8 = true;
-    bool isAscii = true;
+#if defined(__SSE2__)
+#  if defined(__AVX2__)
+    const __m256i quote32 = _mm256_set1_epi8('"');
+    const __m256i backslash32 = _mm256_set1_epi8('\\');
+    while (json + 32 <= end) {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(json));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(data, quote32),
+                                          _mm256_cmpeq_epi8(data, backslash32));
+        // the high bit of non-ASCII bytes is the sign bit, which is what PMOVMSKB reads
+        quint32 mask = _mm256_movemask_epi8(_mm256_or_si256(special, data));
+        if (mask)
+            return json + qCountTrailingZeroBits(mask);
+        json += 32;
+    }
+#  endif
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    while (json + 16 <= end) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(json));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(data, quote),
+                                       _mm_cmpeq_epi8(data, backslash));
+        quint32 mask = _mm_movemask_epi8(_mm_or_si128(special, data));
+        if (mask)
+            return json + qCountTrailingZeroBits(mask);
+        json += 16;
+    }
+#elif defined(__ARM_NEON__)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t nonAscii = vdupq_n_u8(0x80);
+    while (json + 16 <= end) {
+        uint8x16_t data = vld1q_u8(reinterpret_cast<const uint8_t *>(json));
+        uint8x16_t special = vorrq_u8(vorrq_u8(vceqq_u8(data, quote), vceqq_u8(data, backslash)),
+                                      vcgeq_u8(data, nonAscii));
+        // narrow to four bits per byte so the result fits in 64 bits
+        quint64 mask = vget_lane_u64(vreinterpret_u64_u8(
+                vshrn_n_u16(vreinterpretq_u16_u8(special), 4)), 0);
+        if (mask)
+            return json + qCountTrailingZeroBits(mask) / 4;
+        json += 16;
+    }
+#endif
     while (json < end) {
-        char32_t ch = 0;
-        if (*json == '"')
-            break;
-        if (*json == '\\') {
-            isAscii = false;
-            // If we find escape sequences, we store UTF-16 as there are some
-            // escape sequences which are hard to represent in UTF-8.
-            // (plain "\\ud800" for example)
-            isUtf8 = false;
+        const uchar c = uchar(*json);
+        if (c >= 0x80 || c == '"' || c == '\\')
             break;
-        }
-        if (!scanUtf8Char(json, end, &ch)) {
-            lastError = QJsonParseError::IllegalUTF8String;
-            return false;
-        }
-        if (ch > 0x7f)
-            isAscii = false;
-        DEBUG << "  " << ch << char(ch);
+        ++json;
     }
-    ++json;
-    DEBUG << "end of string";
-    if (json >= end) {
-        lastError = QJsonParseError::UnterminatedString;
+    return json;
+}
+
+bool Parser::parseString()
+{
+    StringToken string;
+    if (!scanString(&string))
         return false;
-    }
 
     // no escape sequences, we are done
-    if (isUtf8) {
-        if (isAscii)
-            container->appendAsciiString(start, json - start - 1);
+    if (!string.hasEscapeSequences) {
+        if (string.isAscii)
+            container->appendAsciiString(string.begin, string.size);
         else
-            container->appendUtf8String(start, json - start - 1);
+            container->appendUtf8String(string.begin, string.size);
         END;
         return true;
     }
 
     DEBUG << "has escape sequences";
 
-    json = start;
+    // If we find escape sequences, we store UTF-16 as there are some
+    // escape sequences which are hard to represent in UTF-8.
+    // (plain "\\ud800" for example)
+    const QString ucs4 = decodeString(string.begin, string.begin + string.size);
+    container->appendByteData(reinterpret_cast<const char *>(ucs4.constData()), ucs4.size() * 2,
+                              QCborValue::String, QtCbor::Element::StringIsUtf16);
+    END;
+    return true;
+}
 
-    QString ucs4;
+/*
+    Scans a string starting after the opening quote mark and validates its
+    contents, leaving json pointing past the closing quote mark. The string is
+    not decoded.
+*/
+bool Tokenizer::scanString(StringToken *string)
+{
+    const char *start = json;
+
+    BEGIN << "scan string" << json;
+    bool isAscii = true;
+    bool hasEscapeSequences = false;
     while (json < end) {
         char32_t ch = 0;
         if (*json == '"')
             break;
-        else if (*json == '\\') {
+        if (uchar(*json) < 0x80 && *json != '\\') {
+            json = skipUnescapedAscii(json + 1, end);
+            continue;
+        }
+        if (*json == '\\') {
+            hasEscapeSequences = true;
             if (!scanEscapeSequence(json, end, &ch)) {
                 lastError = QJsonParseError::IllegalEscapeSequence;
                 return false;
             }
-        } else {
-            if (!scanUtf8Char(json, end, &ch)) {
-                lastError = QJsonParseError::IllegalUTF8String;
-                return false;
-            }
+            continue;
         }
-        ucs4.append(QChar::fromUcs4(ch));
+        if (!scanUtf8Char(json, end, &ch)) {
+            lastError = QJsonParseError::IllegalUTF8String;
+            return false;
+        }
+        if (ch > 0x7f)
+            isAscii = false;
+        DEBUG << "  " << ch << char(ch);
     }
     ++json;
-
+    DEBUG << "end of string";
     if (json >= end) {
         lastError = QJsonParseError::UnterminatedString;
         return false;
     }
 
-    container->appendByteData(reinterpret_cast<const char *>(ucs4.constData()), ucs4.size() * 2,
-                              QCborValue::String, QtCbor::Element::StringIsUtf16);
+    string->begin = start;
+    string->size = json - start - 1;
+    string->isAscii = isAscii && !hasEscapeSequences;
+    string->hasEscapeSequences = hasEscapeSequences;
     END;
     return true;
 }
 
+/*
+    Decodes the contents of a string previously validated by scanString().
+*/
+QString Tokenizer::decodeString(const char *json, const char *end)
+{
+    QString ucs4;
+    ucs4.reserve(end - json);
+    while (json < end) {
+        const char *run = skipUnescapedAscii(json, end);
+        if (run != json) {
+            ucs4.append(QLatin1StringView(json, run - json));
+            json = run;
+            continue;
+        }
+        char32_t ch = 0;
+        if (*json == '\\')
+            scanEscapeSequence(json, end, &ch);
+        else
+            scanUtf8Char(json, end, &ch);
+        ucs4.append(QChar::fromUcs4(ch));
+    }
+    return ucs4;
+}
+
 QT_END_NAMESPACE
@@ -59,7 +59,98 @@ QT_BEGIN_NAMESPACE
 
 namespace QJsonPrivate {
 
-class Parser
+class Tokenizer
+{
+public:
+    Tokenizer(const char *json, qsizetype length)
+        : head(json), json(json), end(json + length)
+    {
+    }
+
+    static constexpr int nestingLimit = 1024;
+
+    enum Token : char {
+        Space = 0x20,
+        Tab = 0x09,
+        LineFeed = 0x0a,
+        Return = 0x0d,
+        BeginArray = 0x5b,
+        BeginObject = 0x7b,
+        EndArray = 0x5d,
+        EndObject = 0x7d,
+        NameSeparator = 0x3a,
+        ValueSeparator = 0x2c,
+        Quote = 0x22
+    };
+
+    struct StringToken {
+        const char *begin = nullptr;
+        qsizetype size = 0;
+        bool isAscii = true;
+        bool hasEscapeSequences = false;
+    };
+
+    static QString decodeString(const char *begin, const char *end);
+
+protected:
+    void eatBOM()
+    {
+        // eat UTF-8 byte order mark
+        if (end - json > 3 &&
+            uchar(json[0]) == 0xef &&
+            uchar(json[1]) == 0xbb &&
+            uchar(json[2]) == 0xbf)
+            json += 3;
+    }
+
+    bool eatSpace()
+    {
+        while (json < end) {
+            if (*json > Space)
+                break;
+            if (*json != Space &&
+                *json != Tab &&
+                *json != LineFeed &&
+                *json != Return)
+                break;
+            ++json;
+        }
+        return (json < end);
+    }
+
+    char nextToken()
+    {
+        if (!eatSpace())
+            return 0;
+        char token = *json++;
+        switch (token) {
+        case BeginArray:
+        case BeginObject:
+        case NameSeparator:
+        case ValueSeparator:
+        case EndArray:
+        case EndObject:
+        case Quote:
+            break;
+        default:
+            token = 0;
+            break;
+        }
+        return token;
+    }
+
+    bool scanLiteral(const char *rest, qsizetype restLength);
+    bool scanString(StringToken *string);
+    bool scanNumber(QCborValue *number);
+
+    const char *head;
+    const char *json;
+    const char *end;
+
+    QJsonParseError::ParseError lastError = QJsonParseError::NoError;
+};
+
+class Parser : public Tokenizer
 {
 public:
     Parser(const char *json, int length);
@@ -67,22 +158,14 @@ public:
     QCborValue parse(QJsonParseError *error);
 
 private:
-    inline void eatBOM();
-    inline bool eatSpace();
-    inline char nextToken();
-
     bool parseObject();
     bool parseArray();
     bool parseMember();
     bool parseString();
     bool parseValue();
     bool parseNumber();
-    const char *head;
-    const char *json;
-    const char *end;
 
     int nestingLevel;
-    QJsonParseError::ParseError lastError;
     QExplicitlySharedDataPointer<QCborContainerPrivate> container;
 };
 
@@ -0,0 +1,660 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qjsonstreamreader.h"
+#include "qjsonparser_p.h"
+
+#include <bitset>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonStreamReaderPrivate : public QJsonPrivate::Tokenizer
+{
+public:
+    enum State : quint8 {
+        ExpectDocument,
+        ExpectFirstMember,
+        ExpectMemberValue,
+        ExpectFirstElement,
+        AfterValue,
+        Finished
+    };
+
+    explicit QJsonStreamReaderPrivate(const QByteArray &data)
+        : Tokenizer(nullptr, 0)
+    {
+        reset(data);
+    }
+
+    void reset(const QByteArray &data)
+    {
+        buffer = data;
+        head = json = tokenBegin = buffer.constData();
+        end = head + buffer.size();
+        lastError = QJsonParseError::NoError;
+        string = StringToken();
+        number = QCborValue();
+        boolean = false;
+        depth = 0;
+        state = ExpectDocument;
+    }
+
+    QJsonStreamReader::TokenType readNext();
+
+    const char *position() const { return json; }
+    qsizetype offsetOf(const char *ptr) const { return ptr - head; }
+    QJsonParseError::ParseError parseError() const { return lastError; }
+
+    QByteArray buffer;
+    const char *tokenBegin;
+    StringToken string;
+    QCborValue number;
+    bool boolean;
+    int depth;
+    State state;
+    std::bitset<nestingLimit> containerIsObject;
+
+private:
+    QJsonStreamReader::TokenType readKey();
+    QJsonStreamReader::TokenType readValue();
+    QJsonStreamReader::TokenType readSeparator();
+    QJsonStreamReader::TokenType enterContainer(char token);
+    QJsonStreamReader::TokenType leaveContainer();
+    QJsonStreamReader::TokenType fail(QJsonParseError::ParseError error)
+    {
+        lastError = error;
+        tokenBegin = json;
+        state = Finished;
+        return QJsonStreamReader::Invalid;
+    }
+};
+
+/*
+    The state machine below follows the recursive descent in QJsonPrivate::Parser
+    step by step, so that both report the same errors for the same input.
+*/
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readNext()
+{
+    switch (state) {
+    case ExpectDocument: {
+        eatBOM();
+        const char token = nextToken();
+        if (token == BeginArray || token == BeginObject)
+            return enterContainer(token);
+        return fail(QJsonParseError::IllegalValue);
+    }
+    case ExpectFirstMember: {
+        const char token = nextToken();
+        if (token == Quote)
+            return readKey();
+        if (token == EndObject)
+            return leaveContainer();
+        return fail(QJsonParseError::UnterminatedObject);
+    }
+    case ExpectMemberValue:
+        if (nextToken() != NameSeparator)
+            return fail(QJsonParseError::MissingNameSeparator);
+        if (!eatSpace())
+            return fail(QJsonParseError::UnterminatedObject);
+        return readValue();
+    case ExpectFirstElement:
+        if (!eatSpace())
+            return fail(QJsonParseError::UnterminatedArray);
+        if (*json == EndArray) {
+            ++json;
+            return leaveContainer();
+        }
+        return readValue();
+    case AfterValue:
+        return readSeparator();
+    case Finished:
+        break;
+    }
+    Q_UNREACHABLE();
+    return QJsonStreamReader::Invalid;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readKey()
+{
+    tokenBegin = json - 1;
+    if (!scanString(&string))
+        return fail(lastError);
+    state = ExpectMemberValue;
+    return QJsonStreamReader::Key;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readValue()
+{
+    tokenBegin = json;
+    state = AfterValue;
+    switch (*json++) {
+    case 'n':
+        if (!scanLiteral("ull", 3))
+            return fail(lastError);
+        return QJsonStreamReader::Null;
+    case 't':
+        if (!scanLiteral("rue", 3))
+            return fail(lastError);
+        boolean = true;
+        return QJsonStreamReader::Bool;
+    case 'f':
+        if (!scanLiteral("alse", 4))
+            return fail(lastError);
+        boolean = false;
+        return QJsonStreamReader::Bool;
+    case Quote:
+        if (!scanString(&string))
+            return fail(lastError);
+        return QJsonStreamReader::String;
+    case BeginArray:
+    case BeginObject:
+        return enterContainer(json[-1]);
+    case ValueSeparator:
+        // Essentially missing value, but after a colon, not after a comma
+        // like the other MissingObject errors.
+        return fail(QJsonParseError::IllegalValue);
+    case EndObject:
+    case EndArray:
+        return fail(QJsonParseError::MissingObject);
+    default:
+        --json;
+        if (!scanNumber(&number))
+            return fail(lastError);
+        return QJsonStreamReader::Number;
+    }
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::readSeparator()
+{
+    if (depth == 0) {
+        if (eatSpace())
+            return fail(QJsonParseError::GarbageAtEnd);
+        tokenBegin = json;
+        state = Finished;
+        return QJsonStreamReader::EndDocument;
+    }
+
+    const char token = nextToken();
+    if (containerIsObject[depth - 1]) {
+        if (token == EndObject)
+            return leaveContainer();
+        if (token == ValueSeparator) {
+            const char next = nextToken();
+            if (next == Quote)
+                return readKey();
+            if (next == EndObject)
+                return fail(QJsonParseError::MissingObject);
+        }
+        return fail(QJsonParseError::UnterminatedObject);
+    }
+
+    if (token == EndArray)
+        return leaveContainer();
+    if (token == ValueSeparator) {
+        if (!eatSpace())
+            return fail(QJsonParseError::UnterminatedArray);
+        return readValue();
+    }
+    if (!eatSpace())
+        return fail(QJsonParseError::UnterminatedArray);
+    return fail(QJsonParseError::MissingValueSeparator);
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::enterContainer(char token)
+{
+    if (depth >= nestingLimit)
+        return fail(QJsonParseError::DeepNesting);
+
+    const bool isObject = token == BeginObject;
+    tokenBegin = json - 1;
+    containerIsObject[depth++] = isObject;
+    state = isObject ? ExpectFirstMember : ExpectFirstElement;
+    return isObject ? QJsonStreamReader::StartObject : QJsonStreamReader::StartArray;
+}
+
+QJsonStreamReader::TokenType QJsonStreamReaderPrivate::leaveContainer()
+{
+    tokenBegin = json - 1;
+    state = AfterValue;
+    return containerIsObject[--depth] ? QJsonStreamReader::EndObject
+                                      : QJsonStreamReader::EndArray;
+}
+
+/*!
+    \class QJsonStreamReader
+    \inmodule QtCore
+    \ingroup json
+    \reentrant
+    \since 6.4
+
+    \brief The QJsonStreamReader class is a fast, non-allocating pull parser
+    for JSON text.
+
+    QJsonDocument::fromJson() builds the complete document in memory before
+    any of it can be inspected. For large inputs, or when only a few values
+    are of interest, QJsonStreamReader can be used instead: it walks the JSON
+    text one token at a time, in the style of QXmlStreamReader and
+    QCborStreamReader, without creating any intermediate representation.
+
+    Call readNext() to advance to the next token and tokenType() or one of the
+    convenience functions such as isKey() or isStartObject() to find out what
+    was read. Keys and strings can be accessed with rawText(), which returns a
+    view into the input buffer, or with text(), which decodes escape sequences
+    into a QString. Numbers and booleans are available with toInteger(),
+    toDouble() and toBool().
+
+    \snippet code/src_corelib_serialization_qjsonstreamreader.cpp 0
+
+    QJsonStreamReader accepts exactly the same documents as
+    QJsonDocument::fromJson() and reports the same QJsonParseError codes for
+    malformed input. However, since it does not keep the document in memory,
+    it does not detect or remove duplicate keys in an object: every member is
+    reported in the order it appears in the text.
+
+    If an error occurs, readNext() returns \l Invalid, and error() contains
+    the error code and the offset at which parsing stopped. All tokens read
+    before the error remain valid.
+
+    \sa QJsonDocument, QCborStreamReader, QXmlStreamReader
+*/
+
+/*!
+    \enum QJsonStreamReader::TokenType
+
+    This enum describes the token that was last read by readNext().
+
+    \value NoToken      readNext() has not been called yet.
+    \value Invalid      An error occurred; see error().
+    \value StartObject  The opening brace of an object.
+    \value EndObject    The closing brace of an object.
+    \value StartArray   The opening bracket of an array.
+    \value EndArray     The closing bracket of an array.
+    \value Key          The name of an object member. The member's value is
+                        the next token.
+    \value String       A string value.
+    \value Number       A number.
+    \value Bool         The literal \c true or \c false.
+    \value Null         The literal \c null.
+    \value EndDocument  The end of the document was reached, with no trailing
+                        content other than whitespace.
+*/
+
+/*!
+    Creates a QJsonStreamReader object with no data.
+
+    \sa setData()
+*/
+QJsonStreamReader::QJsonStreamReader()
+    : d(new QJsonStreamReaderPrivate({}))
+{
+}
+
+/*!
+    \overload
+
+    Creates a QJsonStreamReader object that parses \a len bytes of JSON text
+    starting at \a data. The data is not copied: the pointer must remain valid
+    until the QJsonStreamReader is destroyed or given different data.
+*/
+QJsonStreamReader::QJsonStreamReader(const char *data, qsizetype len)
+    : QJsonStreamReader(QByteArray::fromRawData(data, len))
+{
+}
+
+/*!
+    Creates a QJsonStreamReader object that parses the JSON text found in
+    \a data.
+*/
+QJsonStreamReader::QJsonStreamReader(const QByteArray &data)
+    : d(new QJsonStreamReaderPrivate(data))
+{
+}
+
+/*!
+    Destroys this QJsonStreamReader object.
+*/
+QJsonStreamReader::~QJsonStreamReader()
+{
+}
+
+/*!
+    Sets the JSON text to be parsed to \a data and resets the reader to the
+    beginning of the document.
+
+    \sa clear()
+*/
+void QJsonStreamReader::setData(const QByteArray &data)
+{
+    d->reset(data);
+    type_ = NoToken;
+}
+
+/*!
+    \overload
+
+    Sets the JSON text to be parsed to the \a len bytes starting at \a data
+    and resets the reader to the beginning of the document. The data is not
+    copied: the pointer must remain valid until the QJsonStreamReader is
+    destroyed or given different data.
+*/
+void QJsonStreamReader::setData(const char *data, qsizetype len)
+{
+    setData(QByteArray::fromRawData(data, len));
+}
+
+/*!
+    Releases the data being parsed and resets the reader.
+
+    \sa setData()
+*/
+void QJsonStreamReader::clear()
+{
+    setData(QByteArray());
+}
+
+/*!
+    Reads the next token and returns its type.
+
+    Once the end of the document or an error has been reached, this function
+    keeps returning \l EndDocument or \l Invalid, respectively.
+
+    \sa tokenType(), atEnd()
+*/
+QJsonStreamReader::TokenType QJsonStreamReader::readNext()
+{
+    if (!atEnd())
+        type_ = d->readNext();
+    return tokenType();
+}
+
+/*!
+    \fn QJsonStreamReader::TokenType QJsonStreamReader::tokenType() const
+
+    Returns the type of the current token.
+
+    \sa readNext()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::atEnd() const
+
+    Returns \c true if the reader has reached the end of the document or has
+    stopped because of an error.
+
+    \sa hasError(), isEndDocument()
+*/
+
+/*!
+    \fn bool QJsonStreamReader::hasError() const
+
+    Returns \c true if an error occurred while parsing.
+
+    \sa error()
+*/
+
+/*!
+    Returns the error that stopped the parser, or a QJsonParseError with
+    QJsonParseError::NoError if there was none. The offset is that of the
+    position in the input at which the error was detected.
+
+    \sa hasError()
+*/
+QJsonParseError QJsonStreamReader::error() const
+{
+    QJsonParseError error;
+    if (hasError()) {
+        error.offset = int(d->offsetOf(d->position()));
+        error.error = d->parseError();
+    } else {
+        error.offset = 0;
+        error.error = QJsonParseError::NoError;
+    }
+    return error;
+}
+
+/*!
+    Returns the offset in the input of the first byte of the current token.
+
+    \sa readNext()
+*/
+qsizetype QJsonStreamReader::currentOffset() const
+{
+    return d->offsetOf(d->tokenBegin);
+}
+
+/*!
+    Returns the number of objects and arrays that enclose the current token.
+    A \l StartObject or \l StartArray token counts the container it opens; an
+    \l EndObject or \l EndArray token no longer counts the container it closes.
+*/
+int QJsonStreamReader::containerDepth() const
+{
+    return d->depth;
+}
+
+/*!
+    \fn bool QJsonStreamReader::isStartObject() const
+
+    Returns \c true if the current token is \l StartObject.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndObject() const
+
+    Returns \c true if the current token is \l EndObject.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isStartArray() const
+
+    Returns \c true if the current token is \l StartArray.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndArray() const
+
+    Returns \c true if the current token is \l EndArray.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isKey() const
+
+    Returns \c true if the current token is \l Key.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isString() const
+
+    Returns \c true if the current token is \l String.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNumber() const
+
+    Returns \c true if the current token is \l Number.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isBool() const
+
+    Returns \c true if the current token is \l Bool.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isNull() const
+
+    Returns \c true if the current token is \l Null.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isEndDocument() const
+
+    Returns \c true if the current token is \l EndDocument.
+*/
+
+/*!
+    \fn bool QJsonStreamReader::isInvalid() const
+
+    Returns \c true if the current token is \l Invalid.
+*/
+
+/*!
+    Returns a view of the current token in the input, without copying it.
+
+    For \l Key and \l String tokens, this is the content between the quotation
+    marks, with escape sequences left undecoded; if hasEscapeSequences()
+    returns \c false, it is the exact value of the string. For \l Number,
+    \l Bool and \l Null tokens, it is the literal text of the value. For all
+    other tokens, the view is empty.
+
+    The view remains valid as long as the input data does.
+
+    \sa text(), hasEscapeSequences()
+*/
+QUtf8StringView QJsonStreamReader::rawText() const
+{
+    switch (tokenType()) {
+    case Key:
+    case String:
+        return QUtf8StringView(d->string.begin, d->string.size);
+    case Number:
+    case Bool:
+    case Null:
+        return QUtf8StringView(d->tokenBegin, d->position());
+    default:
+        break;
+    }
+    return QUtf8StringView();
+}
+
+/*!
+    Returns \c true if the current token is a \l Key or \l String containing
+    escape sequences, in which case rawText() differs from text().
+*/
+bool QJsonStreamReader::hasEscapeSequences() const
+{
+    return (isKey() || isString()) && d->string.hasEscapeSequences;
+}
+
+/*!
+    Returns the decoded value of the current \l Key or \l String token. For
+    any other token, returns a null QString.
+
+    \sa rawText()
+*/
+QString QJsonStreamReader::text() const
+{
+    if (!isKey() && !isString())
+        return QString();
+    const QJsonPrivate::Tokenizer::StringToken &string = d->string;
+    if (string.hasEscapeSequences)
+        return QJsonPrivate::Tokenizer::decodeString(string.begin, string.begin + string.size);
+    if (string.isAscii)
+        return QString::fromLatin1(string.begin, string.size);
+    return QString::fromUtf8(string.begin, string.size);
+}
+
+/*!
+    Returns \c true if the current token is a \l Number that can be
+    represented exactly as a 64-bit integer.
+
+    \sa toInteger()
+*/
+bool QJsonStreamReader::isInteger() const
+{
+    return isNumber() && d->number.isInteger();
+}
+
+/*!
+    Returns the value of the current \l Number token as a 64-bit integer, or
+    \a defaultValue if the current token is not a number or cannot be
+    represented exactly as an integer.
+
+    \sa isInteger(), toDouble()
+*/
+qint64 QJsonStreamReader::toInteger(qint64 defaultValue) const
+{
+    return isInteger() ? d->number.toInteger() : defaultValue;
+}
+
+/*!
+    Returns the value of the current \l Number token as a double, or
+    \a defaultValue if the current token is not a number.
+
+    \sa toInteger()
+*/
+double QJsonStreamReader::toDouble(double defaultValue) const
+{
+    return isNumber() ? d->number.toDouble() : defaultValue;
+}
+
+/*!
+    Returns the value of the current \l Bool token, or \c false if the current
+    token is not a boolean.
+*/
+bool QJsonStreamReader::toBool() const
+{
+    return isBool() && d->boolean;
+}
+
+/*!
+    Reads until the end of the innermost object or array that contains the
+    current token. If the current token is \l StartObject or \l StartArray,
+    that is the container it opens. Returns \c true if the matching
+    \l EndObject or \l EndArray was reached, \c false if an error occurred or
+    there is no enclosing container.
+
+    The skipped tokens are validated but not decoded.
+*/
+bool QJsonStreamReader::skipCurrentContainer()
+{
+    const int targetDepth = d->depth - 1;
+    if (targetDepth < 0)
+        return false;
+    while (readNext() != Invalid) {
+        if (d->depth == targetDepth)
+            return true;
+    }
+    return false;
+}
+
+QT_END_NAMESPACE
+
+#include "moc_qjsonstreamreader.cpp"
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QJSONSTREAMREADER_H
+#define QJSONSTREAMREADER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qobjectdefs.h>
+#include <QtCore/qscopedpointer.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qutf8stringview.h>
+
+QT_BEGIN_NAMESPACE
+
+class QJsonStreamReaderPrivate;
+class Q_CORE_EXPORT QJsonStreamReader
+{
+    Q_GADGET
+public:
+    enum TokenType : quint8 {
+        NoToken = 0,
+        Invalid,
+        StartObject,
+        EndObject,
+        StartArray,
+        EndArray,
+        Key,
+        String,
+        Number,
+        Bool,
+        Null,
+        EndDocument
+    };
+    Q_ENUM(TokenType)
+
+    QJsonStreamReader();
+    QJsonStreamReader(const char *data, qsizetype len);
+    explicit QJsonStreamReader(const QByteArray &data);
+    ~QJsonStreamReader();
+    Q_DISABLE_COPY(QJsonStreamReader)
+
+    void setData(const QByteArray &data);
+    void setData(const char *data, qsizetype len);
+    void clear();
+
+    TokenType readNext();
+    TokenType tokenType() const     { return TokenType(type_); }
+    bool atEnd() const              { return isEndDocument() || isInvalid(); }
+    bool hasError() const           { return isInvalid(); }
+    QJsonParseError error() const;
+    qsizetype currentOffset() const;
+    int containerDepth() const;
+
+    bool isStartObject() const      { return tokenType() == StartObject; }
+    bool isEndObject() const        { return tokenType() == EndObject; }
+    bool isStartArray() const       { return tokenType() == StartArray; }
+    bool isEndArray() const         { return tokenType() == EndArray; }
+    bool isKey() const              { return tokenType() == Key; }
+    bool isString() const           { return tokenType() == String; }
+    bool isNumber() const           { return tokenType() == Number; }
+    bool isBool() const             { return tokenType() == Bool; }
+    bool isNull() const             { return tokenType() == Null; }
+    bool isEndDocument() const      { return tokenType() == EndDocument; }
+    bool isInvalid() const          { return tokenType() == Invalid; }
+
+    QUtf8StringView rawText() const;
+    bool hasEscapeSequences() const;
+    QString text() const;
+
+    bool isInteger() const;
+    qint64 toInteger(qint64 defaultValue = 0) const;
+    double toDouble(double defaultValue = 0) const;
+    bool toBool() const;
+
+    bool skipCurrentContainer();
+
+private:
+    QScopedPointer<QJsonStreamReaderPrivate> d;
+    quint8 type_ = NoToken;
+};
+
+QT_END_NAMESPACE
+
+#endif // QJSONSTREAMREADER_H
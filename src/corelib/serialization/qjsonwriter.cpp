@@ -45,6 +45,7 @@
 #include "private/qstringconverter_p.h"
 #include <private/qnumeric_p.h>
 #include <private/qcborvalue_p.h>
+#include <private/qsimd_p.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -58,6 +59,51 @@ static inline uchar hexdig(uint u)
     return (u < 0xa ? '0' + u : 'a' + u - 0xa);
 }
 
+// Copies the leading characters of src that are US-ASCII and need no escaping
+// to dst, looking at no more than len characters. Returns the number of
+// characters copied. May write up to len bytes to dst.
+static qsizetype copyUnescapedAscii(uchar *dst, const char16_t *src, qsizetype len)
+{
+    qsizetype i = 0;
+#if defined(__SSE2__)
+    const __m128i space = _mm_set1_epi16(0x20);
+    const __m128i maxAscii = _mm_set1_epi16(0x7f);
+    const __m128i quote = _mm_set1_epi16('"');
+    const __m128i backslash = _mm_set1_epi16('\\');
+    for ( ; i + 8 <= len; i += 8) {
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+        // the comparisons are signed, so anything above 0x7fff counts as below 0x20
+        __m128i special = _mm_or_si128(_mm_cmplt_epi16(data, space),
+                                       _mm_cmpgt_epi16(data, maxAscii));
+        special = _mm_or_si128(special, _mm_or_si128(_mm_cmpeq_epi16(data, quote),
+                                                     _mm_cmpeq_epi16(data, backslash)));
+        _mm_storel_epi64(reinterpret_cast<__m128i *>(dst + i), _mm_packus_epi16(data, data));
+        if (uint mask = _mm_movemask_epi8(special))
+            return i + qCountTrailingZeroBits(mask) / 2;
+    }
+#elif defined(__ARM_NEON__)
+    const uint16x8_t space = vdupq_n_u16(0x20);
+    const uint16x8_t maxAscii = vdupq_n_u16(0x7f);
+    const uint16x8_t quote = vdupq_n_u16('"');
+    const uint16x8_t backslash = vdupq_n_u16('\\');
+    for ( ; i + 8 <= len; i += 8) {
+        uint16x8_t data = vld1q_u16(reinterpret_cast<const uint16_t *>(src + i));
+        uint16x8_t special = vorrq_u16(vcltq_u16(data, space), vcgtq_u16(data, maxAscii));
+        special = vorrq_u16(special, vorrq_u16(vceqq_u16(data, quote), vceqq_u16(data, backslash)));
+        vst1_u8(dst + i, vmovn_u16(data));
+        if (quint64 mask = vget_lane_u64(vreinterpret_u64_u8(vmovn_u16(special)), 0))
+            return i + qCountTrailingZeroBits(mask) / 8;
+    }
+#endif
+    for ( ; i < len; ++i) {
+        const char16_t u = src[i];
+        if (u < 0x20 || u >= 0x80 || u == '"' || u == '\\')
+            break;
+        dst[i] = uchar(u);
+    }
+    return i;
+}
+
 static QByteArray escapedString(const QString &s)
 {
     // give it a minimum size to ensure the resize() below always adds enough space
@@ -112,6 +158,10 @@ static QByteArray escapedString(const QString &s)
                }
             } else {
                 *cursor++ = (uchar)u;
+                // plain text usually comes in runs, so copy the rest of it in bulk
+                const qsizetype n = copyUnescapedAscii(cursor, src, qMin(end - src, ba_end - 6 - cursor));
+                cursor += n;
+                src += n;
             }
         } else if (QUtf8Functions::toUtf8<QUtf8BaseTraits>(u, cursor, src, end) < 0) {
             // failed to get valid utf8 use JSON escape sequence
@@ -3557,9 +3557,25 @@ QString QCalendarBackend::dateTimeToString(QStringView format, const QDateTime &
 
 // End of QCalendar intrustions
 
+/*
+    Returns true if this locale writes numbers with the same digits, decimal
+    point, minus sign and exponent separator as the C locale.
+*/
+bool QLocaleData::hasCNumberSymbols() const
+{
+    return zeroUcs() == u'0' && decimalPoint() == u"." && negativeSign() == u"-"
+            && exponentSeparator() == u"e";
+}
+
 QString QLocaleData::doubleToString(double d, int precision, DoubleForm form,
                                     int width, unsigned flags) const
 {
+    // Without grouping, padding or other decorations, a locale using the C
+    // locale's symbols formats exactly as QString::number() does, which writes
+    // straight into the result instead of going through intermediate strings.
+    if (width <= 0 && (flags & ~CapitalEorX) == ZeroPadExponent && hasCNumberSymbols())
+        return qdtoBasicLatin(d, form, precision, flags & CapitalEorX);
+
     // Although the special handling of F.P.Shortest below is limited to
     // DFSignificantDigits, the double-conversion library does treat it
     // specially for the other forms, shedding trailing zeros for DFDecimal and
@@ -4107,11 +4123,50 @@ bool QLocaleData::validateChars(QStringView str, NumberMode numMode, QByteArray
     return true;
 }
 
+/*
+    Fast path of numberToCLocale() for floating-point numbers written with
+    ASCII digits, signs, exponent and (if this locale uses it) '.' as decimal
+    point only, which are all the C locale's own. Returns false, without
+    touching \a result, if \a s contains anything else or if \a
+    number_options asks for checks that only numberToCLocale() does.
+*/
+bool QLocaleData::asciiNumberToCLocale(QStringView s, QLocale::NumberOptions number_options,
+                                       CharBuff *result) const
+{
+    if (number_options & (QLocale::RejectLeadingZeroInExponent
+                          | QLocale::RejectTrailingZeroesAfterDot)) {
+        return false;
+    }
+
+    s = s.trimmed();
+    if (s.isEmpty())
+        return false;
+
+    bool hasPoint = false;
+    for (QChar c : s) {
+        const char16_t ch = c.unicode();
+        if (ch == u'.')
+            hasPoint = true;
+        else if ((ch < u'0' || ch > u'9') && ch != u'+' && ch != u'-' && ch != u'e' && ch != u'E')
+            return false;
+    }
+    if (hasPoint && decimalPoint() != u".")
+        return false;
+
+    result->resize(s.size() + 1);
+    char *out = result->data();
+    for (QChar c : s)
+        *out++ = c == u'E' ? 'e' : char(c.unicode());
+    *out = '\0';
+    return true;
+}
+
 double QLocaleData::stringToDouble(QStringView str, bool *ok,
                                    QLocale::NumberOptions number_options) const
 {
     CharBuff buff;
-    if (!numberToCLocale(str, number_options, &buff)) {
+    if (!asciiNumberToCLocale(str, number_options, &buff)
+        && !numberToCLocale(str, number_options, &buff)) {
         if (ok != nullptr)
             *ok = false;
         return 0.0;
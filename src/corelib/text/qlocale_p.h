@@ -243,6 +243,9 @@ private:
     [[nodiscard]] QString signPrefix(bool negative, unsigned flags) const;
     [[nodiscard]] QString applyIntegerFormatting(QString &&numStr, bool negative, int precision,
                                                  int base, int width, unsigned flags) const;
+    [[nodiscard]] bool hasCNumberSymbols() const;
+    [[nodiscard]] bool asciiNumberToCLocale(QStringView s, QLocale::NumberOptions number_options,
+                                            CharBuff *result) const;
 
 public:
     [[nodiscard]] QString doubleToString(double d,
@@ -75,6 +75,56 @@ QT_BEGIN_NAMESPACE
 
 QT_CLOCALE_HOLDER
 
+#if !defined(QT_NO_DOUBLECONVERSION) && !defined(QT_BOOTSTRAPPED) \
+    && defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+// The standard library's floating-point <charconv> (Ryu and Eisel-Lemire on
+// current implementations) produces exactly the same results as
+// libdouble-conversion's SHORTEST mode and StringToDouble(), in considerably
+// less time. For the cases they don't cover we keep using libdouble-conversion.
+#  define QT_FLOAT_CHARCONV
+
+static void doubleToShortestAscii(double d, char *buf, bool &sign, int &length, int &decpt)
+{
+    // std::to_chars() in scientific format gives us [-]d[.ddd]e(+|-)dd[d]
+    char scientific[32];
+    const auto result = std::to_chars(scientific, scientific + sizeof(scientific), d,
+                                      std::chars_format::scientific);
+    Q_ASSERT(result.ec == std::errc{});
+
+    const char *p = scientific;
+    sign = *p == '-';
+    if (sign)
+        ++p;
+    length = 0;
+    for (; *p != 'e'; ++p) {
+        if (*p != '.')
+            buf[length++] = *p;
+    }
+    ++p;
+    if (*p == '+')
+        ++p;
+    int exponent = 0;
+    std::from_chars(p, result.ptr, exponent);
+    decpt = exponent + 1;
+}
+
+static bool asciiToDoubleFast(const char *num, qsizetype numLen, double &d, int &processed)
+{
+    // std::from_chars() accepts "infinity" and "nan(...)", but not a leading '+'
+    // or spaces. So only use it for a plain number, which it has to consume
+    // completely. Over- and underflow are also left to the caller.
+    const char *const end = num + numLen;
+    const char *p = num < end && *num == '-' ? num + 1 : num;
+    if (p == end || !((*p >= '0' && *p <= '9') || *p == '.'))
+        return false;
+    const auto result = std::from_chars(num, end, d, std::chars_format::general);
+    if (result.ec != std::errc{} || result.ptr != end)
+        return false;
+    processed = int(numLen);
+    return true;
+}
+#endif
+
 void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, char *buf, int bufSize,
                       bool &sign, int &length, int &decpt)
 {
@@ -121,6 +171,15 @@ void qt_doubleToAscii(double d, QLocaleData::DoubleForm form, int precision, cha
     if (form == QLocaleData::DFExponent && precision >= 0)
         ++precision;
 
+#ifdef QT_FLOAT_CHARCONV
+    // Callers reserve max_digits10 characters, or more, for the shortest form.
+    if (precision == QLocale::FloatingPointShortest
+        && bufSize >= std::numeric_limits<double>::max_digits10) {
+        doubleToShortestAscii(d, buf, sign, length, decpt);
+        return;
+    }
+#endif
+
     double_conversion::DoubleToStringConverter::DtoaMode mode;
     if (precision == QLocale::FloatingPointShortest) {
         mode = double_conversion::DoubleToStringConverter::SHORTEST;
@@ -335,7 +394,10 @@ double qt_asciiToDouble(const char *num, qsizetype numLen, bool &ok, int &proces
         processed = 0;
         return 0.0;
     } else {
-        d = conv.StringToDouble(num, numLen, &processed);
+#ifdef QT_FLOAT_CHARCONV
+        if (!asciiToDoubleFast(num, numLen, d, processed))
+#endif
+            d = conv.StringToDouble(num, numLen, &processed);
     }
 
     if (!qIsFinite(d)) {
@@ -0,0 +1,563 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qmultistringmatcher.h"
+
+#include <QtCore/qatomic.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+// An Aho-Corasick automaton, normally turned into a deterministic one: every
+// state has a transition for every input, so matching does exactly one table
+// lookup per code unit (or byte) of the subject, however many patterns there
+// are.
+struct MatcherAutomaton
+{
+    // The dense table has one entry per state and class: with many distinct
+    // characters in many long patterns (typically CJK text), it would grow
+    // far too big. Larger automata keep the sparse trie and follow the
+    // failure links at run time instead. The limit also keeps the rows
+    // stored in the table well within the range of qint32.
+    static constexpr qsizetype MaxDenseEntries = qsizetype(1) << 24;
+
+    // Inputs are mapped to a small number of classes: one for each distinct
+    // (case-folded) unit occurring in the patterns, and class 0 for all the
+    // rest. The map is split in pages of 256 units; pages without any of the
+    // patterns' units share page 0, which is all zero.
+    std::array<quint32, 256> pageIndex = {};
+    QList<quint32> classes;
+    qsizetype classCount = 0;
+
+    // Indexed by a state's row (the state times classCount) plus the class of
+    // the next input: the row of the next state, shifted left by one, with
+    // bit 0 set if any pattern ends in that state. Empty if the automaton
+    // is sparse.
+    QList<qint32> transitions;
+
+    // The transitions of the trie, keyed by the state in the high 32 bits
+    // and the class in the low ones, and the failure links. Only kept if
+    // the automaton is sparse.
+    QHash<quint64, qint32> edges;
+    QList<qint32> failure;
+
+    // The patterns ending in each state: outputs[outputOffsets[state]] up to
+    // outputs[outputOffsets[state + 1]]
+    QList<qint32> outputOffsets;
+    QList<qsizetype> outputs;
+
+    template <typename Fold>
+    void build(const QList<QList<char16_t>> &needles, const QList<qsizetype> &needleIndexes,
+               char32_t unitCount, Fold fold);
+
+    // Calls onOutput(state) for each position of the subject where a pattern
+    // ends, stopping early if it returns true
+    template <bool FoldSurrogatePairs = false, typename Unit, typename OnOutput>
+    void run(const Unit *begin, const Unit *end, OnOutput onOutput) const;
+
+private:
+    static quint64 edgeKey(qint32 state, quint32 c) { return quint64(state) << 32 | c; }
+    quint32 classOf(char16_t unit) const { return classes[pageIndex[unit >> 8] * 256 + (unit & 0xff)]; }
+    bool hasOutput(qint32 state) const
+    {
+        return outputOffsets.at(state) != outputOffsets.at(state + 1);
+    }
+};
+
+template <typename Fold>
+void MatcherAutomaton::build(const QList<QList<char16_t>> &needles,
+                             const QList<qsizetype> &needleIndexes, char32_t unitCount, Fold fold)
+{
+    // assign the classes
+    std::vector<quint32> classOfFolded(unitCount);
+    classCount = 1;
+    for (const QList<char16_t> &needle : needles) {
+        for (char16_t unit : needle) {
+            if (!classOfFolded[unit])
+                classOfFolded[unit] = quint32(classCount++);
+        }
+    }
+
+    classes.fill(0, 256);
+    for (char32_t page = 0; page < unitCount / 256; ++page) {
+        const qsizetype pageStart = classes.size();
+        bool used = false;
+        for (char32_t unit = page * 256; unit < (page + 1) * 256; ++unit) {
+            const quint32 c = classOfFolded[fold(char16_t(unit))];
+            classes.append(c);
+            used |= c != 0;
+        }
+        if (used)
+            pageIndex[page] = quint32(pageStart / 256);
+        else
+            classes.resize(pageStart);
+    }
+
+    // build the trie
+    std::vector<std::vector<std::pair<quint32, qint32>>> children(1);
+    QList<QList<qsizetype>> ends(1);
+    for (qsizetype i = 0; i < needles.size(); ++i) {
+        qint32 state = 0;
+        for (char16_t unit : needles.at(i)) {
+            const quint32 c = classOfFolded[unit];
+            auto it = edges.constFind(edgeKey(state, c));
+            if (it == edges.cend()) {
+                const qint32 target = qint32(ends.size());
+                ends.emplace_back();
+                children.emplace_back();
+                children[state].emplace_back(c, target);
+                it = edges.insert(edgeKey(state, c), target);
+            }
+            state = *it;
+        }
+        ends[state].append(needleIndexes.at(i));
+    }
+
+    // Breadth-first, so that a state's failure link (the state for the
+    // longest proper suffix of its path that is also in the trie) is always
+    // complete by the time we get to the state itself. Patterns ending in the
+    // failure link end in the state too.
+    const qsizetype stateCount = ends.size();
+    failure.fill(0, stateCount);
+    QList<qint32> order;
+    order.reserve(stateCount);
+    order.append(0);
+    for (qsizetype i = 0; i < order.size(); ++i) {
+        const qint32 state = order.at(i);
+        for (const auto &[c, target] : children[state]) {
+            qint32 fail = 0;
+            for (qint32 f = state; f != 0; ) {
+                f = failure.at(f);
+                const auto it = edges.constFind(edgeKey(f, c));
+                if (it != edges.cend()) {
+                    fail = *it;
+                    break;
+                }
+            }
+            failure[target] = fail;
+            ends[target] += ends.at(fail);
+            order.append(target);
+        }
+    }
+
+    outputOffsets.resize(stateCount + 1);
+    outputs.clear();
+    for (qsizetype state = 0; state < stateCount; ++state) {
+        outputOffsets[state] = qint32(outputs.size());
+        outputs += ends.at(state);
+    }
+    outputOffsets[stateCount] = qint32(outputs.size());
+
+    if (stateCount > MaxDenseEntries / classCount)
+        return;
+
+    // Missing transitions are replaced by the failure link's, which come
+    // earlier in breadth-first order.
+    transitions.resize(stateCount * classCount);
+    for (qint32 state : std::as_const(order)) {
+        qint32 *row = transitions.data() + state * classCount;
+        const qint32 *failRow = transitions.constData() + failure.at(state) * classCount;
+        for (qsizetype c = 0; c < classCount; ++c)
+            row[c] = state ? failRow[c] : 0;
+        for (const auto &[c, target] : children[state])
+            row[c] = qint32(target * classCount * 2) | (hasOutput(target) ? 1 : 0);
+    }
+    edges.clear();
+    failure.clear();
+}
+
+template <bool FoldSurrogatePairs, typename Unit, typename OnOutput>
+void MatcherAutomaton::run(const Unit *begin, const Unit *end, OnOutput onOutput) const
+{
+    if (outputs.isEmpty())
+        return;
+
+    auto scan = [&](auto step) {
+        for (const Unit *p = begin; p != end; ++p) {
+            if constexpr (FoldSurrogatePairs) {
+                // the class table folds the case of each code unit, which
+                // can't work for the letters outside the BMP
+                if (Q_UNLIKELY(QChar::isHighSurrogate(*p)) && end - p > 1 && QChar::isLowSurrogate(p[1])) {
+                    const char32_t folded = QChar::toCaseFolded(QChar::surrogateToUcs4(p[0], p[1]));
+                    ++p;
+                    if (step(QChar::highSurrogate(folded)) || step(QChar::lowSurrogate(folded)))
+                        return;
+                    continue;
+                }
+            }
+            if (step(*p))
+                return;
+        }
+    };
+
+    if (!transitions.isEmpty()) {
+        const qint32 *next = transitions.constData();
+        qint32 entry = 0;
+        scan([&](char16_t unit) {
+            entry = next[(entry >> 1) + classOf(unit)];
+            return (entry & 1) && onOutput((entry >> 1) / classCount);
+        });
+    } else {
+        qint32 state = 0;
+        scan([&](char16_t unit) {
+            const quint32 c = classOf(unit);
+            while (true) {
+                const auto it = edges.constFind(edgeKey(state, c));
+                if (it != edges.cend()) {
+                    state = *it;
+                    break;
+                }
+                if (state == 0)
+                    break;
+                state = failure.at(state);
+            }
+            return hasOutput(state) && onOutput(state);
+        });
+    }
+}
+} // unnamed namespace
+
+class QMultiStringMatcherPrivate : public QSharedData
+{
+public:
+    QMultiStringMatcherPrivate(const QStringList &patterns, Qt::CaseSensitivity cs);
+    ~QMultiStringMatcherPrivate() { delete utf8.loadRelaxed(); }
+
+    const MatcherAutomaton &utf8Automaton() const;
+
+    template <typename Unit>
+    QList<qsizetype> matchingPatterns(const MatcherAutomaton &automaton,
+                                      const Unit *begin, const Unit *end) const;
+
+    QStringList patterns;
+    Qt::CaseSensitivity cs;
+    QList<qsizetype> emptyPatterns;
+    QList<qsizetype> indexes;
+    MatcherAutomaton utf16;
+    // only built when first searching UTF-8 text
+    mutable QAtomicPointer<MatcherAutomaton> utf8 = nullptr;
+};
+
+QMultiStringMatcherPrivate::QMultiStringMatcherPrivate(const QStringList &patterns,
+                                                       Qt::CaseSensitivity cs)
+    : patterns(patterns), cs(cs)
+{
+    QList<QList<char16_t>> needles;
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        const QString &pattern = patterns.at(i);
+        if (pattern.isEmpty()) {
+            emptyPatterns.append(i);
+            continue;
+        }
+        indexes.append(i);
+
+        const QString folded = cs == Qt::CaseSensitive ? pattern : pattern.toCaseFolded();
+        needles.append(QList<char16_t>(folded.utf16(), folded.utf16() + folded.size()));
+    }
+    if (indexes.isEmpty())
+        return;
+
+    if (cs == Qt::CaseSensitive) {
+        utf16.build(needles, indexes, 0x10000, [](char16_t unit) { return unit; });
+    } else {
+        utf16.build(needles, indexes, 0x10000, [](char16_t unit) {
+            return char16_t(QChar::toCaseFolded(char32_t(unit)));
+        });
+    }
+}
+
+const MatcherAutomaton &QMultiStringMatcherPrivate::utf8Automaton() const
+{
+    if (const MatcherAutomaton *automaton = utf8.loadAcquire())
+        return *automaton;
+
+    auto automaton = std::make_unique<MatcherAutomaton>();
+    if (!indexes.isEmpty()) {
+        QList<QList<char16_t>> needles;
+        for (qsizetype i : indexes) {
+            const QByteArray encoded = cs == Qt::CaseSensitive ? patterns.at(i).toUtf8()
+                                                               : patterns.at(i).toUtf8().toLower();
+            QList<char16_t> &needle = needles.emplace_back();
+            for (char c : encoded)
+                needle.append(uchar(c));
+        }
+        if (cs == Qt::CaseSensitive) {
+            automaton->build(needles, indexes, 0x100, [](char16_t unit) { return unit; });
+        } else {
+            automaton->build(needles, indexes, 0x100, [](char16_t unit) {
+                return unit >= 'A' && unit <= 'Z' ? char16_t(unit | 0x20) : unit;
+            });
+        }
+    }
+
+    // another thread may have been quicker
+    MatcherAutomaton *existing = nullptr;
+    if (utf8.testAndSetOrdered(nullptr, automaton.get(), existing))
+        return *automaton.release();
+    return *existing;
+}
+
+template <typename Unit>
+QList<qsizetype> QMultiStringMatcherPrivate::matchingPatterns(const MatcherAutomaton &automaton,
+                                                              const Unit *begin,
+                                                              const Unit *end) const
+{
+    QList<qsizetype> result = emptyPatterns;
+    QVarLengthArray<bool, 256> found(patterns.size(), false);
+    auto onOutput = [&](qint32 state) {
+        for (qint32 i = automaton.outputOffsets.at(state); i < automaton.outputOffsets.at(state + 1); ++i) {
+            const qsizetype pattern = automaton.outputs.at(i);
+            if (!found[pattern]) {
+                found[pattern] = true;
+                result.append(pattern);
+            }
+        }
+        return result.size() == patterns.size();
+    };
+    if (sizeof(Unit) == sizeof(char16_t) && cs == Qt::CaseInsensitive)
+        automaton.run<true>(begin, end, onOutput);
+    else
+        automaton.run(begin, end, onOutput);
+    std::sort(result.begin(), result.end());
+    return result;
+}
+
+/*!
+    \class QMultiStringMatcher
+    \inmodule QtCore
+    \since 6.4
+    \brief The QMultiStringMatcher class finds which of a set of strings occur
+    in a text, in one pass over the text.
+
+    \ingroup tools
+    \ingroup string-processing
+
+    Checking a text against many strings, one indexOf() or QStringMatcher at
+    a time, takes time proportional to the number of strings. For example,
+    a program filtering log messages on a few hundred keywords would scan
+    each message a few hundred times. QMultiStringMatcher compiles all the
+    strings, its \e patterns, into a single automaton (using the
+    Aho-Corasick algorithm) that finds all of them in one pass, whatever
+    their number.
+
+    \snippet code/src_corelib_text_qmultistringmatcher.cpp 0
+
+    matchingPatterns() returns the indexes of all the patterns that occur in
+    a text, and containsAny() tells whether any of them does, stopping as
+    soon as one is found. Both accept UTF-16 text (QStringView) and UTF-8
+    text (QByteArrayView). An empty pattern occurs in every text.
+
+    Compiling the patterns takes time, and the automaton uses memory
+    proportional to the total length of the patterns times the number of
+    distinct characters in them. When that would be too much, the matcher
+    uses a more compact but slower automaton. The automaton for UTF-8 text
+    is only compiled the first time UTF-8 text is searched. The matcher is
+    worth it when the same patterns are used on many texts.
+
+    \sa QStringMatcher, QRegularExpressionSet
+*/
+
+/*!
+    Constructs a matcher without any patterns, which won't match anything.
+    Call setPatterns() to give it patterns to match.
+*/
+QMultiStringMatcher::QMultiStringMatcher()
+    : d(new QMultiStringMatcherPrivate({}, Qt::CaseSensitive))
+{
+}
+
+/*!
+    Constructs a matcher that will search for all the \a patterns, with case
+    sensitivity \a cs.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QStringList &patterns, Qt::CaseSensitivity cs)
+    : d(new QMultiStringMatcherPrivate(patterns, cs))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QMultiStringMatcher::QMultiStringMatcher(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher::QMultiStringMatcher(QMultiStringMatcher &&other)
+
+    Move-constructs a matcher from \a other.
+
+    \note The moved-from object \a other is placed in a
+    partially-formed state, in which the only valid operations are
+    destruction and assignment of a new value.
+*/
+
+/*!
+    Destroys the matcher.
+*/
+QMultiStringMatcher::~QMultiStringMatcher() = default;
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QMultiStringMatcherPrivate)
+
+/*!
+    Assigns \a other to this matcher and returns a reference to this matcher.
+*/
+QMultiStringMatcher &QMultiStringMatcher::operator=(const QMultiStringMatcher &other) = default;
+
+/*!
+    \fn QMultiStringMatcher &QMultiStringMatcher::operator=(QMultiStringMatcher &&other)
+
+    Move-assigns \a other to this matcher and returns a reference to this
+    matcher.
+*/
+
+/*!
+    \fn void QMultiStringMatcher::swap(QMultiStringMatcher &other)
+
+    Swaps matcher \a other with this matcher. This operation is very fast and
+    never fails.
+*/
+
+/*!
+    Sets the patterns to search for to \a patterns.
+
+    \sa patterns(), setCaseSensitivity()
+*/
+void QMultiStringMatcher::setPatterns(const QStringList &patterns)
+{
+    d = new QMultiStringMatcherPrivate(patterns, d->cs);
+}
+
+/*!
+    Returns the patterns that this matcher searches for.
+
+    \sa setPatterns()
+*/
+QStringList QMultiStringMatcher::patterns() const
+{
+    return d->patterns;
+}
+
+/*!
+    Sets the case sensitivity of the matching to \a cs.
+
+    Case-insensitive matching of UTF-8 text (passed as a QByteArrayView)
+    only folds the case of US-ASCII letters.
+
+    \sa caseSensitivity()
+*/
+void QMultiStringMatcher::setCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    if (cs != d->cs)
+        d = new QMultiStringMatcherPrivate(d->patterns, cs);
+}
+
+/*!
+    Returns the case sensitivity of the matching.
+
+    \sa setCaseSensitivity()
+*/
+Qt::CaseSensitivity QMultiStringMatcher::caseSensitivity() const
+{
+    return d->cs;
+}
+
+/*!
+    Returns \c true if any of the patterns occurs in \a subject, and \c false
+    otherwise.
+
+    \sa matchingPatterns()
+*/
+bool QMultiStringMatcher::containsAny(QStringView subject) const
+{
+    if (!d->emptyPatterns.isEmpty())
+        return true;
+    bool found = false;
+    auto onOutput = [&found](qint32) { return found = true; };
+    if (d->cs == Qt::CaseInsensitive)
+        d->utf16.run<true>(subject.utf16(), subject.utf16() + subject.size(), onOutput);
+    else
+        d->utf16.run(subject.utf16(), subject.utf16() + subject.size(), onOutput);
+    return found;
+}
+
+/*!
+    \overload
+
+    The \a subject is UTF-8 text.
+*/
+bool QMultiStringMatcher::containsAny(QByteArrayView subject) const
+{
+    if (!d->emptyPatterns.isEmpty())
+        return true;
+    bool found = false;
+    const uchar *begin = reinterpret_cast<const uchar *>(subject.data());
+    d->utf8Automaton().run(begin, begin + subject.size(), [&found](qint32) { return found = true; });
+    return found;
+}
+
+/*!
+    Returns the indexes in patterns() of all the patterns that occur in
+    \a subject, in increasing order.
+
+    \sa containsAny()
+*/
+QList<qsizetype> QMultiStringMatcher::matchingPatterns(QStringView subject) const
+{
+    return d->matchingPatterns(d->utf16, subject.utf16(), subject.utf16() + subject.size());
+}
+
+/*!
+    \overload
+
+    The \a subject is UTF-8 text.
+*/
+QList<qsizetype> QMultiStringMatcher::matchingPatterns(QByteArrayView subject) const
+{
+    const uchar *begin = reinterpret_cast<const uchar *>(subject.data());
+    return d->matchingPatterns(d->utf8Automaton(), begin, begin + subject.size());
+}
+
+QT_END_NAMESPACE
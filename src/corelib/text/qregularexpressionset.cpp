@@ -0,0 +1,620 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include "qregularexpressionset.h"
+
+#include <QtCore/qmultistringmatcher.h>
+#include <QtCore/qvarlengtharray.h>
+#include <QtCore/private/qtools_p.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+constexpr bool isAsciiDigit(char16_t c) noexcept
+{
+    return c >= u'0' && c <= u'9';
+}
+
+constexpr bool isAsciiLetterOrNumber(char16_t c) noexcept
+{
+    return isAsciiDigit(c) || (c >= u'a' && c <= u'z') || (c >= u'A' && c <= u'Z');
+}
+
+// Finds a string that every match of a pattern contains, to use as a filter
+// for the subjects worth running the expression on. Only a subset of the
+// PCRE2 syntax is understood: for anything else, the finder gives up and
+// returns a null string, so the expression is always run.
+class RequiredLiteralFinder
+{
+public:
+    RequiredLiteralFinder(QStringView pattern, bool caseInsensitive)
+        : pattern(pattern), caseInsensitive(caseInsensitive)
+    {}
+
+    QString find();
+
+private:
+    enum Quantifier { NoQuantifier, Optional, Repeated, InvalidQuantifier };
+
+    bool skipEscape(bool &isLiteral, char16_t &literal);
+    bool skipClass();
+    bool skipGroup();
+    Quantifier skipQuantifier();
+    bool skipPast(char16_t c)
+    {
+        const qsizetype end = pattern.indexOf(c, pos);
+        pos = end + 1;
+        return end >= 0;
+    }
+    bool accepts(char16_t c) const
+    {
+        // The matcher folds case one code unit at a time, while PCRE2 does
+        // it per code point and with its own tables: only rely on letters
+        // being equal for US-ASCII. UTF-8 subjects are searched before
+        // being converted, so the replacement character for their invalid
+        // sequences can't be part of a literal either.
+        return !QChar::isSurrogate(c) && c != QChar::ReplacementCharacter
+                && (!caseInsensitive || c < 0x80);
+    }
+    void endRun()
+    {
+        if (run.size() > best.size())
+            best = run;
+        run.clear();
+    }
+
+    QStringView pattern;
+    qsizetype pos = 0;
+    bool caseInsensitive;
+    QString run;
+    QString best;
+};
+
+QString RequiredLiteralFinder::find()
+{
+    while (pos < pattern.size()) {
+        bool isLiteral = false;
+        char16_t literal = 0;
+        switch (const char16_t c = pattern.at(pos).unicode()) {
+        case u'|':          // alternatives: none of them is required
+        case u')':
+        case u'?':
+        case u'*':
+        case u'+':
+        case u'{':
+            return QString();
+        case u'[':
+            if (!skipClass())
+                return QString();
+            break;
+        case u'(':
+            if (!skipGroup())
+                return QString();
+            break;
+        case u'\\':
+            if (!skipEscape(isLiteral, literal))
+                return QString();
+            break;
+        case u'.':
+        case u'^':
+        case u'$':
+            ++pos;
+            break;
+        default:
+            isLiteral = true;
+            literal = c;
+            ++pos;
+            break;
+        }
+
+        isLiteral = isLiteral && accepts(literal);
+        switch (skipQuantifier()) {
+        case InvalidQuantifier:
+            return QString();
+        case Optional:
+            endRun();
+            break;
+        case Repeated:
+            // one is required, but not what follows it
+            if (isLiteral)
+                run += literal;
+            endRun();
+            break;
+        case NoQuantifier:
+            if (isLiteral)
+                run += literal;
+            else
+                endRun();
+            break;
+        }
+    }
+    endRun();
+    return best;
+}
+
+// pos is at a backslash
+bool RequiredLiteralFinder::skipEscape(bool &isLiteral, char16_t &literal)
+{
+    if (pos + 1 >= pattern.size())
+        return false;
+    const char16_t c = pattern.at(pos + 1).unicode();
+    pos += 2;
+
+    if (c >= 0x80 || !isAsciiLetterOrNumber(c)) {
+        // an escaped character that would otherwise be special
+        isLiteral = true;
+        literal = c;
+        return true;
+    }
+
+    switch (c) {
+    case u'a': isLiteral = true; literal = u'\a'; return true;
+    case u'e': isLiteral = true; literal = u'\x1b'; return true;
+    case u'f': isLiteral = true; literal = u'\f'; return true;
+    case u'n': isLiteral = true; literal = u'\n'; return true;
+    case u'r': isLiteral = true; literal = u'\r'; return true;
+    case u't': isLiteral = true; literal = u'\t'; return true;
+    case u'A': case u'b': case u'B': case u'd': case u'D': case u'G': case u'h': case u'H':
+    case u'R': case u's': case u'S': case u'v': case u'V': case u'w': case u'W': case u'X':
+    case u'z': case u'Z':
+        return true;
+    case u'c':
+        return pos++ < pattern.size();
+    case u'p':
+    case u'P':
+        if (pos < pattern.size() && pattern.at(pos) == u'{')
+            return skipPast(u'}');
+        return pos++ < pattern.size();
+    case u'x':
+        if (pos < pattern.size() && pattern.at(pos) == u'{')
+            return skipPast(u'}');
+        for (int i = 0; i < 2 && pos < pattern.size() && QtMiscUtils::fromHex(pattern.at(pos).unicode()) >= 0; ++i)
+            ++pos;
+        return true;
+    default:
+        if (isAsciiDigit(c)) {
+            // back-reference or octal escape
+            while (pos < pattern.size() && isAsciiDigit(pattern.at(pos).unicode()))
+                ++pos;
+            return true;
+        }
+        return false;
+    }
+}
+
+// pos is at an opening square bracket
+bool RequiredLiteralFinder::skipClass()
+{
+    ++pos;
+    if (pos < pattern.size() && pattern.at(pos) == u'^')
+        ++pos;
+    if (pos < pattern.size() && pattern.at(pos) == u']')
+        ++pos;
+    while (pos < pattern.size()) {
+        const char16_t c = pattern.at(pos).unicode();
+        if (c == u'\\') {
+            if (pos + 1 < pattern.size() && pattern.at(pos + 1) == u'Q')
+                return false;
+            pos += 2;
+        } else if (c == u'[' && pos + 1 < pattern.size()
+                   && (pattern.at(pos + 1) == u':' || pattern.at(pos + 1) == u'.'
+                       || pattern.at(pos + 1) == u'=')) {
+            // POSIX class, such as [:alpha:]
+            const char16_t terminator[] = { pattern.at(pos + 1).unicode(), u']' };
+            const qsizetype end = pattern.indexOf(QStringView(terminator, 2), pos + 2);
+            if (end < 0)
+                return false;
+            pos = end + 2;
+        } else {
+            ++pos;
+            if (c == u']')
+                return true;
+        }
+    }
+    return false;
+}
+
+// pos is at an opening parenthesis
+bool RequiredLiteralFinder::skipGroup()
+{
+    // Groups only count as an atom that isn't a literal, as long as they
+    // can't change how the rest of the pattern is interpreted: reject
+    // verbs like (*UCP), option settings like (?i), conditionals...
+    const QStringView rest = pattern.sliced(pos);
+    if (rest.startsWith(u"(*"))
+        return false;
+    if (rest.startsWith(u"(?")) {
+        static constexpr QStringView allowed[] = {
+            u"(?:", u"(?=", u"(?!", u"(?<=", u"(?<!", u"(?'", u"(?P<", u"(?#"
+        };
+        const bool isNamedGroup = rest.startsWith(u"(?<") && rest.size() > 3
+                && isAsciiLetterOrNumber(rest.at(3).unicode());
+        if (!isNamedGroup && std::none_of(std::begin(allowed), std::end(allowed),
+                                          [&](QStringView prefix) { return rest.startsWith(prefix); })) {
+            return false;
+        }
+    }
+
+    int depth = 0;
+    while (pos < pattern.size()) {
+        const char16_t c = pattern.at(pos).unicode();
+        if (c == u'(' && pos + 1 < pattern.size() && pattern.at(pos + 1) == u'*') {
+            // a verb anywhere, like the (*ACCEPT) in a(b(*ACCEPT))c, can end
+            // the match before the literals that follow the group
+            return false;
+        } else if (c == u'\\') {
+            if (pos + 1 < pattern.size() && pattern.at(pos + 1) == u'Q')
+                return false;
+            pos += 2;
+        } else if (c == u'[') {
+            if (!skipClass())
+                return false;
+        } else if (c == u'(' && pattern.sliced(pos).startsWith(u"(?#")) {
+            // comments end at the first closing parenthesis
+            if (!skipPast(u')'))
+                return false;
+            if (depth == 0)
+                return true;
+        } else {
+            ++pos;
+            if (c == u'(')
+                ++depth;
+            else if (c == u')' && --depth == 0)
+                return true;
+        }
+    }
+    return false;
+}
+
+RequiredLiteralFinder::Quantifier RequiredLiteralFinder::skipQuantifier()
+{
+    if (pos >= pattern.size())
+        return NoQuantifier;
+
+    Quantifier result;
+    switch (pattern.at(pos).unicode()) {
+    case u'?':
+    case u'*':
+        result = Optional;
+        ++pos;
+        break;
+    case u'+':
+        result = Repeated;
+        ++pos;
+        break;
+    case u'{': {
+        // only {n}, {n,} and {n,m}: other forms are literal text in some
+        // versions of PCRE2, but not in others
+        qsizetype i = pos + 1;
+        bool minimumIsZero = true;
+        const qsizetype digitsStart = i;
+        for (; i < pattern.size() && isAsciiDigit(pattern.at(i).unicode()); ++i)
+            minimumIsZero = minimumIsZero && pattern.at(i) == u'0';
+        if (i == digitsStart || i == pattern.size())
+            return InvalidQuantifier;
+        if (pattern.at(i) == u',') {
+            for (++i; i < pattern.size() && isAsciiDigit(pattern.at(i).unicode()); ++i)
+                ;
+        }
+        if (i == pattern.size() || pattern.at(i) != u'}')
+            return InvalidQuantifier;
+        pos = i + 1;
+        result = minimumIsZero ? Optional : Repeated;
+        break;
+    }
+    default:
+        return NoQuantifier;
+    }
+
+    // lazy or possessive
+    if (pos < pattern.size() && (pattern.at(pos) == u'?' || pattern.at(pos) == u'+'))
+        ++pos;
+    return result;
+}
+} // unnamed namespace
+
+class QRegularExpressionSetPrivate : public QSharedData
+{
+public:
+    explicit QRegularExpressionSetPrivate(const QList<QRegularExpression> &expressions);
+
+    // Calls onMatch(i) for each expression i matching subject, in order,
+    // stopping early if it returns true
+    template <typename OnMatch>
+    void match(QStringView subject, OnMatch onMatch) const;
+    template <typename OnMatch>
+    void match(QByteArrayView subject, OnMatch onMatch) const;
+
+    template <typename Subject>
+    QVarLengthArray<bool, 256> candidates(Subject subject) const;
+
+    QList<QRegularExpression> expressions;
+    // the expressions that can't be filtered by their literals
+    QList<qsizetype> unfiltered;
+    QMultiStringMatcher literals[2];
+    QList<qsizetype> literalOwners[2];
+};
+
+QRegularExpressionSetPrivate::QRegularExpressionSetPrivate(const QList<QRegularExpression> &expressions)
+    : expressions(expressions)
+{
+    QStringList literalPatterns[2];
+    for (qsizetype i = 0; i < expressions.size(); ++i) {
+        const QRegularExpression &re = expressions.at(i);
+        if (!re.isValid())
+            continue;
+
+        const QRegularExpression::PatternOptions options = re.patternOptions();
+        const bool caseInsensitive = options.testFlag(QRegularExpression::CaseInsensitiveOption);
+        QString literal;
+        if (!options.testFlag(QRegularExpression::ExtendedPatternSyntaxOption))
+            literal = RequiredLiteralFinder(re.pattern(), caseInsensitive).find();
+        if (literal.isEmpty()) {
+            unfiltered.append(i);
+        } else {
+            literalPatterns[caseInsensitive].append(literal);
+            literalOwners[caseInsensitive].append(i);
+        }
+    }
+    literals[0] = QMultiStringMatcher(literalPatterns[0], Qt::CaseSensitive);
+    literals[1] = QMultiStringMatcher(literalPatterns[1], Qt::CaseInsensitive);
+}
+
+template <typename Subject>
+QVarLengthArray<bool, 256> QRegularExpressionSetPrivate::candidates(Subject subject) const
+{
+    QVarLengthArray<bool, 256> result(expressions.size());
+    std::fill(result.begin(), result.end(), false);
+    for (qsizetype i : unfiltered)
+        result[i] = true;
+    for (int cs = 0; cs < 2; ++cs) {
+        if (literalOwners[cs].isEmpty())
+            continue;
+        for (qsizetype literal : literals[cs].matchingPatterns(subject))
+            result[literalOwners[cs].at(literal)] = true;
+    }
+    return result;
+}
+
+template <typename OnMatch>
+void QRegularExpressionSetPrivate::match(QStringView subject, OnMatch onMatch) const
+{
+    const QVarLengthArray<bool, 256> candidates = this->candidates(subject);
+    for (qsizetype i = 0; i < expressions.size(); ++i) {
+        if (candidates[i] && expressions.at(i).match(subject).hasMatch() && onMatch(i))
+            return;
+    }
+}
+
+template <typename OnMatch>
+void QRegularExpressionSetPrivate::match(QByteArrayView subject, OnMatch onMatch) const
+{
+    // The literals are searched in the UTF-8 text directly; it only needs
+    // converting if some expression has to run.
+    const QVarLengthArray<bool, 256> candidates = this->candidates(subject);
+    QString converted;
+    bool isConverted = false;
+    for (qsizetype i = 0; i < expressions.size(); ++i) {
+        if (!candidates[i])
+            continue;
+        if (!isConverted) {
+            converted = QString::fromUtf8(subject);
+            isConverted = true;
+        }
+        if (expressions.at(i).match(converted).hasMatch() && onMatch(i))
+            return;
+    }
+}
+
+/*!
+    \class QRegularExpressionSet
+    \inmodule QtCore
+    \since 6.4
+    \brief The QRegularExpressionSet class finds which of a set of regular
+    expressions match a string.
+
+    \ingroup tools
+    \ingroup shared
+    \ingroup string-processing
+
+    \keyword regular expression set
+
+    Matching each of many regular expressions against the same string is
+    slow when there are many expressions, even if they are simple. Most
+    expressions, though, can only match strings that contain a certain
+    literal text: for instance, \c{timeout after \d+ ms} needs the text
+    \c{timeout after }. QRegularExpressionSet extracts those literals, and
+    searches for all of them in a single pass over the string with a
+    QMultiStringMatcher. Only the expressions whose literal occurs in the
+    string, plus those without any literal, then actually run.
+
+    \snippet code/src_corelib_text_qregularexpressionset.cpp 0
+
+    Strings can be passed as UTF-16 (QStringView) or UTF-8
+    (QByteArrayView). UTF-8 strings are searched for the literals as they
+    are, and only converted to UTF-16, as by QString::fromUtf8(), if an
+    expression has to run on them.
+
+    The results are the same as running every expression in turn. The more
+    specific the literals in the expressions, the more of them are skipped.
+    Expressions using \l{QRegularExpression::}{ExtendedPatternSyntaxOption},
+    alternatives at the top level, option settings in the pattern (such as
+    \c{(?i)}), or constructs that the literal extraction doesn't
+    understand, always run.
+
+    \sa QRegularExpression, QMultiStringMatcher
+*/
+
+/*!
+    Constructs an empty set of regular expressions, which doesn't match
+    anything.
+*/
+QRegularExpressionSet::QRegularExpressionSet()
+    : d(new QRegularExpressionSetPrivate({}))
+{
+}
+
+/*!
+    Constructs a set of the regular expressions \a expressions.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QList<QRegularExpression> &expressions)
+    : d(new QRegularExpressionSetPrivate(expressions))
+{
+}
+
+/*!
+    Constructs a copy of \a other.
+*/
+QRegularExpressionSet::QRegularExpressionSet(const QRegularExpressionSet &other) = default;
+
+/*!
+    \fn QRegularExpressionSet::QRegularExpressionSet(QRegularExpressionSet &&other)
+
+    Move-constructs a set from \a other.
+
+    \note The moved-from object \a other is placed in a
+    partially-formed state, in which the only valid operations are
+    destruction and assignment of a new value.
+*/
+
+/*!
+    Destroys the set.
+*/
+QRegularExpressionSet::~QRegularExpressionSet() = default;
+
+QT_DEFINE_QESDP_SPECIALIZATION_DTOR(QRegularExpressionSetPrivate)
+
+/*!
+    Assigns \a other to this set and returns a reference to this set.
+*/
+QRegularExpressionSet &QRegularExpressionSet::operator=(const QRegularExpressionSet &other) = default;
+
+/*!
+    \fn QRegularExpressionSet &QRegularExpressionSet::operator=(QRegularExpressionSet &&other)
+
+    Move-assigns \a other to this set and returns a reference to this set.
+*/
+
+/*!
+    \fn void QRegularExpressionSet::swap(QRegularExpressionSet &other)
+
+    Swaps set \a other with this set. This operation is very fast and never
+    fails.
+*/
+
+/*!
+    Sets the regular expressions in this set to \a expressions.
+
+    \sa expressions()
+*/
+void QRegularExpressionSet::setExpressions(const QList<QRegularExpression> &expressions)
+{
+    d = new QRegularExpressionSetPrivate(expressions);
+}
+
+/*!
+    Returns the regular expressions in this set.
+
+    \sa setExpressions()
+*/
+QList<QRegularExpression> QRegularExpressionSet::expressions() const
+{
+    return d->expressions;
+}
+
+/*!
+    Returns \c true if any of the regular expressions matches \a subject, and
+    \c false otherwise.
+
+    \sa matchingExpressions()
+*/
+bool QRegularExpressionSet::matchesAny(QStringView subject) const
+{
+    bool found = false;
+    d->match(subject, [&found](qsizetype) { return found = true; });
+    return found;
+}
+
+/*!
+    \overload
+
+    The \a subject is UTF-8 text.
+*/
+bool QRegularExpressionSet::matchesAny(QByteArrayView subject) const
+{
+    bool found = false;
+    d->match(subject, [&found](qsizetype) { return found = true; });
+    return found;
+}
+
+/*!
+    Returns the indexes in expressions() of all the regular expressions that
+    match \a subject, in increasing order. Invalid expressions never match.
+
+    \sa matchesAny()
+*/
+QList<qsizetype> QRegularExpressionSet::matchingExpressions(QStringView subject) const
+{
+    QList<qsizetype> result;
+    d->match(subject, [&result](qsizetype i) {
+        result.append(i);
+        return false;
+    });
+    return result;
+}
+
+/*!
+    \overload
+
+    The \a subject is UTF-8 text.
+*/
+QList<qsizetype> QRegularExpressionSet::matchingExpressions(QByteArrayView subject) const
+{
+    QList<qsizetype> result;
+    d->match(subject, [&result](qsizetype i) {
+        result.append(i);
+        return false;
+    });
+    return result;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,87 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QREGULAREXPRESSIONSET_H
+#define QREGULAREXPRESSIONSET_H
+
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qglobal.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qregularexpression.h>
+#include <QtCore/qshareddata.h>
+#include <QtCore/qstringview.h>
+
+QT_REQUIRE_CONFIG(regularexpression);
+
+QT_BEGIN_NAMESPACE
+
+class QRegularExpressionSetPrivate;
+QT_DECLARE_QESDP_SPECIALIZATION_DTOR_WITH_EXPORT(QRegularExpressionSetPrivate, Q_CORE_EXPORT)
+
+class Q_CORE_EXPORT QRegularExpressionSet
+{
+public:
+    QRegularExpressionSet();
+    explicit QRegularExpressionSet(const QList<QRegularExpression> &expressions);
+    QRegularExpressionSet(const QRegularExpressionSet &other);
+    QRegularExpressionSet(QRegularExpressionSet &&other) noexcept = default;
+    ~QRegularExpressionSet();
+    QRegularExpressionSet &operator=(const QRegularExpressionSet &other);
+    QT_MOVE_ASSIGNMENT_OPERATOR_IMPL_VIA_PURE_SWAP(QRegularExpressionSet)
+
+    void swap(QRegularExpressionSet &other) noexcept { d.swap(other.d); }
+
+    void setExpressions(const QList<QRegularExpression> &expressions);
+    QList<QRegularExpression> expressions() const;
+
+    bool matchesAny(QStringView subject) const;
+    bool matchesAny(QByteArrayView subject) const;
+    QList<qsizetype> matchingExpressions(QStringView subject) const;
+    QList<qsizetype> matchingExpressions(QByteArrayView subject) const;
+
+private:
+    QExplicitlySharedDataPointer<QRegularExpressionSetPrivate> d;
+};
+
+Q_DECLARE_SHARED(QRegularExpressionSet)
+
+QT_END_NAMESPACE
+
+#endif // QREGULAREXPRESSIONSET_H
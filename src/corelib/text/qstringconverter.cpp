@@ -491,6 +491,314 @@ static void simdCompareAscii(const char8_t *&, const char8_t *, const char16_t *
 }
 #endif
 
+// SIMD transcoding of non-ASCII text. The kernels only ever consume complete,
+// valid sequences of at most three UTF-8 bytes (that is, no surrogate pairs):
+// everything else, including all error handling, is left to the scalar code,
+// so the results are exactly the same.
+#if defined(__SSE2__) && QT_COMPILER_SUPPORTS_HERE(SSSE3) && !defined(QT_BOOTSTRAPPED)
+
+// PSHUFB controls, indexed by a mask, that pack the bytes the mask keeps at
+// the front of the vector (and zero the rest), and how many bytes that is
+struct Utf8ShuffleTable
+{
+    uchar shuffle[256][16];
+    uchar length[256];
+};
+
+// 8 lanes of 16 bits, kept whole if their bit is set
+static constexpr Utf8ShuffleTable makeUtf16CompactTable()
+{
+    Utf8ShuffleTable t = {};
+    for (int mask = 0; mask < 256; ++mask) {
+        int out = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            if (mask & (1 << lane)) {
+                t.shuffle[mask][out++] = uchar(2 * lane);
+                t.shuffle[mask][out++] = uchar(2 * lane + 1);
+            }
+        }
+        t.length[mask] = uchar(out);
+        while (out < 16)
+            t.shuffle[mask][out++] = 0x80;
+    }
+    return t;
+}
+
+// 8 lanes of 2 bytes, the first always kept, the second if the lane's bit is set
+static constexpr Utf8ShuffleTable makeUtf8TwoByteTable()
+{
+    Utf8ShuffleTable t = {};
+    for (int mask = 0; mask < 256; ++mask) {
+        int out = 0;
+        for (int lane = 0; lane < 8; ++lane) {
+            t.shuffle[mask][out++] = uchar(2 * lane);
+            if (mask & (1 << lane))
+                t.shuffle[mask][out++] = uchar(2 * lane + 1);
+        }
+        t.length[mask] = uchar(out);
+        while (out < 16)
+            t.shuffle[mask][out++] = 0x80;
+    }
+    return t;
+}
+
+// 4 lanes of 4 bytes, of which the first 1, 2 or 3 are kept, as given by two
+// bits per lane
+static constexpr Utf8ShuffleTable makeUtf8ThreeByteTable()
+{
+    Utf8ShuffleTable t = {};
+    for (int mask = 0; mask < 256; ++mask) {
+        int out = 0;
+        for (int lane = 0; lane < 4; ++lane) {
+            const int length = (mask >> (2 * lane)) & 3;
+            for (int i = 0; i < length; ++i)
+                t.shuffle[mask][out++] = uchar(4 * lane + i);
+        }
+        t.length[mask] = uchar(out);
+        while (out < 16)
+            t.shuffle[mask][out++] = 0x80;
+    }
+    return t;
+}
+
+static constexpr Utf8ShuffleTable utf16CompactTable = makeUtf16CompactTable();
+static constexpr Utf8ShuffleTable utf8TwoByteTable = makeUtf8TwoByteTable();
+static constexpr Utf8ShuffleTable utf8ThreeByteTable = makeUtf8ThreeByteTable();
+
+static inline __m128i shuffleFromTable(const Utf8ShuffleTable &table, uint mask)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i *>(table.shuffle[mask]));
+}
+
+// Decodes the complete characters in the 16 bytes at src, if all of them are
+// valid and at most three bytes long. Returns the number of bytes consumed,
+// zero if the block must be left to the scalar decoder. Writes up to 16 code
+// units to dst, of which the first dstCount are the result.
+QT_FUNCTION_TARGET(SSSE3)
+static inline int simdDecodeUtf8Block(char16_t *dst, int &dstCount, const uchar *src)
+{
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+
+    // Flip the sign bits so signed comparisons order the bytes as unsigned:
+    // US-ASCII is negative, continuation bytes (0x80-0xBF) are 0 to 63, leading
+    // bytes of two-byte sequences 64 to 95, of three-byte sequences 96 to 111.
+    const __m128i s = _mm_xor_si128(in, _mm_set1_epi8(char(0x80)));
+    const __m128i isLead = _mm_cmpgt_epi8(s, _mm_set1_epi8(63));
+    const uint leadMask = _mm_movemask_epi8(isLead);
+    const uint lead2Mask = _mm_movemask_epi8(_mm_cmpgt_epi8(s, _mm_set1_epi8(65)));
+    const uint lead3Mask = _mm_movemask_epi8(_mm_cmpgt_epi8(s, _mm_set1_epi8(95)));
+
+    // overlong 0xC0 and 0xC1 leading bytes
+    if (leadMask != lead2Mask)
+        return 0;
+
+    auto store = [&](__m128i values1, __m128i values2, uint endMask) QT_FUNCTION_TARGET(SSSE3) {
+        const uint ends1 = endMask & 0xff;
+        const uint ends2 = endMask >> 8;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                         _mm_shuffle_epi8(values1, shuffleFromTable(utf16CompactTable, ends1)));
+        const int count1 = utf16CompactTable.length[ends1] / 2;
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + count1),
+                         _mm_shuffle_epi8(values2, shuffleFromTable(utf16CompactTable, ends2)));
+        dstCount = count1 + utf16CompactTable.length[ends2] / 2;
+    };
+
+    if (!lead3Mask) {
+        // US-ASCII and two-byte sequences only (the common case for Latin,
+        // Greek, Cyrillic, Arabic, Hebrew...): every continuation byte must
+        // follow a leading byte, and every other byte ends a character.
+        const uint continuationMask = _mm_movemask_epi8(in) & ~leadMask;
+        if (continuationMask != ((leadMask << 1) & 0xffff))
+            return 0;
+
+        // A continuation byte holds the low six bits, the leading byte before
+        // it the high five; PMADDUBSW combines each such pair of bytes.
+        const __m128i low = _mm_and_si128(in, _mm_set1_epi8(0x7f));
+        const __m128i high = _mm_and_si128(_mm_and_si128(_mm_slli_si128(in, 1), _mm_set1_epi8(0x1f)),
+                                           _mm_cmpgt_epi8(_mm_setzero_si128(), in));
+        const __m128i weights = _mm_set1_epi16(0x4001);
+        store(_mm_maddubs_epi16(_mm_unpacklo_epi8(low, high), weights),
+              _mm_maddubs_epi16(_mm_unpackhi_epi8(low, high), weights),
+              ~leadMask & 0xffff);
+        // a leading byte in the last position belongs to the next block
+        return 16 - int(leadMask >> 15);
+    }
+
+    // four-byte sequences
+    if (_mm_movemask_epi8(_mm_cmpgt_epi8(s, _mm_set1_epi8(111))))
+        return 0;
+
+    const __m128i isAscii = _mm_cmpgt_epi8(_mm_setzero_si128(), s);
+    const uint asciiMask = _mm_movemask_epi8(isAscii);
+
+    // every continuation byte must be where a leading byte expects one
+    const uint twoByteLeads = lead2Mask & ~lead3Mask;
+    const uint continuationMask = ~(asciiMask | leadMask) & 0xffff;
+    const uint expected = ((twoByteLeads << 1) | (lead3Mask << 1) | (lead3Mask << 2)) & 0xffff;
+    if (continuationMask != expected)
+        return 0;
+
+    // E0 must be followed by A0-BF (else it's overlong) and ED by 80-9F (else
+    // it encodes a surrogate)
+    const __m128i prev1 = _mm_slli_si128(in, 1);
+    const __m128i belowA0 = _mm_cmpgt_epi8(_mm_set1_epi8(0x20), s);
+    const __m128i overlong = _mm_and_si128(_mm_cmpeq_epi8(prev1, _mm_set1_epi8(char(0xe0))), belowA0);
+    const __m128i surrogate = _mm_andnot_si128(belowA0, _mm_cmpeq_epi8(prev1, _mm_set1_epi8(char(0xed))));
+    if (_mm_movemask_epi8(_mm_or_si128(overlong, surrogate)))
+        return 0;
+
+    // leave a character that continues past the block for the next one
+    int consumed = 16;
+    if (lead3Mask & 0x4000)
+        consumed = 14;
+    else if (leadMask & 0x8000)
+        consumed = 15;
+
+    // a character ends at each US-ASCII byte, and at each continuation byte
+    // that doesn't follow a three-byte sequence's leading byte
+    const uint endMask = (asciiMask | (continuationMask & ~(lead3Mask << 1)))
+            & ((1u << consumed) - 1);
+
+    // For continuation bytes: the payload of the byte itself, of the byte
+    // before it and, if that one was a continuation byte too, of the one
+    // before that. US-ASCII bytes are their own value.
+    const __m128i isContinuation = _mm_andnot_si128(_mm_or_si128(isAscii, isLead),
+                                                    _mm_set1_epi8(char(0xff)));
+    const __m128i sixBits = _mm_set1_epi8(0x3f);
+    const __m128i low = _mm_or_si128(_mm_and_si128(isAscii, in),
+                                     _mm_and_si128(isContinuation, _mm_and_si128(in, sixBits)));
+    const __m128i middle = _mm_and_si128(isContinuation, _mm_and_si128(prev1, sixBits));
+    const __m128i high = _mm_and_si128(_mm_and_si128(isContinuation, _mm_slli_si128(isContinuation, 1)),
+                                       _mm_and_si128(_mm_slli_si128(in, 2), _mm_set1_epi8(0x0f)));
+    // move the high nibble to bits 12-15 of the 16-bit value (as it's at most
+    // 0x0f, the shift doesn't cross into the neighbouring byte)
+    const __m128i highShifted = _mm_slli_epi16(high, 4);
+
+    auto combine = [&](__m128i lo16, __m128i mid16) QT_FUNCTION_TARGET(SSSE3) {
+        return _mm_or_si128(lo16, _mm_slli_epi16(mid16, 6));
+    };
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i values1 = combine(_mm_unpacklo_epi8(low, highShifted), _mm_unpacklo_epi8(middle, zero));
+    const __m128i values2 = combine(_mm_unpackhi_epi8(low, highShifted), _mm_unpackhi_epi8(middle, zero));
+
+    store(values1, values2, endMask);
+    return consumed;
+}
+
+// Encodes the 8 code units at src, if none of them is a surrogate. Returns
+// the number of bytes written to dst, at most 24, zero if the block must be
+// left to the scalar encoder. Up to 28 bytes at dst may be overwritten.
+QT_FUNCTION_TARGET(SSSE3)
+static inline int simdEncodeUtf8Block(uchar *dst, const char16_t *src)
+{
+    const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src));
+    const __m128i zero = _mm_setzero_si128();
+
+    const __m128i surrogates = _mm_cmpeq_epi16(_mm_and_si128(in, _mm_set1_epi16(short(0xf800))),
+                                               _mm_set1_epi16(short(0xd800)));
+    if (_mm_movemask_epi8(surrogates))
+        return 0;
+
+    const __m128i isAscii = _mm_cmpeq_epi16(_mm_and_si128(in, _mm_set1_epi16(short(0xff80))), zero);
+    const __m128i upToTwo = _mm_cmpeq_epi16(_mm_and_si128(in, _mm_set1_epi16(short(0xf800))), zero);
+    const uint multiByte = ~_mm_movemask_epi8(_mm_packs_epi16(isAscii, zero)) & 0xff;
+    const uint threeByte = ~_mm_movemask_epi8(_mm_packs_epi16(upToTwo, zero)) & 0xff;
+
+    const __m128i sixBits = _mm_set1_epi16(0x3f);
+    const __m128i continuation = _mm_set1_epi16(0x80);
+    if (!threeByte) {
+        // U+0000 to U+07FF only: one or two bytes per character
+        const __m128i lead = _mm_or_si128(_mm_srli_epi16(in, 6), _mm_set1_epi16(0xc0));
+        const __m128i first = _mm_or_si128(_mm_and_si128(isAscii, in), _mm_andnot_si128(isAscii, lead));
+        const __m128i second = _mm_or_si128(_mm_and_si128(in, sixBits), continuation);
+        const __m128i bytes = _mm_or_si128(first, _mm_slli_epi16(second, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                         _mm_shuffle_epi8(bytes, shuffleFromTable(utf8TwoByteTable, multiByte)));
+        return utf8TwoByteTable.length[multiByte];
+    }
+
+    // Up to three bytes per character, four characters per 32-bit lane
+    auto encodeHalf = [&](__m128i chars, __m128i ascii, __m128i three, uint lengths) QT_FUNCTION_TARGET(SSSE3) {
+        const __m128i sixBits32 = _mm_set1_epi32(0x3f);
+        const __m128i continuation32 = _mm_set1_epi32(0x80);
+        const __m128i lead2 = _mm_or_si128(_mm_srli_epi32(chars, 6), _mm_set1_epi32(0xc0));
+        const __m128i lead3 = _mm_or_si128(_mm_srli_epi32(chars, 12), _mm_set1_epi32(0xe0));
+        const __m128i lead = _mm_or_si128(_mm_and_si128(three, lead3), _mm_andnot_si128(three, lead2));
+        const __m128i first = _mm_or_si128(_mm_and_si128(ascii, chars), _mm_andnot_si128(ascii, lead));
+        const __m128i low = _mm_or_si128(_mm_and_si128(chars, sixBits32), continuation32);
+        const __m128i middle = _mm_or_si128(_mm_and_si128(_mm_srli_epi32(chars, 6), sixBits32),
+                                            continuation32);
+        const __m128i second = _mm_or_si128(_mm_and_si128(three, middle), _mm_andnot_si128(three, low));
+        const __m128i bytes = _mm_or_si128(_mm_or_si128(first, _mm_slli_epi32(second, 8)),
+                                           _mm_slli_epi32(low, 16));
+        return _mm_shuffle_epi8(bytes, shuffleFromTable(utf8ThreeByteTable, lengths));
+    };
+    // two bits per character: 1 plus one for each of the masks it's in
+    auto spread = [](uint bits) {
+        return (bits & 1) | ((bits & 2) << 1) | ((bits & 4) << 2) | ((bits & 8) << 3);
+    };
+    const uint lengths1 = 0x55 + spread(multiByte & 0xf) + spread(threeByte & 0xf);
+    const uint lengths2 = 0x55 + spread(multiByte >> 4) + spread(threeByte >> 4);
+
+    const __m128i three = _mm_xor_si128(upToTwo, _mm_set1_epi16(-1));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst),
+                     encodeHalf(_mm_unpacklo_epi16(in, zero), _mm_unpacklo_epi16(isAscii, isAscii),
+                                _mm_unpacklo_epi16(three, three), lengths1));
+    const int count1 = utf8ThreeByteTable.length[lengths1];
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + count1),
+                     encodeHalf(_mm_unpackhi_epi16(in, zero), _mm_unpackhi_epi16(isAscii, isAscii),
+                                _mm_unpackhi_epi16(three, three), lengths2));
+    return count1 + utf8ThreeByteTable.length[lengths2];
+}
+
+QT_FUNCTION_TARGET(SSSE3)
+static bool simdDecodeUtf8(char16_t *&dst, const uchar *&src, const uchar *end)
+{
+    if (!qCpuHasFeature(SSSE3))
+        return false;
+
+    const uchar *const start = src;
+    while (end - src >= 16) {
+        int count;
+        const int consumed = simdDecodeUtf8Block(dst, count, src);
+        if (!consumed)
+            break;
+        src += consumed;
+        dst += count;
+    }
+    return src != start;
+}
+
+QT_FUNCTION_TARGET(SSSE3)
+static bool simdEncodeUtf8(uchar *&dst, const char16_t *&src, const char16_t *end)
+{
+    if (!qCpuHasFeature(SSSE3))
+        return false;
+
+    // Require twice the block size: the output buffer then has room for the
+    // 28 bytes a block may touch
+    const char16_t *const start = src;
+    while (end - src >= 16) {
+        const int count = simdEncodeUtf8Block(dst, src);
+        if (!count)
+            break;
+        src += 8;
+        dst += count;
+    }
+    return src != start;
+}
+#else
+static bool simdDecodeUtf8(char16_t *&, const uchar *&, const uchar *)
+{
+    return false;
+}
+
+static bool simdEncodeUtf8(uchar *&, const char16_t *&, const char16_t *)
+{
+    return false;
+}
+#endif
+
 enum { HeaderDone = 1 };
 
 QByteArray QUtf8::convertFromUnicode(QStringView in)
@@ -507,6 +815,8 @@ QByteArray QUtf8::convertFromUnicode(QStringView in)
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(dst, nextAscii, src, end))
             break;
+        if (simdEncodeUtf8(dst, src, end))
+            continue;
 
         do {
             char16_t u = *src++;
@@ -574,6 +884,8 @@ char *QUtf8::convertFromUnicode(char *out, QStringView in, QStringConverter::Sta
         const char16_t *nextAscii = end;
         if (simdEncodeAscii(cursor, nextAscii, src, end))
             break;
+        if (simdEncodeUtf8(cursor, src, end))
+            continue;
 
         do {
             char16_t uc = *src++;
@@ -661,6 +973,8 @@ QChar *QUtf8::convertToUnicode(QChar *buffer, QByteArrayView in) noexcept
             nextAscii = end;
             if (simdDecodeAscii(dst, nextAscii, src, end))
                 break;
+            if (simdDecodeUtf8(dst, src, end))
+                continue;
 
             do {
                 uchar b = *src++;
@@ -763,8 +1077,14 @@ QChar *QUtf8::convertToUnicode(QChar *out, QByteArrayView in, QStringConverter::
     res = 0;
     const uchar *nextAscii = src;
     while (res >= 0 && src < end) {
-        if (src >= nextAscii && simdDecodeAscii(dst, nextAscii, src, end))
-            break;
+        if (src >= nextAscii) {
+            if (simdDecodeAscii(dst, nextAscii, src, end))
+                break;
+            if (simdDecodeUtf8(dst, src, end)) {
+                nextAscii = src;
+                continue;
+            }
+        }
 
         ch = *src++;
         res = QUtf8Functions::fromUtf8<QUtf8BaseTraits>(ch, dst, src, end);
@@ -0,0 +1,360 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#ifndef QSTRINGFORMAT_H
+#define QSTRINGFORMAT_H
+
+#include <QtCore/qlocale.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringbuilder.h>
+#include <QtCore/qstringview.h>
+
+#include <array>
+#include <type_traits>
+#include <utility>
+
+#if 0
+// syncqt can not handle this header
+#pragma qt_class(QStringFormat)
+#pragma qt_sync_stop_processing
+#endif
+
+QT_BEGIN_NAMESPACE
+
+namespace QtPrivate {
+
+enum class QFormatError {
+    NoError,
+    InvalidPlaceholder,
+    MissingPlaceholder,
+    MixedLocalization
+};
+
+struct QFormatSegment
+{
+    qsizetype offset = 0;       // literal text only
+    qsizetype length = 0;       // literal text only
+    int argument = -1;          // zero-based, or -1 for literal text
+};
+
+template <qsizetype N>
+struct QParsedFormat
+{
+    static constexpr int MaxArguments = 99;
+
+    // a format of N characters has at most N + 1 segments
+    QFormatSegment segments[N + 1] = {};
+    bool localized[MaxArguments] = {};
+    qsizetype segmentCount = 0;
+    qsizetype literalSize = 0;
+    int argumentCount = 0;
+    QFormatError error = QFormatError::NoError;
+
+    constexpr void addLiteral(qsizetype from, qsizetype to) noexcept
+    {
+        if (from == to)
+            return;
+        segments[segmentCount].offset = from;
+        segments[segmentCount].length = to - from;
+        ++segmentCount;
+        literalSize += to - from;
+    }
+};
+
+constexpr bool qIsFormatDigit(char16_t c) noexcept
+{
+    return c >= u'0' && c <= u'9';
+}
+
+// Same syntax as QString::arg(): %n or %Ln, with n from 1 to 99. A percent
+// sign not followed by a placeholder number is copied literally.
+template <qsizetype N>
+constexpr QParsedFormat<N> qParseFormat(const char16_t *format) noexcept
+{
+    QParsedFormat<N> result;
+    bool plain[QParsedFormat<N>::MaxArguments] = {};
+    bool localized[QParsedFormat<N>::MaxArguments] = {};
+
+    qsizetype literalStart = 0;
+    qsizetype i = 0;
+    while (i < N) {
+        if (format[i] != u'%') {
+            ++i;
+            continue;
+        }
+        qsizetype j = i + 1;
+        const bool isLocalized = j < N && format[j] == u'L';
+        if (isLocalized)
+            ++j;
+        if (j == N || !qIsFormatDigit(format[j])) {
+            ++i;
+            continue;
+        }
+        int number = format[j++] - u'0';
+        if (j < N && qIsFormatDigit(format[j]))
+            number = number * 10 + (format[j++] - u'0');
+        if (number == 0) {
+            result.error = QFormatError::InvalidPlaceholder;
+            return result;
+        }
+
+        result.addLiteral(literalStart, i);
+        result.segments[result.segmentCount++].argument = number - 1;
+        (isLocalized ? localized : plain)[number - 1] = true;
+        if (number > result.argumentCount)
+            result.argumentCount = number;
+        i = literalStart = j;
+    }
+    result.addLiteral(literalStart, N);
+
+    for (int n = 0; n < result.argumentCount; ++n) {
+        if (!plain[n] && !localized[n])
+            result.error = QFormatError::MissingPlaceholder;
+        else if (plain[n] && localized[n])
+            result.error = QFormatError::MixedLocalization;
+        result.localized[n] = localized[n];
+    }
+    return result;
+}
+
+// One formatted argument. Strings are referenced, not copied, so, like
+// QStringBuilder expressions, a formatted string must be converted before
+// its arguments go out of scope.
+class QFormatArgument : private QAbstractConcatenable
+{
+public:
+    QFormatArgument(QStringView s, bool) noexcept
+        : kind(Utf16), length(s.size()), utf16(s.data()) {}
+    QFormatArgument(const QString &s, bool) noexcept
+        : QFormatArgument(QStringView(s), false) {}
+    QFormatArgument(QLatin1StringView s, bool) noexcept
+        : kind(Latin1), length(s.size()), latin1(s.data()) {}
+    QFormatArgument(QChar c, bool) noexcept
+        : kind(Char), length(1), ch(c.unicode()) {}
+    QFormatArgument(char16_t c, bool) noexcept
+        : kind(Char), length(1), ch(c) {}
+    QFormatArgument(QLatin1Char c, bool) noexcept
+        : kind(Char), length(1), ch(c.unicode()) {}
+
+    template <typename T,
+              std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>
+                               && !std::is_same_v<T, char> && !std::is_same_v<T, char16_t>
+                               && !std::is_same_v<T, char32_t> && !std::is_same_v<T, wchar_t>,
+                               bool> = true>
+    QFormatArgument(T value, bool isLocalized)
+    {
+        if (isLocalized) {
+            setText(std::is_signed_v<T> ? QLocale().toString(qlonglong(value))
+                                        : QLocale().toString(qulonglong(value)));
+            return;
+        }
+        using U = std::make_unsigned_t<T>;
+        U magnitude = value < 0 ? U(U(0) - U(value)) : U(value);
+        char *end = digits + sizeof(digits);
+        char *p = end;
+        do {
+            *--p = char('0' + magnitude % 10);
+            magnitude /= 10;
+        } while (magnitude);
+        if (value < 0)
+            *--p = '-';
+        kind = Digits;
+        length = end - p;
+        latin1 = p;
+    }
+
+    template <typename T, std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
+    QFormatArgument(T value, bool isLocalized)
+    {
+        setText(isLocalized ? QLocale().toString(double(value)) : QString::number(double(value)));
+    }
+
+    QFormatArgument(const QFormatArgument &) = delete;
+    QFormatArgument &operator=(const QFormatArgument &) = delete;
+
+    qsizetype size() const noexcept { return length; }
+
+    void appendTo(QChar *&out) const noexcept
+    {
+        switch (kind) {
+        case Utf16:
+            if (length)
+                memcpy(static_cast<void *>(out), utf16, length * sizeof(QChar));
+            break;
+        case Text:
+            if (length)
+                memcpy(static_cast<void *>(out), text.constData(), length * sizeof(QChar));
+            break;
+        case Latin1:
+            appendLatin1To(QLatin1StringView(latin1, length), out);
+            break;
+        case Digits:
+            for (qsizetype i = 0; i < length; ++i)
+                out[i] = QLatin1Char(latin1[i]);
+            break;
+        case Char:
+            *out = QChar(ch);
+            break;
+        }
+        out += length;
+    }
+
+private:
+    void setText(QString &&s) noexcept
+    {
+        kind = Text;
+        length = s.size();
+        text = std::move(s);
+    }
+
+    enum Kind : quint8 { Utf16, Latin1, Digits, Char, Text };
+
+    Kind kind = Utf16;
+    qsizetype length = 0;
+    union {
+        const QChar *utf16;
+        const char *latin1;
+        char16_t ch;
+    };
+    char digits[24];        // enough for any 64-bit integer
+    QString text;           // floating-point and localized numbers
+};
+
+template <typename Format, int Count>
+class QFormattedString
+{
+public:
+    template <typename... Args>
+    explicit QFormattedString(const Args &...args)
+        : QFormattedString(std::make_index_sequence<Count>(), args...)
+    {}
+
+    qsizetype size() const noexcept
+    {
+        qsizetype result = Format::parsed.literalSize;
+        for (qsizetype i = 0; i < Format::parsed.segmentCount; ++i) {
+            const int argument = Format::parsed.segments[i].argument;
+            if (argument >= 0)
+                result += arguments[argument].size();
+        }
+        return result;
+    }
+
+    void appendTo(QChar *&out) const noexcept
+    {
+        const char16_t *format = Format::String::data();
+        for (qsizetype i = 0; i < Format::parsed.segmentCount; ++i) {
+            const QFormatSegment &segment = Format::parsed.segments[i];
+            if (segment.argument >= 0) {
+                arguments[segment.argument].appendTo(out);
+            } else {
+                memcpy(static_cast<void *>(out), format + segment.offset, segment.length * sizeof(QChar));
+                out += segment.length;
+            }
+        }
+    }
+
+    QString toString() const
+    {
+        QString result(size(), Qt::Uninitialized);
+        QChar *out = result.data();
+        appendTo(out);
+        return result;
+    }
+
+    operator QString() const { return toString(); }
+
+private:
+    template <std::size_t... Is, typename... Args>
+    QFormattedString(std::index_sequence<Is...>, const Args &...args)
+        : arguments{ { QFormatArgument(args, Format::parsed.localized[Is])... } }
+    {}
+
+    std::array<QFormatArgument, Count> arguments;
+};
+
+template <typename S>
+class QStringFormat
+{
+public:
+    using String = S;
+    static constexpr auto parsed = qParseFormat<S::size()>(S::data());
+
+    static_assert(parsed.error != QFormatError::InvalidPlaceholder,
+                  "qFormat: placeholders are numbered from %1 to %99");
+    static_assert(parsed.error != QFormatError::MissingPlaceholder,
+                  "qFormat: placeholders must be numbered without gaps");
+    static_assert(parsed.error != QFormatError::MixedLocalization,
+                  "qFormat: an argument can not be used with both %n and %Ln");
+
+    template <typename... Args>
+    QFormattedString<QStringFormat, sizeof...(Args)> arg(const Args &...args) const
+    {
+        static_assert(sizeof...(Args) == parsed.argumentCount,
+                      "qFormat: the number of arguments must match the highest placeholder number");
+        return QFormattedString<QStringFormat, sizeof...(Args)>(args...);
+    }
+};
+
+} // namespace QtPrivate
+
+template <typename Format, int Count>
+struct QConcatenable<QtPrivate::QFormattedString<Format, Count>>
+{
+    typedef QtPrivate::QFormattedString<Format, Count> type;
+    typedef QString ConvertTo;
+    enum { ExactSize = true };
+    static qsizetype size(const type &f) noexcept { return f.size(); }
+    static inline void appendTo(const type &f, QChar *&out) noexcept { f.appendTo(out); }
+};
+
+#define qFormat(format) \
+    ([]() noexcept { \
+        struct QtFormatString { \
+            static constexpr const char16_t *data() noexcept { return u"" format; } \
+            static constexpr qsizetype size() noexcept \
+            { return qsizetype(sizeof(u"" format) / sizeof(char16_t)) - 1; } \
+        }; \
+        return QtPrivate::QStringFormat<QtFormatString>(); \
+    }())
+
+QT_END_NAMESPACE
+
+#endif // QSTRINGFORMAT_H
@@ -127,6 +127,97 @@ public:
         }
     }
 
+#if QT_CONFIG(thread)
+    // Queued meta-calls are posted without taking the mutex: they are stored
+    // in a bounded lock-free queue (multiple producers, the mutex holder as
+    // the only consumer) and moved into the sorted list by the next thread
+    // that locks the mutex, see takeIncomingEvents(). When the queue is full,
+    // posters fall back to locking the mutex.
+    struct IncomingQueue
+    {
+        static constexpr quint32 Size = 512;
+        struct Cell
+        {
+            // == position: free; == position + 1: holds the event
+            QAtomicInteger<quint32> sequence;
+            QPostEvent event;
+        };
+        Cell cells[Size];
+        QAtomicInteger<quint32> tail;
+        quint32 head = 0;
+
+        IncomingQueue()
+        {
+            for (quint32 i = 0; i < Size; ++i)
+                cells[i].sequence.storeRelaxed(i);
+        }
+
+        bool push(const QPostEvent &ev)
+        {
+            quint32 pos = tail.loadRelaxed();
+            Cell *cell;
+            for (;;) {
+                cell = &cells[pos % Size];
+                const qint32 diff = qint32(cell->sequence.loadAcquire() - pos);
+                if (diff == 0) {
+                    if (tail.testAndSetRelaxed(pos, pos + 1, pos))
+                        break;
+                } else if (diff < 0) {
+                    return false; // full
+                } else {
+                    pos = tail.loadRelaxed();
+                }
+            }
+            cell->event = ev;
+            cell->sequence.storeRelease(pos + 1);
+            return true;
+        }
+
+        // passes all events pushed so far to f, waiting for those that are
+        // still being written
+        template <typename F> void drain(F f)
+        {
+            const quint32 end = tail.loadAcquire();
+            for (; head != end; ++head) {
+                Cell &cell = cells[head % Size];
+                while (cell.sequence.loadAcquire() != head + 1)
+                    QThread::yieldCurrentThread();
+                f(cell.event);
+                cell.sequence.storeRelease(head + Size);
+            }
+        }
+    };
+    QAtomicPointer<IncomingQueue> incoming;
+    // number of threads that are about to push onto incoming, plus
+    // PushersBlocked while QObject::moveToThread() waits for them
+    QAtomicInt incomingPushers;
+    static constexpr int PushersBlocked = 1 << 30;
+
+    ~QPostEventList() { delete incoming.loadRelaxed(); }
+
+    bool hasIncomingEvents() const
+    {
+        const IncomingQueue *queue = incoming.loadAcquire();
+        return queue && queue->head != queue->tail.loadRelaxed();
+    }
+
+    // mutex must be locked
+    template <typename F> void takeIncomingEvents(F f)
+    {
+        if (IncomingQueue *queue = incoming.loadAcquire())
+            queue->drain(f);
+    }
+
+    // mutex must be locked
+    void takeIncomingEvents()
+    {
+        takeIncomingEvents([this](const QPostEvent &ev) { addEvent(ev); });
+    }
+#else
+    bool hasIncomingEvents() const { return false; }
+    void takeIncomingEvents() { }
+#endif
+
 private:
     //hides because they do not keep that list sorted. addEvent must be used
     using QList<QPostEvent>::append;
@@ -294,7 +385,7 @@ public:
     bool canWaitLocked()
     {
         QMutexLocker locker(&postEventList.mutex);
-        return canWait;
+        return canWait && !postEventList.hasIncomingEvents();
     }
 
     // This class provides per-thread (by way of being a QThreadData
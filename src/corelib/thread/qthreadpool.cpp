@@ -63,6 +63,11 @@ public:
     QWaitCondition runnableReady;
     QThreadPoolPrivate *manager;
     QRunnable *runnable;
+
+    // work-stealing mode only: tasks started from this thread, owner pops
+    // from the back, other threads steal from the front
+    QMutex localQueueMutex;
+    QList<QRunnable *> localQueue;
 };
 
 /*
@@ -95,7 +100,8 @@ void QThreadPoolThread::run()
                 const bool del = r->autoDelete();
 
                 // run the task
-                locker.unlock();
+                if (locker.isLocked())
+                    locker.unlock();
 #ifndef QT_NO_EXCEPTIONS
                 try {
 #endif
@@ -112,12 +118,29 @@ void QThreadPoolThread::run()
 
                 if (del)
                     delete r;
+
+                // tasks this thread started itself don't need the pool's
+                // mutex, unless it must check the thread limit
+                if (manager->workStealing && !manager->mayBeOverThreadLimit.loadRelaxed()
+                        && (r = manager->takeLocalTask(this))) {
+                    continue;
+                }
                 locker.relock();
             }
 
             // if too many threads are active, stop working in this one
             if (manager->tooManyThreadsActive())
                 break;
+            if (manager->workStealing)
+                manager->mayBeOverThreadLimit.storeRelaxed(0);
+
+            // local and stolen tasks have the default priority, so they run
+            // before queued tasks with a lower one
+            if (manager->workStealing
+                    && (manager->queue.isEmpty() || manager->queue.constFirst()->priority() < 0)
+                    && ((r = manager->takeLocalTask(this, true)) || (r = manager->stealTask(this)))) {
+                continue;
+            }
 
             // all work is done, time to wait for more
             if (manager->queue.isEmpty())
@@ -130,8 +153,25 @@ void QThreadPoolThread::run()
                 manager->queue.removeFirst();
                 delete page;
             }
+            manager->updateQueuedPriorityHint();
         } while (true);
 
+        if (manager->workStealing) {
+            if (manager->tooManyThreadsActive()) {
+                // hand the local tasks over to the threads that keep running
+                manager->requeueLocalTasks(this);
+            } else {
+                // Announce that this thread is going idle before looking for
+                // work one last time: a thread adding a task to its local
+                // queue after that will see it, and wake this one up.
+                manager->mayHaveIdleThreads.storeRelaxed(1);
+                if ((runnable = manager->takeLocalTask(this, true))
+                        || (runnable = manager->stealTask(this))) {
+                    continue;
+                }
+            }
+        }
+
         // this thread is about to be deleted, do not wait or expire
         if (!manager->allThreads.contains(this)) {
             registerThreadInactive();
@@ -163,6 +203,7 @@ void QThreadPoolThread::run()
 
 void QThreadPoolThread::registerThreadInactive()
 {
+    manager->mayHaveIdleThreads.storeRelaxed(1);
     if (--manager->activeThreads == 0)
         manager->noActiveThreads.wakeAll();
 }
@@ -172,6 +213,7 @@ void QThreadPoolThread::registerThreadInactive()
     \internal
 */
 QThreadPoolPrivate:: QThreadPoolPrivate()
+    : workStealing(qEnvironmentVariableIntValue("QT_THREADPOOL_WORK_STEALING") > 0)
 { }
 
 bool QThreadPoolPrivate::tryStart(QRunnable *task)
@@ -196,18 +238,7 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
 
     if (!expiredThreads.isEmpty()) {
         // restart an expired thread
-        QThreadPoolThread *thread = expiredThreads.dequeue();
-        Q_ASSERT(thread->runnable == nullptr);
-
-        ++activeThreads;
-
-        thread->runnable = task;
-
-        // Ensure that the thread has actually finished, otherwise the following
-        // start() has no effect.
-        thread->wait();
-        Q_ASSERT(thread->isFinished());
-        thread->start(threadPriority);
+        restartExpiredThread(task);
         return true;
     }
 
@@ -216,6 +247,22 @@ bool QThreadPoolPrivate::tryStart(QRunnable *task)
     return true;
 }
 
+void QThreadPoolPrivate::restartExpiredThread(QRunnable *runnable)
+{
+    QThreadPoolThread *thread = expiredThreads.dequeue();
+    Q_ASSERT(thread->runnable == nullptr);
+
+    ++activeThreads;
+
+    thread->runnable = runnable;
+
+    // Ensure that the thread has actually finished, otherwise the following
+    // start() has no effect.
+    thread->wait();
+    Q_ASSERT(thread->isFinished());
+    thread->start(threadPriority);
+}
+
 inline bool comparePriority(int priority, const QueuePage *p)
 {
     return p->priority() < priority;
@@ -232,6 +279,125 @@ void QThreadPoolPrivate::enqueueTask(QRunnable *runnable, int priority)
     }
     auto it = std::upper_bound(queue.constBegin(), queue.constEnd(), priority, comparePriority);
     queue.insert(std::distance(queue.constBegin(), it), new QueuePage(runnable, priority));
+    updateQueuedPriorityHint();
+}
+
+void QThreadPoolPrivate::updateQueuedPriorityHint()
+{
+    queuedPriorityHint.storeRelaxed(queue.isEmpty() ? INT_MIN : queue.constFirst()->priority());
+}
+
+/*
+    Work-stealing mode, enabled by setting QT_THREADPOOL_WORK_STEALING=1 in
+    the environment when the pool is created: a task started from one of the
+    pool's own threads with the default priority goes into that thread's local
+    queue instead of the pool's queue, so that forking work from inside a pool
+    thread doesn't contend on the pool's mutex. Threads without work steal
+    from the other threads' local queues. A thread does not become inactive
+    before its local queue is empty, so waitForDone() works unchanged; a
+    thread that stops because too many threads are active moves its local
+    tasks to the pool's queue first.
+
+    The pool's mutex is only taken to wake up another thread, which is
+    skipped while all threads are known to be active.
+*/
+QThreadPoolThread *QThreadPoolPrivate::currentPoolThread() const
+{
+    auto thread = qobject_cast<QThreadPoolThread *>(QThread::currentThread());
+    return thread && thread->manager == this ? thread : nullptr;
+}
+
+bool QThreadPoolPrivate::tryEnqueueLocalTask(QRunnable *task)
+{
+    Q_ASSERT(workStealing);
+    QThreadPoolThread *thread = currentPoolThread();
+    if (!thread)
+        return false;
+
+    {
+        QMutexLocker locker(&thread->localQueueMutex);
+        thread->localQueue.append(task);
+    }
+
+    // A thread going idle sets the flag before its last look at the local
+    // queues, which takes the mutex of this one: if it missed the task, we
+    // see the flag.
+    if (mayHaveIdleThreads.loadRelaxed()) {
+        QMutexLocker locker(&mutex);
+        if (!areAllThreadsActive())
+            startThreadForStealing();
+        else
+            mayHaveIdleThreads.storeRelaxed(0);
+    }
+    return true;
+}
+
+/*
+    tryStart() from a pool thread: the task goes to the thread's local queue
+    if another thread can be woken up for it, and fails without taking the
+    pool's mutex if all threads are known to be active. This is what
+    QtConcurrent's thread engines do to start more workers.
+*/
+bool QThreadPoolPrivate::tryStartLocalTask(QRunnable *task)
+{
+    Q_ASSERT(workStealing);
+    QThreadPoolThread *thread = currentPoolThread();
+    Q_ASSERT(thread);
+    if (!mayHaveIdleThreads.loadRelaxed())
+        return false;
+
+    QMutexLocker locker(&mutex);
+    if (areAllThreadsActive()) {
+        mayHaveIdleThreads.storeRelaxed(0);
+        return false;
+    }
+    {
+        QMutexLocker localLocker(&thread->localQueueMutex);
+        thread->localQueue.append(task);
+    }
+    startThreadForStealing();
+    return true;
+}
+
+// called with mutex locked
+void QThreadPoolPrivate::requeueLocalTasks(QThreadPoolThread *thread)
+{
+    QMutexLocker locker(&thread->localQueueMutex);
+    for (QRunnable *task : std::as_const(thread->localQueue))
+        enqueueTask(task);
+    thread->localQueue.clear();
+}
+
+QRunnable *QThreadPoolPrivate::takeLocalTask(QThreadPoolThread *thread, bool ignoreQueuedPriority)
+{
+    // queued tasks with a higher priority must run first
+    if (!ignoreQueuedPriority && queuedPriorityHint.loadRelaxed() > 0)
+        return nullptr;
+
+    QMutexLocker locker(&thread->localQueueMutex);
+    return thread->localQueue.isEmpty() ? nullptr : thread->localQueue.takeLast();
+}
+
+QRunnable *QThreadPoolPrivate::stealTask(QThreadPoolThread *thief)
+{
+    for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+        if (thread == thief)
+            continue;
+        QMutexLocker locker(&thread->localQueueMutex);
+        if (!thread->localQueue.isEmpty())
+            return thread->localQueue.takeFirst();
+    }
+    return nullptr;
+}
+
+void QThreadPoolPrivate::startThreadForStealing()
+{
+    if (!waitingThreads.isEmpty())
+        waitingThreads.takeFirst()->runnableReady.wakeOne();
+    else if (!expiredThreads.isEmpty())
+        restartExpiredThread(nullptr);
+    else
+        startThread();
 }
 
 int QThreadPoolPrivate::activeThreadCount() const
@@ -257,6 +423,7 @@ void QThreadPoolPrivate::tryToStartMoreThreads()
             delete page;
         }
     }
+    updateQueuedPriorityHint();
 }
 
 bool QThreadPoolPrivate::areAllThreadsActive() const
@@ -276,7 +443,7 @@ bool QThreadPoolPrivate::tooManyThreadsActive() const
 */
 void QThreadPoolPrivate::startThread(QRunnable *runnable)
 {
-    Q_ASSERT(runnable != nullptr);
+    Q_ASSERT(runnable != nullptr || workStealing);
     auto thread = std::make_unique<QThreadPoolThread>(this);
     if (objectName.isEmpty())
         objectName = u"Thread (pooled)"_s;
@@ -357,6 +524,20 @@ void QThreadPoolPrivate::clear()
         }
         delete page;
     }
+    updateQueuedPriorityHint();
+
+    if (workStealing) {
+        QList<QRunnable *> localTasks;
+        for (QThreadPoolThread *thread : qAsConst(allThreads)) {
+            QMutexLocker localLocker(&thread->localQueueMutex);
+            localTasks += std::exchange(thread->localQueue, {});
+        }
+        locker.unlock();
+        for (QRunnable *r : qAsConst(localTasks)) {
+            if (r->autoDelete())
+                delete r;
+        }
+    }
 }
 
 /*!
@@ -390,10 +571,19 @@ bool QThreadPool::tryTake(QRunnable *runnable)
                 d->queue.removeOne(page);
                 delete page;
             }
+            d->updateQueuedPriorityHint();
             return true;
         }
     }
 
+    if (d->workStealing) {
+        for (QThreadPoolThread *thread : qAsConst(d->allThreads)) {
+            QMutexLocker localLocker(&thread->localQueueMutex);
+            if (thread->localQueue.removeOne(runnable))
+                return true;
+        }
+    }
+
     return false;
 }
 
@@ -464,6 +654,14 @@ void QThreadPoolPrivate::stealAndRunRunnable(QRunnable *runnable)
     implementing time-consuming operations that are not visible to the
     QThreadPool.
 
+    Setting the environment variable \c QT_THREADPOOL_WORK_STEALING to 1
+    before a QThreadPool is created makes it use work stealing: runnables
+    that a thread of the pool starts with the default priority are queued on
+    that thread, and idle threads take over queued runnables from busy ones.
+    This reduces contention when many small runnables are started from within
+    the pool, such as when work is split up recursively. Runnables with a
+    different priority are still run in priority order.
+
     Note that QThreadPool is a low-level class for managing threads, see
     the Qt Concurrent module for higher level alternatives.
 
@@ -531,6 +729,9 @@ void QThreadPool::start(QRunnable *runnable, int priority)
         return;
 
     Q_D(QThreadPool);
+    if (d->workStealing && priority == 0 && d->tryEnqueueLocalTask(runnable))
+        return;
+
     QMutexLocker locker(&d->mutex);
 
     if (!d->tryStart(runnable))
@@ -575,6 +776,9 @@ bool QThreadPool::tryStart(QRunnable *runnable)
         return false;
 
     Q_D(QThreadPool);
+    if (d->workStealing && d->currentPoolThread())
+        return d->tryStartLocalTask(runnable);
+
     QMutexLocker locker(&d->mutex);
     if (d->tryStart(runnable))
         return true;
@@ -597,6 +801,14 @@ bool QThreadPool::tryStart(std::function<void()> functionToRun)
         return false;
 
     Q_D(QThreadPool);
+    if (d->workStealing && d->currentPoolThread()) {
+        QRunnable *runnable = QRunnable::create(std::move(functionToRun));
+        if (d->tryStartLocalTask(runnable))
+            return true;
+        delete runnable;
+        return false;
+    }
+
     QMutexLocker locker(&d->mutex);
     if (!d->allThreads.isEmpty() && d->areAllThreadsActive())
         return false;
@@ -664,6 +876,8 @@ void QThreadPool::setMaxThreadCount(int maxThreadCount)
         return;
 
     d->requestedMaxThreadCount = maxThreadCount;
+    d->mayHaveIdleThreads.storeRelaxed(1);
+    d->mayBeOverThreadLimit.storeRelaxed(1);
     d->tryToStartMoreThreads();
 }
 
@@ -704,6 +918,7 @@ void QThreadPool::reserveThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     ++d->reservedThreads;
+    d->mayBeOverThreadLimit.storeRelaxed(1);
 }
 
 /*! \property QThreadPool::stackSize
@@ -773,6 +988,7 @@ void QThreadPool::releaseThread()
     Q_D(QThreadPool);
     QMutexLocker locker(&d->mutex);
     --d->reservedThreads;
+    d->mayHaveIdleThreads.storeRelaxed(1);
     d->tryToStartMoreThreads();
 }
 
@@ -169,6 +169,16 @@ public:
     void clear();
     void stealAndRunRunnable(QRunnable *runnable);
     void deletePageIfFinished(QueuePage *page);
+    void updateQueuedPriorityHint();
+
+    QThreadPoolThread *currentPoolThread() const;
+    bool tryEnqueueLocalTask(QRunnable *task);
+    bool tryStartLocalTask(QRunnable *task);
+    void requeueLocalTasks(QThreadPoolThread *thread);
+    QRunnable *takeLocalTask(QThreadPoolThread *thread, bool ignoreQueuedPriority = false);
+    QRunnable *stealTask(QThreadPoolThread *thief);
+    void startThreadForStealing();
+    void restartExpiredThread(QRunnable *runnable);
 
     mutable QMutex mutex;
     QSet<QThreadPoolThread *> allThreads;
@@ -184,6 +194,18 @@ public:
     int activeThreads = 0;
     uint stackSize = 0;
     QThread::Priority threadPriority = QThread::InheritPriority;
+
+    // priority of the first task in queue, readable without holding mutex
+    QAtomicInt queuedPriorityHint = INT_MIN;
+    // Work-stealing mode only, readable without holding mutex. Cleared when
+    // all threads were found active; set whenever a thread may have become
+    // available again.
+    QAtomicInt mayHaveIdleThreads = 1;
+    // Work-stealing mode only, readable without holding mutex. Set when the
+    // thread limit may have been lowered below the number of active threads;
+    // then threads check it before running their next local task.
+    QAtomicInt mayBeOverThreadLimit = 0;
+    const bool workStealing;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,234 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the QtCore module of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:LGPL$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU Lesser General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU Lesser
+** General Public License version 3 as published by the Free Software
+** Foundation and appearing in the file LICENSE.LGPL3 included in the
+** packaging of this file. Please review the following information to
+** ensure the GNU Lesser General Public License version 3 requirements
+** will be met: https://www.gnu.org/licenses/lgpl-3.0.html.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 2.0 or (at your option) the GNU General
+** Public license version 3 or any later version approved by the KDE Free
+** Qt Foundation. The licenses are as published by the Free Software
+** Foundation and appearing in the file LICENSE.GPL2 and LICENSE.GPL3
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-2.0.html and
+** https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#ifndef QCONCURRENTCACHE_H
+#define QCONCURRENTCACHE_H
+
+#include <QtCore/qcache.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qsharedpointer.h>
+
+#include <memory>
+
+QT_BEGIN_NAMESPACE
+
+template <class Key, class T>
+class QConcurrentCache
+{
+    // Each shard is a QCache of its own, guarded by its own mutex, and owns a
+    // share of the maximum cost. The cached objects are held through shared
+    // pointers, so that an object handed out by object() stays alive when
+    // another thread evicts it. Shards are cache line aligned, so that
+    // threads working on different shards don't contend on their mutexes.
+    struct alignas(64) Shard
+    {
+        mutable QMutex mutex;
+        QCache<Key, QSharedPointer<T>> cache;
+        quint64 hits = 0;
+        quint64 misses = 0;
+        quint64 evictions = 0;
+    };
+
+    std::unique_ptr<Shard[]> shards;
+    qsizetype nShards;
+    qsizetype mx;
+
+    Shard &shardFor(const Key &key) const noexcept
+    {
+        // The shards' QCaches pick their buckets from the low bits of the
+        // key's hash; mix it once more so that the keys of a shard still
+        // spread over all of its buckets.
+        const size_t hash = QHashPrivate::hash(QHashPrivate::calculateHash(key), 0);
+        return shards[hash & size_t(nShards - 1)];
+    }
+    qsizetype shardMaxCost(qsizetype i) const noexcept
+    {
+        return mx / nShards + (i < mx % nShards ? 1 : 0);
+    }
+
+    Q_DISABLE_COPY(QConcurrentCache)
+
+public:
+    explicit QConcurrentCache(qsizetype maxCost = 100, qsizetype shardCount = 16)
+        : nShards(qsizetype(qNextPowerOfTwo(quint64(qMax(shardCount, qsizetype(1)) - 1)))),
+          mx(maxCost)
+    {
+        shards.reset(new Shard[nShards]);
+        for (qsizetype i = 0; i < nShards; ++i)
+            shards[i].cache.setMaxCost(shardMaxCost(i));
+    }
+
+    qsizetype maxCost() const noexcept { return mx; }
+    void setMaxCost(qsizetype m)
+    {
+        mx = m;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            Shard &s = shards[i];
+            QMutexLocker locker(&s.mutex);
+            const qsizetype before = s.cache.size();
+            s.cache.setMaxCost(shardMaxCost(i));
+            s.evictions += before - s.cache.size();
+        }
+    }
+    qsizetype shardCount() const noexcept { return nShards; }
+
+    qsizetype totalCost() const
+    {
+        qsizetype total = 0;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            total += shards[i].cache.totalCost();
+        }
+        return total;
+    }
+    qsizetype size() const
+    {
+        qsizetype n = 0;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            n += shards[i].cache.size();
+        }
+        return n;
+    }
+    qsizetype count() const { return size(); }
+    bool isEmpty() const { return size() == 0; }
+    QList<Key> keys() const
+    {
+        QList<Key> k;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            k += shards[i].cache.keys();
+        }
+        return k;
+    }
+
+    void clear()
+    {
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            shards[i].cache.clear();
+        }
+    }
+
+    bool insert(const Key &key, T *object, qsizetype cost = 1)
+    {
+        auto holder = new QSharedPointer<T>(object);
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        const qsizetype before = s.cache.size() + (s.cache.contains(key) ? 0 : 1);
+        if (!s.cache.insert(key, holder, cost))
+            return false;
+        s.evictions += before - s.cache.size();
+        return true;
+    }
+    QSharedPointer<T> object(const Key &key) const
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        if (QSharedPointer<T> *holder = s.cache.object(key)) {
+            ++s.hits;
+            return *holder;
+        }
+        ++s.misses;
+        return QSharedPointer<T>();
+    }
+    QSharedPointer<T> operator[](const Key &key) const
+    {
+        return object(key);
+    }
+    bool contains(const Key &key) const
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        return s.cache.contains(key);
+    }
+
+    bool remove(const Key &key)
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        return s.cache.remove(key);
+    }
+    QSharedPointer<T> take(const Key &key)
+    {
+        Shard &s = shardFor(key);
+        QMutexLocker locker(&s.mutex);
+        const std::unique_ptr<QSharedPointer<T>> holder(s.cache.take(key));
+        return holder ? *holder : QSharedPointer<T>();
+    }
+
+    quint64 hitCount() const
+    {
+        quint64 n = 0;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            n += shards[i].hits;
+        }
+        return n;
+    }
+    quint64 missCount() const
+    {
+        quint64 n = 0;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            n += shards[i].misses;
+        }
+        return n;
+    }
+    quint64 evictionCount() const
+    {
+        quint64 n = 0;
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            n += shards[i].evictions;
+        }
+        return n;
+    }
+    void resetStatistics()
+    {
+        for (qsizetype i = 0; i < nShards; ++i) {
+            QMutexLocker locker(&shards[i].mutex);
+            shards[i].hits = shards[i].misses = shards[i].evictions = 0;
+        }
+    }
+};
+
+QT_END_NAMESPACE
+
+#endif // QCONCURRENTCACHE_H
@@ -40,6 +40,8 @@
 
 #include <qcryptographichash.h>
 #include <qiodevice.h>
+#include <qvarlengtharray.h>
+#include <private/qsimd_p.h>
 
 #include "../../3rdparty/sha1/sha1.cpp"
 
@@ -138,6 +140,298 @@ static inline int SHA384_512AddLength(SHA512Context *context, unsigned int lengt
 
 QT_BEGIN_NAMESPACE
 
+// SHA-1 and SHA-256 with the SHA instructions of x86 and ARMv8 processors.
+// They replace the processing of whole 64-byte blocks, and work on the
+// contexts of the reference implementations, which still do the buffering.
+#if defined(Q_PROCESSOR_X86) && QT_COMPILER_SUPPORTS_HERE(SHA) && QT_COMPILER_SUPPORTS_HERE(SSE4_1) \
+    && !defined(QT_BOOTSTRAPPED)
+#  define QCRYPTOGRAPHICHASH_SHA_X86
+#  define QT_FUNCTION_TARGET_STRING_SHA_SSE4_1 "sha,sse4.1"
+#elif defined(Q_PROCESSOR_ARM_64) && QT_COMPILER_SUPPORTS_HERE(AES) && !defined(QT_BOOTSTRAPPED)
+// the Cryptographic Extension provides both the AES and the SHA instructions
+#  define QCRYPTOGRAPHICHASH_SHA_ARM
+#endif
+
+#if defined(QCRYPTOGRAPHICHASH_SHA_X86) || defined(QCRYPTOGRAPHICHASH_SHA_ARM)
+#  define QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+
+static bool hasShaInstructions() noexcept
+{
+#  if defined(QCRYPTOGRAPHICHASH_SHA_X86)
+    return qCpuHasFeature(SHA) && qCpuHasFeature(SSE4_1);
+#  elif defined(Q_OS_LINUX)
+    // Do specific runtime-only check as Yocto hard enables Crypto extension for
+    // all armv8 configs
+    return qCpuFeatures() & CpuFeatureAES;
+#  else
+    return qCpuHasFeature(AES);
+#  endif
+}
+
+#  ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+alignas(16) static const quint32 sha256RoundConstants[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+#  endif
+
+#  if defined(QCRYPTOGRAPHICHASH_SHA_X86)
+static void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha1ProcessBlocks(Sha1State *state, const uchar *data, size_t blocks) noexcept
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    // the instructions want A in the highest lane, and E in the highest lane of its own register
+    __m128i abcd = _mm_set_epi32(state->h0, state->h1, state->h2, state->h3);
+    __m128i e = _mm_set_epi32(state->h4, 0, 0, 0);
+
+    for (; blocks; --blocks, data += 64) {
+        const __m128i abcdSaved = abcd;
+        const __m128i eSaved = e;
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), byteSwap);
+
+        // Each step does 4 of the 80 rounds, and expands the message schedule
+        // 4 words at a time: W[k] = msg2(msg1(W[k - 4], W[k - 3]) ^ W[k - 2], W[k - 1]).
+        __m128i previous = abcd;
+        e = _mm_add_epi32(e, w[0]);
+#define SHA1_STEP(j, f) \
+        if constexpr (j > 0) { \
+            e = _mm_sha1nexte_epu32(previous, w[j % 4]); \
+            previous = abcd; \
+        } \
+        if constexpr (j >= 3 && j <= 18) \
+            w[(j + 1) % 4] = _mm_sha1msg2_epu32(w[(j + 1) % 4], w[j % 4]); \
+        abcd = _mm_sha1rnds4_epu32(abcd, e, f); \
+        if constexpr (j >= 1 && j <= 16) \
+            w[(j + 3) % 4] = _mm_sha1msg1_epu32(w[(j + 3) % 4], w[j % 4]); \
+        if constexpr (j >= 2 && j <= 17) \
+            w[(j + 2) % 4] = _mm_xor_si128(w[(j + 2) % 4], w[j % 4]);
+        SHA1_STEP(0, 0) SHA1_STEP(1, 0) SHA1_STEP(2, 0) SHA1_STEP(3, 0) SHA1_STEP(4, 0)
+        SHA1_STEP(5, 1) SHA1_STEP(6, 1) SHA1_STEP(7, 1) SHA1_STEP(8, 1) SHA1_STEP(9, 1)
+        SHA1_STEP(10, 2) SHA1_STEP(11, 2) SHA1_STEP(12, 2) SHA1_STEP(13, 2) SHA1_STEP(14, 2)
+        SHA1_STEP(15, 3) SHA1_STEP(16, 3) SHA1_STEP(17, 3) SHA1_STEP(18, 3) SHA1_STEP(19, 3)
+#undef SHA1_STEP
+        e = _mm_sha1nexte_epu32(previous, eSaved);
+        abcd = _mm_add_epi32(abcd, abcdSaved);
+    }
+
+    state->h0 = _mm_extract_epi32(abcd, 3);
+    state->h1 = _mm_extract_epi32(abcd, 2);
+    state->h2 = _mm_extract_epi32(abcd, 1);
+    state->h3 = _mm_extract_epi32(abcd, 0);
+    state->h4 = _mm_extract_epi32(e, 3);
+}
+
+#    ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+static void QT_FUNCTION_TARGET(SHA_SSE4_1)
+sha256ProcessBlocks(SHA256Context *context, const uchar *data, size_t blocks) noexcept
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    // the instructions work on the state rearranged as ABEF and CDGH
+    __m128i abcd = _mm_loadu_si128(reinterpret_cast<const __m128i *>(context->Intermediate_Hash));
+    __m128i efgh = _mm_loadu_si128(reinterpret_cast<const __m128i *>(context->Intermediate_Hash + 4));
+    abcd = _mm_shuffle_epi32(abcd, 0xb1);                  // CDAB
+    efgh = _mm_shuffle_epi32(efgh, 0x1b);                  // EFGH
+    __m128i abef = _mm_alignr_epi8(abcd, efgh, 8);         // ABEF
+    __m128i cdgh = _mm_blend_epi16(efgh, abcd, 0xf0);      // CDGH
+
+    for (; blocks; --blocks, data += 64) {
+        const __m128i abefSaved = abef;
+        const __m128i cdghSaved = cdgh;
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16 * i)), byteSwap);
+
+        // Each step does 4 of the 64 rounds, and expands the message schedule 4 words at a time
+        for (int j = 0; j < 16; ++j) {
+            const __m128i wk = _mm_add_epi32(w[j % 4],
+                    _mm_loadu_si128(reinterpret_cast<const __m128i *>(sha256RoundConstants + 4 * j)));
+            if (j < 12) {
+                const __m128i w7 = _mm_alignr_epi8(w[(j + 3) % 4], w[(j + 2) % 4], 4);
+                w[j % 4] = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w[j % 4], w[(j + 1) % 4]), w7),
+                                                w[(j + 3) % 4]);
+            }
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, _mm_shuffle_epi32(wk, 0x0e));
+        }
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+
+    abcd = _mm_shuffle_epi32(abef, 0x1b);                  // FEBA
+    efgh = _mm_shuffle_epi32(cdgh, 0xb1);                  // DCHG
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(context->Intermediate_Hash),
+                     _mm_blend_epi16(abcd, efgh, 0xf0));   // DCBA
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(context->Intermediate_Hash + 4),
+                     _mm_alignr_epi8(efgh, abcd, 8));      // HGFE
+}
+#    endif
+#  else // QCRYPTOGRAPHICHASH_SHA_ARM
+QT_FUNCTION_TARGET(AES)
+static void sha1ProcessBlocks(Sha1State *state, const uchar *data, size_t blocks) noexcept
+{
+    static const quint32 roundConstants[4] = { 0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6 };
+    const quint32 h[4] = { state->h0, state->h1, state->h2, state->h3 };
+    uint32x4_t abcd = vld1q_u32(h);
+    quint32 e = state->h4;
+
+    for (; blocks; --blocks, data += 64) {
+        const uint32x4_t abcdSaved = abcd;
+        const quint32 eSaved = e;
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+        // Each step does 4 of the 80 rounds, and expands the message schedule 4 words at a time
+        for (int j = 0; j < 20; ++j) {
+            const uint32x4_t wk = vaddq_u32(w[j % 4], vdupq_n_u32(roundConstants[j / 5]));
+            const quint32 eNext = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+            if (j < 5)
+                abcd = vsha1cq_u32(abcd, e, wk);
+            else if (j < 10 || j >= 15)
+                abcd = vsha1pq_u32(abcd, e, wk);
+            else
+                abcd = vsha1mq_u32(abcd, e, wk);
+            e = eNext;
+            if (j < 16)
+                w[j % 4] = vsha1su1q_u32(vsha1su0q_u32(w[j % 4], w[(j + 1) % 4], w[(j + 2) % 4]), w[(j + 3) % 4]);
+        }
+        abcd = vaddq_u32(abcd, abcdSaved);
+        e += eSaved;
+    }
+
+    state->h0 = vgetq_lane_u32(abcd, 0);
+    state->h1 = vgetq_lane_u32(abcd, 1);
+    state->h2 = vgetq_lane_u32(abcd, 2);
+    state->h3 = vgetq_lane_u32(abcd, 3);
+    state->h4 = e;
+}
+
+#    ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+QT_FUNCTION_TARGET(AES)
+static void sha256ProcessBlocks(SHA256Context *context, const uchar *data, size_t blocks) noexcept
+{
+    uint32x4_t abcd = vld1q_u32(context->Intermediate_Hash);
+    uint32x4_t efgh = vld1q_u32(context->Intermediate_Hash + 4);
+
+    for (; blocks; --blocks, data += 64) {
+        const uint32x4_t abcdSaved = abcd;
+        const uint32x4_t efghSaved = efgh;
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+        // Each step does 4 of the 64 rounds, and expands the message schedule 4 words at a time
+        for (int j = 0; j < 16; ++j) {
+            const uint32x4_t wk = vaddq_u32(w[j % 4], vld1q_u32(sha256RoundConstants + 4 * j));
+            if (j < 12)
+                w[j % 4] = vsha256su1q_u32(vsha256su0q_u32(w[j % 4], w[(j + 1) % 4]), w[(j + 2) % 4], w[(j + 3) % 4]);
+            const uint32x4_t abcdPrevious = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, abcdPrevious, wk);
+        }
+        abcd = vaddq_u32(abcd, abcdSaved);
+        efgh = vaddq_u32(efgh, efghSaved);
+    }
+
+    vst1q_u32(context->Intermediate_Hash, abcd);
+    vst1q_u32(context->Intermediate_Hash + 4, efgh);
+}
+#    endif
+#  endif
+
+// Same as sha1Update(), with the whole blocks processed by sha1ProcessBlocks()
+static void sha1UpdateWithShaInstructions(Sha1State *state, const uchar *data, size_t len) noexcept
+{
+    const size_t rest = size_t(state->messageSize & 63);
+    state->messageSize += len;
+    if (rest) {
+        const size_t n = qMin(len, 64 - rest);
+        memcpy(state->buffer + rest, data, n);
+        if (rest + n < 64)
+            return;
+        sha1ProcessBlocks(state, state->buffer, 1);
+        data += n;
+        len -= n;
+    }
+    sha1ProcessBlocks(state, data, len / 64);
+    memcpy(state->buffer, data + (len & ~size_t(63)), len & 63);
+}
+
+// Same as sha1FinalizeState(), with the padding blocks processed by sha1ProcessBlocks()
+static void sha1FinalizeStateWithShaInstructions(Sha1State *state) noexcept
+{
+    uchar padding[2 * 64] = {};
+    const size_t rest = size_t(state->messageSize & 63);
+    const size_t blocks = rest < 64 - 8 ? 1 : 2;
+    memcpy(padding, state->buffer, rest);
+    padding[rest] = 0x80;
+    qToBigEndian(state->messageSize << 3, padding + 64 * blocks - 8);
+    sha1ProcessBlocks(state, padding, blocks);
+}
+
+#  ifndef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
+// Same as SHA256Input() and SHA224Input(), with the whole blocks processed by sha256ProcessBlocks()
+static void sha256InputWithShaInstructions(SHA256Context *context, const uchar *data, size_t len) noexcept
+{
+    if (context->Computed || context->Corrupted) {
+        SHA256Input(context, data, uint(len)); // flags the error
+        return;
+    }
+    if (context->Message_Block_Index) {
+        const size_t n = qMin(len, size_t(SHA256_Message_Block_Size - context->Message_Block_Index));
+        SHA256Input(context, data, uint(n));
+        data += n;
+        len -= n;
+    }
+    if (const size_t blocks = len / SHA256_Message_Block_Size) {
+        const quint64 bits = quint64(context->Length_High) << 32 | context->Length_Low;
+        const quint64 newBits = bits + quint64(blocks) * SHA256_Message_Block_Size * 8;
+        if (newBits < bits) {
+            context->Corrupted = shaInputTooLong;
+            return;
+        }
+        context->Length_High = uint32_t(newBits >> 32);
+        context->Length_Low = uint32_t(newBits);
+        sha256ProcessBlocks(context, data, blocks);
+        data += blocks * SHA256_Message_Block_Size;
+        len -= blocks * SHA256_Message_Block_Size;
+    }
+    SHA256Input(context, data, uint(len));
+}
+
+// Same as SHA256Result() and SHA224Result(), with the padding blocks processed
+// by sha256ProcessBlocks(); returns false if the context is in an error state
+static bool sha256ResultWithShaInstructions(SHA256Context *context, uchar *digest, int hashSize) noexcept
+{
+    if (context->Corrupted)
+        return false;
+    if (!context->Computed) {
+        uchar padding[2 * SHA256_Message_Block_Size] = {};
+        const size_t index = size_t(context->Message_Block_Index);
+        const size_t blocks = index < SHA256_Message_Block_Size - 8 ? 1 : 2;
+        memcpy(padding, context->Message_Block, index);
+        padding[index] = 0x80;
+        qToBigEndian(context->Length_High, padding + SHA256_Message_Block_Size * blocks - 8);
+        qToBigEndian(context->Length_Low, padding + SHA256_Message_Block_Size * blocks - 4);
+        sha256ProcessBlocks(context, padding, blocks);
+        context->Computed = 1;
+    }
+    for (int i = 0; i < hashSize / 4; ++i)
+        qToBigEndian(context->Intermediate_Hash[i], digest + 4 * i);
+    return true;
+}
+#  endif
+#endif // QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+
 static constexpr qsizetype MaxHashLength = 64;
 
 static constexpr int hashLengthInternal(QCryptographicHash::Algorithm method) noexcept
@@ -476,6 +770,12 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
 #endif
         switch (method) {
         case QCryptographicHash::Sha1:
+#ifdef QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+            if (hasShaInstructions()) {
+                sha1UpdateWithShaInstructions(&sha1Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             sha1Update(&sha1Context, (const unsigned char *)data, length);
             break;
 #ifdef QT_CRYPTOGRAPHICHASH_ONLY_SHA1
@@ -491,9 +791,21 @@ void QCryptographicHashPrivate::addData(QByteArrayView bytes) noexcept
             MD5Update(&md5Context, (const unsigned char *)data, length);
             break;
         case QCryptographicHash::Sha224:
+#ifdef QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+            if (hasShaInstructions()) {
+                sha256InputWithShaInstructions(&sha224Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             SHA224Input(&sha224Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case QCryptographicHash::Sha256:
+#ifdef QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+            if (hasShaInstructions()) {
+                sha256InputWithShaInstructions(&sha256Context, reinterpret_cast<const uchar *>(data), length);
+                break;
+            }
+#endif
             SHA256Input(&sha256Context, reinterpret_cast<const unsigned char *>(data), length);
             break;
         case QCryptographicHash::Sha384:
@@ -543,11 +855,17 @@ bool QCryptographicHash::addData(QIODevice *device)
     if (!device->isOpen())
         return false;
 
-    char buffer[1024];
-    int length;
+    // Read random-access devices in large blocks: reads of at least the size
+    // of QIODevice's own buffer go straight to the device, and need fewer
+    // system calls. Small inputs and sequential devices stay on the stack.
+    constexpr qint64 LargeBufferSize = 64 * 1024;
+    QVarLengthArray<char, 4096> buffer(4096);
+    if (!device->isSequential())
+        buffer.resize(qBound(qint64(buffer.size()), device->size() - device->pos(), LargeBufferSize));
 
-    while ((length = device->read(buffer, sizeof(buffer))) > 0)
-        d->addData({buffer, length});
+    qint64 length;
+    while ((length = device->read(buffer.data(), buffer.size())) > 0)
+        d->addData({buffer.data(), length});
 
     return device->atEnd();
 }
@@ -588,7 +906,12 @@ void QCryptographicHashPrivate::finalize() noexcept
     case QCryptographicHash::Sha1: {
         Sha1State copy = sha1Context;
         result.resizeForOverwrite(20);
-        sha1FinalizeState(&copy);
+#ifdef QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+        if (hasShaInstructions())
+            sha1FinalizeStateWithShaInstructions(&copy);
+        else
+#endif
+            sha1FinalizeState(&copy);
         sha1ToHash(&copy, (unsigned char *)result.data());
         break;
     }
@@ -613,12 +936,22 @@ void QCryptographicHashPrivate::finalize() noexcept
     case QCryptographicHash::Sha224: {
         SHA224Context copy = sha224Context;
         result.resizeForOverwrite(SHA224HashSize);
+#ifdef QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+        if (hasShaInstructions()
+                && sha256ResultWithShaInstructions(&copy, reinterpret_cast<uchar *>(result.data()), SHA224HashSize))
+            break;
+#endif
         SHA224Result(&copy, reinterpret_cast<unsigned char *>(result.data()));
         break;
     }
     case QCryptographicHash::Sha256: {
         SHA256Context copy = sha256Context;
         result.resizeForOverwrite(SHA256HashSize);
+#ifdef QCRYPTOGRAPHICHASH_SHA_INSTRUCTIONS
+        if (hasShaInstructions()
+                && sha256ResultWithShaInstructions(&copy, reinterpret_cast<uchar *>(result.data()), SHA256HashSize))
+            break;
+#endif
         SHA256Result(&copy, reinterpret_cast<unsigned char *>(result.data()));
         break;
     }
@@ -686,6 +1019,31 @@ QByteArray QCryptographicHash::hash(QByteArrayView data, Algorithm method)
     return hash.resultView().toByteArray();
 }
 
+/*!
+  \since 6.4
+
+  Returns the hashes of each of the \a messages using \a method, in the
+  same order.
+
+  This is equivalent to calling hash() for each message, but uses a
+  single hashing state for all of them.
+
+  \sa hash()
+*/
+QByteArrayList QCryptographicHash::hashMany(const QList<QByteArrayView> &messages, Algorithm method)
+{
+    QByteArrayList results;
+    results.reserve(messages.size());
+    QCryptographicHashPrivate hash(method);
+    for (QByteArrayView message : messages) {
+        hash.reset();
+        hash.addData(message);
+        hash.finalize();
+        results.append(hash.resultView().toByteArray());
+    }
+    return results;
+}
+
 /*!
   Returns the size of the output of the selected hash \a method in bytes.
 
@@ -43,6 +43,7 @@
 #define QCRYPTOGRAPHICHASH_H
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qbytearraylist.h>
 #include <QtCore/qobjectdefs.h>
 
 QT_BEGIN_NAMESPACE
@@ -121,6 +122,7 @@ public:
     static QByteArray hash(const QByteArray &data, Algorithm method);
 #endif
     static QByteArray hash(QByteArrayView data, Algorithm method);
+    static QByteArrayList hashMany(const QList<QByteArrayView> &messages, Algorithm method);
     static int hashLength(Algorithm method);
 private:
     Q_DISABLE_COPY(QCryptographicHash)
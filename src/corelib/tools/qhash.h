@@ -41,12 +41,14 @@
 #ifndef QHASH_H
 #define QHASH_H
 
+#include <QtCore/qalgorithms.h>
 #include <QtCore/qcontainertools_impl.h>
 #include <QtCore/qhashfunctions.h>
 #include <QtCore/qiterator.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmath.h>
 #include <QtCore/qrefcount.h>
+#include <QtCore/qsimd.h>
 
 #include <initializer_list>
 #include <functional> // for std::hash
@@ -259,10 +261,68 @@ struct SpanConstants {
     static constexpr size_t NEntries = (1 << SpanShift);
     static constexpr size_t LocalBucketMask = (NEntries - 1);
     static constexpr size_t UnusedEntry = 0xff;
+    static constexpr unsigned char UnusedTag = 0x80;
 
     static_assert ((NEntries & LocalBucketMask) == 0, "NEntries must be a power of two.");
 };
 
+// The tag of a used bucket is made of the top 7 bits of the hash of its key,
+// the low bits select the bucket. Unused buckets have the tag UnusedTag.
+inline constexpr unsigned char tagForHash(size_t hash) noexcept
+{
+    return static_cast<unsigned char>(hash >> (std::numeric_limits<size_t>::digits - 7));
+}
+
+// Compares the tags of a group of TagGroup::Size consecutive buckets with
+// the one searched for at once. Bucket i of the group is represented by bit
+// (i << LaneShift) in the masks; no other bits are set.
+//
+// The size of the groups is part of the layout of a Span, so it doesn't
+// depend on the instruction set: wider vectors wouldn't help much anyway,
+// as at most 50% of the buckets are used and probe sequences are short.
+struct TagGroup
+{
+    static constexpr size_t Size = 16;
+#if QT_COMPILER_USES(neon) && !QT_COMPILER_USES(sse2)
+    static constexpr uint LaneShift = 2;
+    using Mask = quint64;
+#else
+    static constexpr uint LaneShift = 0;
+    using Mask = quint32;
+#endif
+    static_assert(SpanConstants::NEntries % Size == 0, "Groups must not cross spans");
+
+    Mask matching; // buckets with the tag
+    Mask unused;
+
+    static TagGroup match(const unsigned char *tags, unsigned char tag) noexcept
+    {
+#if QT_COMPILER_USES(sse2)
+        const __m128i group = _mm_load_si128(reinterpret_cast<const __m128i *>(tags));
+        const __m128i matches = _mm_cmpeq_epi8(group, _mm_set1_epi8(char(tag)));
+        return { Mask(_mm_movemask_epi8(matches)), Mask(_mm_movemask_epi8(group)) };
+#elif QT_COMPILER_USES(neon)
+        // narrow each byte to a nibble and keep its top bit
+        const auto toMask = [](uint8x16_t v) {
+            const uint8x8_t nibbles = vshrn_n_u16(vreinterpretq_u16_u8(v), 4);
+            return Mask(vget_lane_u64(vreinterpret_u64_u8(nibbles), 0))
+                   & Q_UINT64_C(0x8888888888888888);
+        };
+        const uint8x16_t group = vld1q_u8(tags);
+        const uint8x16_t matches = vceqq_u8(group, vdupq_n_u8(tag));
+        const uint8x16_t unused = vcgeq_u8(group, vdupq_n_u8(SpanConstants::UnusedTag));
+        return { toMask(matches), toMask(unused) };
+#else
+        TagGroup result = { 0, 0 };
+        for (size_t i = 0; i < Size; ++i) {
+            result.matching |= Mask(tags[i] == tag) << i;
+            result.unused |= Mask(tags[i] == SpanConstants::UnusedTag) << i;
+        }
+        return result;
+#endif
+    }
+};
+
 // Regular hash tables consist of a list of buckets that can store Nodes. But simply allocating one large array of buckets
 // would waste a lot of memory. To avoid this, we split the vector of buckets up into a vector of Spans. Each Span represents
 // NEntries buckets. To quickly find the correct Span that holds a bucket, NEntries must be a power of two.
@@ -271,6 +331,11 @@ struct SpanConstants {
 // actual storage space for the Nodes (the 'entries' member) or 0xff (UnusedEntry) to flag that the bucket is empty.
 // As we have only 128 entries per Span, the offset array can be represented using an unsigned char. This trick makes the hash
 // table have a very small memory overhead compared to many other implementations.
+//
+// Each bucket also has a 7 bit tag, taken from the hash of its key (see tagForHash()). Lookups compare the tags of a whole
+// TagGroup of buckets at once and only look at the Nodes whose tags match, which avoids most of the cache misses and
+// mispredicted branches of comparing keys one bucket at a time. The tags are kept apart from the offsets, so that the
+// common case of a lookup decided by its home bucket touches the same memory as without them.
 template<typename Node>
 struct Span {
     // Entry is a slot available for storing a Node. The Span holds a pointer to
@@ -290,9 +355,11 @@ struct Span {
     Entry *entries = nullptr;
     unsigned char allocated = 0;
     unsigned char nextFree = 0;
+    alignas(TagGroup::Size) unsigned char tags[SpanConstants::NEntries];
     Span() noexcept
     {
         memset(offsets, SpanConstants::UnusedEntry, sizeof(offsets));
+        memset(tags, SpanConstants::UnusedTag, sizeof(tags));
     }
     ~Span()
     {
@@ -311,16 +378,18 @@ struct Span {
             entries = nullptr;
         }
     }
-    Node *insert(size_t i)
+    Node *insert(size_t i, unsigned char tag)
     {
         Q_ASSERT(i < SpanConstants::NEntries);
         Q_ASSERT(offsets[i] == SpanConstants::UnusedEntry);
+        Q_ASSERT(tag < SpanConstants::UnusedTag);
         if (nextFree == allocated)
             addStorage();
         unsigned char entry = nextFree;
         Q_ASSERT(entry < allocated);
         nextFree = entries[entry].nextFree();
         offsets[i] = entry;
+        tags[i] = tag;
         return &entries[entry].node();
     }
     void erase(size_t bucket) noexcept(std::is_nothrow_destructible<Node>::value)
@@ -330,6 +399,7 @@ struct Span {
 
         unsigned char entry = offsets[bucket];
         offsets[bucket] = SpanConstants::UnusedEntry;
+        tags[bucket] = SpanConstants::UnusedTag;
 
         entries[entry].node().~Node();
         entries[entry].nextFree() = nextFree;
@@ -375,6 +445,8 @@ struct Span {
         Q_ASSERT(offsets[to] == SpanConstants::UnusedEntry);
         offsets[to] = offsets[from];
         offsets[from] = SpanConstants::UnusedEntry;
+        tags[to] = tags[from];
+        tags[from] = SpanConstants::UnusedTag;
     }
     void moveFromSpan(Span &fromSpan, size_t fromIndex, size_t to) noexcept(std::is_nothrow_move_constructible_v<Node>)
     {
@@ -386,11 +458,13 @@ struct Span {
             addStorage();
         Q_ASSERT(nextFree < allocated);
         offsets[to] = nextFree;
+        tags[to] = fromSpan.tags[fromIndex];
         Entry &toEntry = entries[nextFree];
         nextFree = toEntry.nextFree();
 
         size_t fromOffset = fromSpan.offsets[fromIndex];
         fromSpan.offsets[fromIndex] = SpanConstants::UnusedEntry;
+        fromSpan.tags[fromIndex] = SpanConstants::UnusedTag;
         Entry &fromEntry = fromSpan.entries[fromOffset];
 
         if constexpr (isRelocatable<Node>()) {
@@ -540,9 +614,9 @@ struct Data
         {
             return &span->at(index);
         }
-        Node *insert() const
+        Node *insert(unsigned char tag) const
         {
-            return span->insert(index);
+            return span->insert(index, tag);
         }
 
     private:
@@ -581,9 +655,14 @@ struct Data
                 if (!span.hasNode(index))
                     continue;
                 const Node &n = span.at(index);
-                auto it = resized ? findBucket(n.key) : Bucket { spans + s, index };
-                Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                Node *newNode;
+                if (resized) {
+                    const size_t hash = QHashPrivate::calculateHash(n.key, seed);
+                    auto it = findUnusedBucket(hash);
+                    newNode = it.insert(tagForHash(hash));
+                } else {
+                    newNode = spans[s].insert(index, span.tags[index]);
+                }
                 new (newNode) Node(n);
             }
         }
@@ -668,9 +747,9 @@ struct Data
                 if (!span.hasNode(index))
                     continue;
                 Node &n = span.at(index);
-                auto it = findBucket(n.key);
-                Q_ASSERT(it.isUnused());
-                Node *newNode = it.insert();
+                const size_t hash = QHashPrivate::calculateHash(n.key, seed);
+                auto it = findUnusedBucket(hash);
+                Node *newNode = it.insert(tagForHash(hash));
                 new (newNode) Node(std::move(n));
             }
             span.freeData();
@@ -695,44 +774,76 @@ struct Data
         return size >= (numBuckets >> 1);
     }
 
-    Bucket findBucket(const Key &key) const noexcept
+    // Walks the buckets from the one of hash onwards until isMatch() accepts
+    // one of them or an unused bucket is found. Past the first bucket, this
+    // goes a TagGroup at a time and only calls isMatch() for buckets whose tag
+    // matches hash, visiting them in the same order as probing one by one.
+    template <typename Predicate>
+    Q_ALWAYS_INLINE Bucket probe(size_t hash, Predicate isMatch) const noexcept
     {
         Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
-        Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
-        // loop over the buckets until we find the entry we search for
-        // or an empty slot, in which case we know the entry doesn't exist
+        using Mask = TagGroup::Mask;
+        const unsigned char tag = tagForHash(hash);
+        const size_t bucket = GrowthPolicy::bucketForHash(numBuckets, hash);
+        Span *span = spans + (bucket >> SpanConstants::SpanShift);
+        const size_t index = bucket & SpanConstants::LocalBucketMask;
+        // most lookups are decided by the home bucket, which is cheaper to
+        // check on its own: it doesn't need the tags
+        const size_t offset = span->offsets[index];
+        if (offset == SpanConstants::UnusedEntry || isMatch(span->atOffset(offset)))
+            return Bucket(span, index);
+
+        size_t group = index & ~(TagGroup::Size - 1);
+        // ignore the buckets of the first group up to and including ours
+        Mask first = ~Mask(0) << ((index - group) << TagGroup::LaneShift) << (1 << TagGroup::LaneShift);
         while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return bucket;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
-                    return bucket;
+            TagGroup g = TagGroup::match(span->tags + group, tag);
+            g.matching &= first;
+            g.unused &= first;
+            if (g.unused)
+                g.matching &= (g.unused & (~g.unused + 1)) - 1; // before the first unused bucket
+            for (; g.matching; g.matching &= g.matching - 1) {
+                const size_t i = group + (qCountTrailingZeroBits(g.matching) >> TagGroup::LaneShift);
+                if (isMatch(span->atOffset(span->offsets[i])))
+                    return Bucket(span, i);
+            }
+            if (g.unused)
+                return Bucket(span, group + (qCountTrailingZeroBits(g.unused) >> TagGroup::LaneShift));
+
+            first = ~Mask(0);
+            group += TagGroup::Size;
+            if (group == SpanConstants::NEntries) {
+                group = 0;
+                ++span;
+                if (span - spans == ptrdiff_t(numBuckets >> SpanConstants::SpanShift))
+                    span = spans;
             }
-            bucket.advanceWrapped(this);
         }
     }
 
-    Node *findNode(const Key &key) const noexcept
+    Bucket findBucketWithHash(const Key &key, size_t hash) const noexcept
     {
-        Q_ASSERT(numBuckets > 0);
-        size_t hash = QHashPrivate::calculateHash(key, seed);
-        Bucket bucket(this, GrowthPolicy::bucketForHash(numBuckets, hash));
         // loop over the buckets until we find the entry we search for
         // or an empty slot, in which case we know the entry doesn't exist
-        while (true) {
-            size_t offset = bucket.offset();
-            if (offset == SpanConstants::UnusedEntry) {
-                return nullptr;
-            } else {
-                Node &n = bucket.nodeAtOffset(offset);
-                if (qHashEquals(n.key, key))
-                    return &n;
-            }
-            bucket.advanceWrapped(this);
-        }
+        return probe(hash, [&key](const Node &n) { return qHashEquals(n.key, key); });
+    }
+
+    Bucket findBucket(const Key &key) const noexcept
+    {
+        Q_ASSERT(numBuckets > 0);
+        return findBucketWithHash(key, QHashPrivate::calculateHash(key, seed));
+    }
+
+    // for keys that are known not to be in the table
+    Bucket findUnusedBucket(size_t hash) const noexcept
+    {
+        return probe(hash, [](const Node &) { return false; });
+    }
+
+    Node *findNode(const Key &key) const noexcept
+    {
+        Bucket bucket = findBucket(key);
+        return bucket.isUnused() ? nullptr : bucket.node();
     }
 
     struct InsertionResult
@@ -744,18 +855,19 @@ struct Data
     InsertionResult findOrInsert(const Key &key) noexcept
     {
         Bucket it(static_cast<Span *>(nullptr), 0);
+        const size_t hash = QHashPrivate::calculateHash(key, seed);
         if (numBuckets > 0) {
-            it = findBucket(key);
+            it = findBucketWithHash(key, hash);
             if (!it.isUnused())
                 return { it.toIterator(this), true };
         }
         if (shouldGrow()) {
             rehash(size + 1);
-            it = findBucket(key); // need to get a new iterator after rehashing
+            it = findUnusedBucket(hash); // need to get a new iterator after rehashing
         }
         Q_ASSERT(it.span != nullptr);
         Q_ASSERT(it.isUnused());
-        it.insert();
+        it.insert(tagForHash(hash));
         ++size;
         return { it.toIterator(this), false };
     }
@@ -144,6 +144,40 @@ ci.ifa_prefered = ci.ifa_valid = 0;
 }
 ")
 
+# sendmmsg
+qt_config_compile_test(sendmmsg
+    LABEL "sendmmsg() and recvmmsg()"
+    CODE
+"#include <sys/types.h>
+#include <sys/socket.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+struct mmsghdr msgs[2] = {};
+(void) sendmmsg(-1, msgs, 2, 0);
+(void) recvmmsg(-1, msgs, 2, 0, 0);
+    /* END TEST: */
+    return 0;
+}
+")
+
+# sendfile
+qt_config_compile_test(sendfile
+    LABEL "Linux sendfile()"
+    CODE
+"#include <sys/sendfile.h>
+
+int main(void)
+{
+    /* BEGIN TEST: */
+off_t offset = 0;
+(void) sendfile(-1, -1, &offset, 1);
+    /* END TEST: */
+    return 0;
+}
+")
+
 # sctp
 qt_config_compile_test(sctp
     LABEL "SCTP support"
@@ -254,6 +288,18 @@ qt_feature("linux-netlink" PRIVATE
     LABEL "Linux AF_NETLINK"
     CONDITION LINUX AND NOT ANDROID AND TEST_linux_netlink
 )
+qt_feature("sendmmsg" PRIVATE
+    LABEL "sendmmsg() and recvmmsg()"
+    CONDITION UNIX AND TEST_sendmmsg
+)
+qt_feature("writev" PRIVATE
+    LABEL "writev()"
+    CONDITION UNIX
+)
+qt_feature("sendfile" PRIVATE
+    LABEL "sendfile()"
+    CONDITION LINUX AND TEST_sendfile
+)
 qt_feature("openssl" PRIVATE
     LABEL "OpenSSL"
     CONDITION QT_FEATURE_openssl_runtime OR QT_FEATURE_openssl_linked
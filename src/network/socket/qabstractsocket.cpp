@@ -470,16 +470,21 @@
 #include "private/qhostinfo_p.h"
 
 #include <qabstracteventdispatcher.h>
+#include <qfiledevice.h>
 #include <qhostaddress.h>
 #include <qhostinfo.h>
 #include <qmetaobject.h>
 #include <qpointer.h>
+#include <qscopeguard.h>
 #include <qtimer.h>
 #include <qelapsedtimer.h>
 #include <qscopedvaluerollback.h>
 #include <qvarlengtharray.h>
 
 #include <private/qthread_p.h>
+#if QT_CONFIG(sendfile)
+#include <private/qcore_unix_p.h>
+#endif
 
 #ifdef QABSTRACTSOCKET_DEBUG
 #include <qdebug.h>
@@ -538,6 +543,9 @@ QAbstractSocketPrivate::QAbstractSocketPrivate()
 */
 QAbstractSocketPrivate::~QAbstractSocketPrivate()
 {
+#if QT_CONFIG(sendfile)
+    clearPendingFileTransfers();
+#endif
 }
 
 /*! \internal
@@ -551,6 +559,9 @@ void QAbstractSocketPrivate::resetSocketLayer()
 #endif
 
     hasPendingData = false;
+#if QT_CONFIG(sendfile)
+    clearPendingFileTransfers();
+#endif
     if (socketEngine) {
         socketEngine->close();
         socketEngine->disconnect();
@@ -767,7 +778,7 @@ void QAbstractSocketPrivate::connectionNotification()
 
 /*! \internal
 
-    Writes one pending data block in the write buffer to the socket.
+    Writes pending data blocks in the write buffer to the socket.
 
     It is usually invoked by canWriteNotification after one or more
     calls to write().
@@ -778,7 +789,7 @@ bool QAbstractSocketPrivate::writeToSocket()
 {
     Q_Q(QAbstractSocket);
     if (!socketEngine || !socketEngine->isValid() || (writeBuffer.isEmpty()
-        && socketEngine->bytesToWrite() == 0)) {
+        && !hasPendingFileTransfers() && socketEngine->bytesToWrite() == 0)) {
 #if defined (QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocketPrivate::writeToSocket() nothing to do: valid ? %s, writeBuffer.isEmpty() ? %s",
            (socketEngine && socketEngine->isValid()) ? "yes" : "no", writeBuffer.isEmpty() ? "yes" : "no");
@@ -795,11 +806,35 @@ bool QAbstractSocketPrivate::writeToSocket()
         return false;
     }
 
-    qint64 nextSize = writeBuffer.nextDataBlockSize();
-    const char *ptr = writeBuffer.readPointer();
+#if QT_CONFIG(sendfile)
+    if (hasPendingFileTransfers() && pendingFileTransfers.constFirst().bufferedBefore == 0)
+        return writeFileToSocket();
+#endif
 
-    // Attempt to write it all in one chunk.
-    qint64 written = nextSize ? socketEngine->write(ptr, nextSize) : Q_INT64_C(0);
+    qint64 bytesToWrite = writeBuffer.size();
+#if QT_CONFIG(sendfile)
+    // don't write past the start of the next file
+    if (hasPendingFileTransfers())
+        bytesToWrite = qMin(bytesToWrite, pendingFileTransfers.constFirst().bufferedBefore);
+#endif
+
+    // Hand several chunks of the write buffer to the engine at once, so that
+    // many small writes don't cost a system call each.
+    constexpr qsizetype MaxWriteChunks = 32;
+    QVarLengthArray<QByteArrayView, MaxWriteChunks> chunks;
+    for (qint64 pos = 0; pos < bytesToWrite && chunks.size() < MaxWriteChunks; ) {
+        qint64 length;
+        const char *ptr = writeBuffer.readPointerAtPosition(pos, length);
+        length = qMin(length, bytesToWrite - pos);
+        chunks.append(QByteArrayView(ptr, length));
+        pos += length;
+    }
+
+    qint64 written = 0;
+    if (chunks.size() == 1)
+        written = socketEngine->write(chunks.first().data(), chunks.first().size());
+    else if (chunks.size() > 1)
+        written = socketEngine->writeChunks(chunks.constData(), chunks.size());
     if (written < 0) {
 #if defined (QABSTRACTSOCKET_DEBUG)
         qDebug() << "QAbstractSocketPrivate::writeToSocket() write error, aborting."
@@ -819,19 +854,123 @@ bool QAbstractSocketPrivate::writeToSocket()
     if (written > 0) {
         // Remove what we wrote so far.
         writeBuffer.free(written);
+#if QT_CONFIG(sendfile)
+        if (hasPendingFileTransfers())
+            pendingFileTransfers.first().bufferedBefore -= written;
+#endif
 
         // Emit notifications.
         emitBytesWritten(written);
     }
 
-    if (writeBuffer.isEmpty() && socketEngine && !socketEngine->bytesToWrite())
+    if (writeBuffer.isEmpty() && !hasPendingFileTransfers() && socketEngine
+        && !socketEngine->bytesToWrite()) {
         socketEngine->setWriteNotificationEnabled(false);
+    }
     if (state == QAbstractSocket::ClosingState)
         q->disconnectFromHost();
 
     return written > 0;
 }
 
+#if QT_CONFIG(sendfile)
+/*! \internal
+
+    Queues \a length bytes of \a file, starting at \a offset, to be sent
+    after the data currently in the write buffer. The file descriptor is
+    duplicated, so the transfer does not depend on \a file staying open.
+
+    Returns \c false if the transfer cannot be done by the socket engine.
+*/
+bool QAbstractSocketPrivate::enqueueFileTransfer(QFileDevice *file, qint64 offset, qint64 length)
+{
+    if (!socketEngine || !socketEngine->canSendFile() || file->isSequential()
+        || file->handle() == -1) {
+        return false;
+    }
+
+    // data written to the file must reach the kernel before we share its descriptor
+    if (file->isWritable() && !file->flush())
+        return false;
+
+    const int fd = qt_safe_dup(file->handle());
+    if (fd == -1)
+        return false;
+
+    qint64 bufferedBefore = writeBuffer.size();
+    for (const PendingFileTransfer &transfer : std::as_const(pendingFileTransfers))
+        bufferedBefore -= transfer.bufferedBefore;
+
+    pendingFileTransfers.append({ fd, offset, length, bufferedBefore });
+    pendingFileBytes += length;
+    return true;
+}
+
+/*! \internal
+
+    Sends as much as possible of the first pending file transfer to the
+    socket without blocking.
+
+    Emits bytesWritten().
+*/
+bool QAbstractSocketPrivate::writeFileToSocket()
+{
+    Q_Q(QAbstractSocket);
+    PendingFileTransfer &transfer = pendingFileTransfers.first();
+    const qint64 written = socketEngine->sendFile(transfer.fileDescriptor, transfer.offset,
+                                                  transfer.remaining);
+    if (written < 0) {
+#if defined (QABSTRACTSOCKET_DEBUG)
+        qDebug() << "QAbstractSocketPrivate::writeFileToSocket() sendfile error, aborting."
+                 << socketEngine->errorString();
+#endif
+        setErrorAndEmit(socketEngine->error(), socketEngine->errorString());
+        // an unexpected error so close the socket.
+        q->abort();
+        return false;
+    }
+
+#if defined (QABSTRACTSOCKET_DEBUG)
+    qDebug("QAbstractSocketPrivate::writeFileToSocket() %lld bytes written to the network",
+           written);
+#endif
+
+    if (written > 0) {
+        transfer.offset += written;
+        transfer.remaining -= written;
+        pendingFileBytes -= written;
+        if (transfer.remaining == 0) {
+            qt_safe_close(transfer.fileDescriptor);
+            pendingFileTransfers.removeFirst();
+        }
+
+        // Emit notifications.
+        emitBytesWritten(written);
+    }
+
+    if (writeBuffer.isEmpty() && !hasPendingFileTransfers() && socketEngine
+        && !socketEngine->bytesToWrite()) {
+        socketEngine->setWriteNotificationEnabled(false);
+    }
+    if (state == QAbstractSocket::ClosingState)
+        q->disconnectFromHost();
+
+    return written > 0;
+}
+
+/*! \internal
+
+    Drops all pending file transfers and closes their file descriptors.
+*/
+void QAbstractSocketPrivate::clearPendingFileTransfers()
+{
+    for (const PendingFileTransfer &transfer : std::as_const(pendingFileTransfers))
+        qt_safe_close(transfer.fileDescriptor);
+    pendingFileTransfers.clear();
+    pendingFileBytes = 0;
+}
+#endif // QT_CONFIG(sendfile)
+
 /*! \internal
 
     Writes pending data in the write buffers to the socket. The function
@@ -842,7 +981,7 @@ bool QAbstractSocketPrivate::flush()
 {
     bool dataWasWritten = false;
 
-    while (!allWriteBuffersEmpty() && writeToSocket())
+    while ((!allWriteBuffersEmpty() || hasPendingFileTransfers()) && writeToSocket())
         dataWasWritten = true;
 
     return dataWasWritten;
@@ -1767,7 +1906,10 @@ void QAbstractSocket::connectToHost(const QHostAddress &address, quint16 port,
 */
 qint64 QAbstractSocket::bytesToWrite() const
 {
-    const qint64 pendingBytes = QIODevice::bytesToWrite();
+    qint64 pendingBytes = QIODevice::bytesToWrite();
+#if QT_CONFIG(sendfile)
+    pendingBytes += d_func()->pendingFileBytes;
+#endif
 #if defined(QABSTRACTSOCKET_DEBUG)
     qDebug("QAbstractSocket::bytesToWrite() == %lld", pendingBytes);
 #endif
@@ -2195,7 +2337,9 @@ bool QAbstractSocket::waitForReadyRead(int msecs)
 
         bool readyToRead = false;
         bool readyToWrite = false;
-        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true, !d->writeBuffer.isEmpty(),
+        if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, true,
+                                                 !d->writeBuffer.isEmpty()
+                                                 || d->hasPendingFileTransfers(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2247,7 +2391,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         return false;
     }
 
-    if (d->writeBuffer.isEmpty())
+    if (d->writeBuffer.isEmpty() && !d->hasPendingFileTransfers())
         return false;
 
     QElapsedTimer stopWatch;
@@ -2264,7 +2408,7 @@ bool QAbstractSocket::waitForBytesWritten(int msecs)
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite,
                                   !d->readBufferMaxSize || d->buffer.size() < d->readBufferMaxSize,
-                                  !d->writeBuffer.isEmpty(),
+                                  !d->writeBuffer.isEmpty() || d->hasPendingFileTransfers(),
                                   qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForBytesWritten(%i) failed (%i, %s)",
@@ -2344,7 +2488,8 @@ bool QAbstractSocket::waitForDisconnected(int msecs)
         bool readyToRead = false;
         bool readyToWrite = false;
         if (!d->socketEngine->waitForReadOrWrite(&readyToRead, &readyToWrite, state() == ConnectedState,
-                                               !d->writeBuffer.isEmpty(),
+                                               !d->writeBuffer.isEmpty()
+                                               || d->hasPendingFileTransfers(),
                                                qt_subtract_from_timeout(msecs, stopWatch.elapsed()))) {
 #if defined (QABSTRACTSOCKET_DEBUG)
             qDebug("QAbstractSocket::waitForReadyRead(%i) failed (%i, %s)",
@@ -2411,6 +2556,89 @@ bool QAbstractSocket::flush()
     return d_func()->flush();
 }
 
+/*!
+    \since 6.4
+
+    Queues \a length bytes of \a file, starting at \a offset, for sending
+    after any data already written to the socket. If \a length is -1, the
+    file is sent up to its end. Returns the number of bytes queued, or -1 if
+    an error occurred.
+
+    When the socket is an unencrypted TCP socket that is not using a proxy,
+    and \a file is a regular file, the data is handed to the operating
+    system directly from the file (using \c sendfile() on Linux) and never
+    copied into the socket's write buffer. Otherwise, the contents of
+    \a file are read and written to the socket as if by write().
+
+    The queued bytes are counted by bytesToWrite(), and reported by the
+    bytesWritten() signal as they are sent. \a file may be closed or
+    destroyed as soon as this function returns.
+
+    The current position of \a file is the same after this function
+    returns as before, unless \a file is sequential: the bytes sent from a
+    sequential device, and the \a offset bytes skipped before them, are
+    consumed.
+
+    \sa write(), bytesToWrite()
+*/
+qint64 QAbstractSocket::sendFile(QFileDevice *file, qint64 offset, qint64 length)
+{
+    Q_D(QAbstractSocket);
+    if (!file || !file->isReadable()) {
+        qWarning("QAbstractSocket::sendFile: File not open for reading");
+        return -1;
+    }
+    if (!isWritable()) {
+        qWarning("QAbstractSocket::sendFile: device not open for writing");
+        return -1;
+    }
+    if (offset < 0 || length < -1) {
+        qWarning("QAbstractSocket::sendFile: Invalid offset or length");
+        return -1;
+    }
+
+    if (!file->isSequential()) {
+        const qint64 available = qMax(file->size() - offset, Q_INT64_C(0));
+        length = length == -1 ? available : qMin(length, available);
+        if (length == 0)
+            return 0;
+    }
+
+#if QT_CONFIG(sendfile)
+    if (length > 0 && d->enqueueFileTransfer(file, offset, length)) {
+        d->socketEngine->setWriteNotificationEnabled(true);
+        return length;
+    }
+#endif
+
+    // Copy the file into the write buffer, leaving the file's position as
+    // the sendfile() path does.
+    const qint64 oldPos = file->isSequential() ? -1 : file->pos();
+    const auto restorePosition = qScopeGuard([&] {
+        if (oldPos >= 0)
+            file->seek(oldPos);
+    });
+    if (file->isSequential() ? file->skip(offset) != offset : !file->seek(offset)) {
+        d->setError(UnknownSocketError, file->errorString());
+        return -1;
+    }
+
+    qint64 queued = 0;
+    while (length == -1 || queued < length) {
+        qint64 chunkSize = QABSTRACTSOCKET_BUFFERSIZE;
+        if (length != -1)
+            chunkSize = qMin(chunkSize, length - queued);
+        const QByteArray chunk = file->read(chunkSize);
+        if (chunk.isEmpty())
+            break;
+        const qint64 written = write(chunk);
+        if (written < 0)
+            return queued ? queued : -1;
+        queued += written;
+    }
+    return queued;
+}
+
 /*! \reimp
 */
 qint64 QAbstractSocket::readData(char *data, qint64 maxSize)
@@ -2463,7 +2691,7 @@ qint64 QAbstractSocket::writeData(const char *data, qint64 size)
     }
 
     if (!d->isBuffered && d->socketType == TcpSocket
-        && d->socketEngine && d->writeBuffer.isEmpty()) {
+        && d->socketEngine && d->writeBuffer.isEmpty() && !d->hasPendingFileTransfers()) {
         // This code is for the new Unbuffered QTcpSocket use case
         qint64 written = size ? d->socketEngine->write(data, size) : Q_INT64_C(0);
         if (written < 0) {
@@ -2691,7 +2919,7 @@ void QAbstractSocket::disconnectFromHost()
 
         // Wait for pending data to be written.
         if (d->socketEngine && d->socketEngine->isValid() && (!d->allWriteBuffersEmpty()
-            || d->socketEngine->bytesToWrite() > 0)) {
+            || d->hasPendingFileTransfers() || d->socketEngine->bytesToWrite() > 0)) {
             d->socketEngine->setWriteNotificationEnabled(true);
 
 #if defined(QABSTRACTSOCKET_DEBUG)
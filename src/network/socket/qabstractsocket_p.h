@@ -63,6 +63,7 @@
 QT_BEGIN_NAMESPACE
 
 class QHostInfo;
+class QFileDevice;
 
 class QAbstractSocketPrivate : public QIODevicePrivate, public QAbstractSocketEngineReceiver
 {
@@ -140,6 +141,26 @@ public:
     void emitReadyRead(int channel = 0);
     void emitBytesWritten(qint64 bytes, int channel = 0);
 
+#if QT_CONFIG(sendfile)
+    struct PendingFileTransfer
+    {
+        int fileDescriptor;
+        qint64 offset;
+        qint64 remaining;
+        // bytes of the write buffer that go out before this file
+        qint64 bufferedBefore;
+    };
+    QList<PendingFileTransfer> pendingFileTransfers;
+    qint64 pendingFileBytes = 0;
+
+    bool enqueueFileTransfer(QFileDevice *file, qint64 offset, qint64 length);
+    bool writeFileToSocket();
+    void clearPendingFileTransfers();
+    inline bool hasPendingFileTransfers() const { return !pendingFileTransfers.isEmpty(); }
+#else
+    inline bool hasPendingFileTransfers() const { return false; }
+#endif
+
     void setError(QAbstractSocket::SocketError errorCode, const QString &errorString);
     void setErrorAndEmit(QAbstractSocket::SocketError errorCode, const QString &errorString);
 
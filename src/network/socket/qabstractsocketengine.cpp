@@ -259,6 +259,110 @@ void QAbstractSocketEngine::setPeerPort(quint16 port)
     d_func()->peerPort = port;
 }
 
+/*
+    Writes the \a count blocks of data in \a chunks to the socket, in order,
+    and returns the number of bytes written, or -1 if an error occurred
+    before anything was written.
+
+    The default implementation calls write() once per block, and stops at
+    the first block that was not written completely; engines that can send
+    several blocks at once reimplement it.
+*/
+qint64 QAbstractSocketEngine::writeChunks(const QByteArrayView *chunks, qsizetype count)
+{
+    qint64 total = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        const qint64 written = write(chunks[i].data(), chunks[i].size());
+        if (written < 0)
+            return total ? total : written;
+        total += written;
+        if (written < chunks[i].size())
+            break;
+    }
+    return total;
+}
+
+#if QT_CONFIG(sendfile)
+/*
+    Returns \c true if the engine can transfer file contents to the socket
+    with sendFile(). The default implementation returns \c false.
+*/
+bool QAbstractSocketEngine::canSendFile() const
+{
+    return false;
+}
+
+/*
+    Sends up to \a len bytes of the file referred to by \a fileDescriptor,
+    starting at \a offset, without copying them through user space. Returns
+    the number of bytes sent, 0 if the operation would block, or -1 if an
+    error occurred.
+
+    The default implementation fails with
+    QAbstractSocket::UnsupportedSocketOperationError.
+*/
+qint64 QAbstractSocketEngine::sendFile(int fileDescriptor, qint64 offset, qint64 len)
+{
+    Q_UNUSED(fileDescriptor);
+    Q_UNUSED(offset);
+    Q_UNUSED(len);
+    setError(QAbstractSocket::UnsupportedSocketOperationError,
+             QAbstractSocket::tr("Operation on socket is not supported"));
+    return -1;
+}
+#endif // QT_CONFIG(sendfile)
+
+#ifndef QT_NO_UDPSOCKET
+/*
+    Reads up to \a count datagrams of at most \a maxlen bytes each into
+    \a datagrams, and returns the number of datagrams read. Returns -1 if an
+    error occurred, and -2 if no datagram was available, before anything was
+    read.
+
+    The default implementation calls readDatagram() once per datagram;
+    engines that can receive several datagrams at once reimplement it.
+*/
+qsizetype QAbstractSocketEngine::readDatagrams(QNetworkDatagramPrivate *datagrams, qsizetype count,
+                                               qint64 maxlen, PacketHeaderOptions options)
+{
+    qsizetype n = 0;
+    for ( ; n < count; ++n) {
+        if (n > 0 && !hasPendingDatagrams())
+            break;
+        QNetworkDatagramPrivate &datagram = datagrams[n];
+        datagram.data.resize(maxlen);
+        const qint64 readBytes = readDatagram(datagram.data.data(), maxlen, &datagram.header,
+                                              options);
+        if (readBytes < 0)
+            return n ? n : qsizetype(readBytes);
+        datagram.data.truncate(readBytes);
+    }
+    return n;
+}
+
+/*
+    Sends the \a count datagrams in \a datagrams and returns how many of
+    them were sent. Returns -1 if an error occurred, and -2 if the operation
+    would block, before anything was sent.
+
+    The default implementation calls writeDatagram() once per datagram;
+    engines that can send several datagrams at once reimplement it.
+*/
+qsizetype QAbstractSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                                qsizetype count)
+{
+    qsizetype n = 0;
+    for ( ; n < count; ++n) {
+        const QNetworkDatagramPrivate *datagram = datagrams[n];
+        const qint64 sent = writeDatagram(datagram->data.constData(), datagram->data.size(),
+                                          datagram->header);
+        if (sent < 0)
+            return n ? n : qsizetype(sent);
+    }
+    return n;
+}
+#endif // QT_NO_UDPSOCKET
+
 int QAbstractSocketEngine::inboundStreamCount() const
 {
     return d_func()->inboundStreamCount;
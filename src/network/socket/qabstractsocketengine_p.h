@@ -141,6 +141,11 @@ public:
 
     virtual qint64 read(char *data, qint64 maxlen) = 0;
     virtual qint64 write(const char *data, qint64 len) = 0;
+    virtual qint64 writeChunks(const QByteArrayView *chunks, qsizetype count);
+#if QT_CONFIG(sendfile)
+    virtual bool canSendFile() const;
+    virtual qint64 sendFile(int fileDescriptor, qint64 offset, qint64 len);
+#endif
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -154,6 +159,10 @@ public:
 
     virtual bool hasPendingDatagrams() const = 0;
     virtual qint64 pendingDatagramSize() const = 0;
+    virtual qsizetype readDatagrams(QNetworkDatagramPrivate *datagrams, qsizetype count,
+                                    qint64 maxlen, PacketHeaderOptions = WantNone);
+    virtual qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                     qsizetype count);
 #endif // QT_NO_UDPSOCKET
 
     virtual qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader *header = nullptr,
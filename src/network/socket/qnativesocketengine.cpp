@@ -842,6 +842,46 @@ qint64 QNativeSocketEngine::pendingDatagramSize() const
 
     return d->nativePendingDatagramSize();
 }
+
+#if QT_CONFIG(sendmmsg)
+/*!
+    Reads up to \a count datagrams of at most \a maxSize bytes each into
+    \a datagrams, using as few system calls as possible. Returns the number
+    of datagrams read, -1 if an error occurred, or -2 if no datagram was
+    pending.
+
+    \sa readDatagram()
+*/
+qsizetype QNativeSocketEngine::readDatagrams(QNetworkDatagramPrivate *datagrams, qsizetype count,
+                                             qint64 maxSize, PacketHeaderOptions options)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::readDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::readDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    return d->nativeReceiveDatagrams(datagrams, count, maxSize, options);
+}
+
+/*!
+    Sends the \a count datagrams in \a datagrams, using as few system calls
+    as possible. Returns the number of datagrams sent, -1 if an error
+    occurred before any datagram was sent, or -2 if the operation would
+    block.
+
+    \sa writeDatagram()
+*/
+qsizetype QNativeSocketEngine::writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                              qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeDatagrams(), -1);
+    Q_CHECK_STATES(QNativeSocketEngine::writeDatagrams(), QAbstractSocket::BoundState,
+                   QAbstractSocket::ConnectedState, -1);
+
+    return d->nativeSendDatagrams(datagrams, count);
+}
+#endif // QT_CONFIG(sendmmsg)
 #endif // QT_NO_UDPSOCKET
 
 /*!
@@ -918,6 +958,48 @@ qint64 QNativeSocketEngine::write(const char *data, qint64 size)
     return d->nativeWrite(data, size);
 }
 
+#if QT_CONFIG(writev)
+/*!
+    Writes the \a count blocks of data in \a chunks to the socket, in order,
+    with a single system call. Returns the number of bytes written, or -1 if
+    an error occurred.
+*/
+qint64 QNativeSocketEngine::writeChunks(const QByteArrayView *chunks, qsizetype count)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::writeChunks(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::writeChunks(), QAbstractSocket::ConnectedState, -1);
+    return d->nativeWriteChunks(chunks, count);
+}
+#endif // QT_CONFIG(writev)
+
+#if QT_CONFIG(sendfile)
+/*!
+    Returns \c true for TCP sockets, whose data can be sent straight from
+    a file with sendFile().
+*/
+bool QNativeSocketEngine::canSendFile() const
+{
+    Q_D(const QNativeSocketEngine);
+    return d->socketType == QAbstractSocket::TcpSocket;
+}
+
+/*!
+    Sends up to \a size bytes of the file referred to by \a fileDescriptor,
+    starting at \a offset, without copying them through user space. Returns
+    the number of bytes sent, 0 if the operation would block, or -1 if an
+    error occurred.
+*/
+qint64 QNativeSocketEngine::sendFile(int fileDescriptor, qint64 offset, qint64 size)
+{
+    Q_D(QNativeSocketEngine);
+    Q_CHECK_VALID_SOCKETLAYER(QNativeSocketEngine::sendFile(), -1);
+    Q_CHECK_STATE(QNativeSocketEngine::sendFile(), QAbstractSocket::ConnectedState, -1);
+    Q_CHECK_TYPE(QNativeSocketEngine::sendFile(), QAbstractSocket::TcpSocket, -1);
+    return d->nativeSendFile(fileDescriptor, offset, size);
+}
+#endif // QT_CONFIG(sendfile)
+
 
 qint64 QNativeSocketEngine::bytesToWrite() const
 {
@@ -146,6 +146,13 @@ public:
 
     qint64 read(char *data, qint64 maxlen) override;
     qint64 write(const char *data, qint64 len) override;
+#if QT_CONFIG(writev)
+    qint64 writeChunks(const QByteArrayView *chunks, qsizetype count) override;
+#endif
+#if QT_CONFIG(sendfile)
+    bool canSendFile() const override;
+    qint64 sendFile(int fileDescriptor, qint64 offset, qint64 len) override;
+#endif
 
 #ifndef QT_NO_UDPSOCKET
 #ifndef QT_NO_NETWORKINTERFACE
@@ -159,6 +166,12 @@ public:
 
     bool hasPendingDatagrams() const override;
     qint64 pendingDatagramSize() const override;
+#if QT_CONFIG(sendmmsg)
+    qsizetype readDatagrams(QNetworkDatagramPrivate *datagrams, qsizetype count, qint64 maxlen,
+                            PacketHeaderOptions = WantNone) override;
+    qsizetype writeDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                             qsizetype count) override;
+#endif
 #endif // QT_NO_UDPSOCKET
 
     qint64 readDatagram(char *data, qint64 maxlen, QIpPacketHeader * = nullptr,
@@ -216,6 +229,10 @@ public:
     LPFN_WSASENDMSG sendmsg;
     LPFN_WSARECVMSG recvmsg;
 #  endif
+#if QT_CONFIG(sendmmsg)
+    // staging area for nativeReceiveDatagrams()
+    QByteArray datagramBuffer;
+#endif
     enum ErrorString {
         NonBlockingInitFailedErrorString,
         BroadcastingInitFailedErrorString,
@@ -277,8 +294,20 @@ public:
     qint64 nativeReceiveDatagram(char *data, qint64 maxLength, QIpPacketHeader *header,
                                  QAbstractSocketEngine::PacketHeaderOptions options);
     qint64 nativeSendDatagram(const char *data, qint64 length, const QIpPacketHeader &header);
+#if QT_CONFIG(sendmmsg)
+    qsizetype nativeReceiveDatagrams(QNetworkDatagramPrivate *datagrams, qsizetype count,
+                                     qint64 maxLength,
+                                     QAbstractSocketEngine::PacketHeaderOptions options);
+    qsizetype nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams, qsizetype count);
+#endif
     qint64 nativeRead(char *data, qint64 maxLength);
     qint64 nativeWrite(const char *data, qint64 length);
+#if QT_CONFIG(writev)
+    qint64 nativeWriteChunks(const QByteArrayView *chunks, qsizetype count);
+#endif
+#if QT_CONFIG(sendfile)
+    qint64 nativeSendFile(int fileDescriptor, qint64 offset, qint64 length);
+#endif
     int nativeSelect(int timeout, bool selectForRead) const;
     int nativeSelect(int timeout, bool checkRead, bool checkWrite,
                      bool *selectForRead, bool *selectForWrite) const;
@@ -62,6 +62,13 @@
 #ifdef Q_OS_INTEGRITY
 #include <sys/uio.h>
 #endif
+#if QT_CONFIG(writev)
+#include <limits.h>
+#include <sys/uio.h>
+#endif
+#if QT_CONFIG(sendfile)
+#include <sys/sendfile.h>
+#endif
 
 #if defined QNATIVESOCKETENGINE_DEBUG
 #include <private/qdebug_p.h>
@@ -905,11 +912,11 @@ qint64 QNativeSocketEnginePrivate::nativePendingDatagramSize() const
     return qint64(recvResult);
 }
 
-qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
-                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+namespace {
+// we use quintptr to force the alignment
+struct ReceiveControlBuffer
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
 #if !defined(IP_PKTINFO) && defined(IP_RECVIF) && defined(Q_OS_BSD4)
                    + CMSG_SPACE(sizeof(sockaddr_dl))
 #endif
@@ -917,116 +924,168 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
                    + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
 #endif
                    + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
 
-    struct msghdr msg;
-    struct iovec vec;
+struct SendControlBuffer
+{
+    quintptr data[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
+#ifndef QT_NO_SCTP
+                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
+#endif
+                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+};
+
+// the storage that a msghdr for one datagram points to
+struct ReceiveMessage
+{
+    iovec vec;
     qt_sockaddr aa;
-    char c;
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
+    ReceiveControlBuffer cbuf;
+};
 
-    // we need to receive at least one byte, even if our user isn't interested in it
-    vec.iov_base = maxSize ? data : &c;
-    vec.iov_len = maxSize ? maxSize : 1;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
+struct SendMessage
+{
+    iovec vec;
+    qt_sockaddr aa;
+    SendControlBuffer cbuf;
+};
+} // unnamed namespace
+
+static void qt_initReceiveMessage(msghdr *msg, ReceiveMessage *storage, char *data, size_t size,
+                                  QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    memset(msg, 0, sizeof(*msg));
+    memset(&storage->aa, 0, sizeof(storage->aa));
+
+    storage->vec.iov_base = data;
+    storage->vec.iov_len = size;
+    msg->msg_iov = &storage->vec;
+    msg->msg_iovlen = 1;
     if (options & QAbstractSocketEngine::WantDatagramSender) {
-        msg.msg_name = &aa;
-        msg.msg_namelen = sizeof(aa);
+        msg->msg_name = &storage->aa;
+        msg->msg_namelen = sizeof(storage->aa);
     }
     if (options & (QAbstractSocketEngine::WantDatagramHopLimit | QAbstractSocketEngine::WantDatagramDestination
                    | QAbstractSocketEngine::WantStreamNumber)) {
-        msg.msg_control = cbuf;
-        msg.msg_controllen = sizeof(cbuf);
+        msg->msg_control = &storage->cbuf;
+        msg->msg_controllen = sizeof(storage->cbuf);
     }
+}
 
-    ssize_t recvResult = 0;
-    do {
-        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
-    } while (recvResult == -1 && errno == EINTR);
-
-    if (recvResult == -1) {
-        switch (errno) {
-#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
-#endif
-        case EAGAIN:
-            // No datagram was available for reading
-            recvResult = -2;
-            break;
-        case ECONNREFUSED:
-            setError(QAbstractSocket::ConnectionRefusedError, ConnectionRefusedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, ReceiveDatagramErrorString);
+static void qt_parseReceivedMessage(msghdr *msg, const ReceiveMessage &storage, quint16 localPort,
+                                    QIpPacketHeader *header)
+{
+    qt_socket_getPortAndAddress(&storage.aa, &header->senderPort, &header->senderAddress);
+    header->destinationPort = localPort;
+    header->endOfRecord = (msg->msg_flags & MSG_EOR) != 0;
+
+    // parse the ancillary data
+    struct cmsghdr *cmsgptr;
+    QT_WARNING_PUSH
+    QT_WARNING_DISABLE_CLANG("-Wsign-compare")
+    for (cmsgptr = CMSG_FIRSTHDR(msg); cmsgptr != nullptr;
+         cmsgptr = CMSG_NXTHDR(msg, cmsgptr)) {
+        QT_WARNING_POP
+        if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
+            in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
+
+            header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
+            header->ifindex = info->ipi6_ifindex;
+            if (header->ifindex)
+                header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
         }
-        if (header)
-            header->clear();
-    } else if (options != QAbstractSocketEngine::WantNone) {
-        Q_ASSERT(header);
-        qt_socket_getPortAndAddress(&aa, &header->senderPort, &header->senderAddress);
-        header->destinationPort = localPort;
-        header->endOfRecord = (msg.msg_flags & MSG_EOR) != 0;
-
-        // parse the ancillary data
-        struct cmsghdr *cmsgptr;
-        QT_WARNING_PUSH
-        QT_WARNING_DISABLE_CLANG("-Wsign-compare")
-        for (cmsgptr = CMSG_FIRSTHDR(&msg); cmsgptr != nullptr;
-             cmsgptr = CMSG_NXTHDR(&msg, cmsgptr)) {
-            QT_WARNING_POP
-            if (cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in6_pktinfo))) {
-                in6_pktinfo *info = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
-
-                header->destinationAddress.setAddress(reinterpret_cast<quint8 *>(&info->ipi6_addr));
-                header->ifindex = info->ipi6_ifindex;
-                if (header->ifindex)
-                    header->destinationAddress.setScopeId(QString::number(info->ipi6_ifindex));
-            }
 
 #ifdef IP_PKTINFO
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
-                in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_PKTINFO
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_pktinfo))) {
+            in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
-                header->ifindex = info->ipi_ifindex;
-            }
+            header->destinationAddress.setAddress(ntohl(info->ipi_addr.s_addr));
+            header->ifindex = info->ipi_ifindex;
+        }
 #else
 #  ifdef IP_RECVDSTADDR
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
-                in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVDSTADDR
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(in_addr))) {
+            in_addr *addr = reinterpret_cast<in_addr *>(CMSG_DATA(cmsgptr));
 
-                header->destinationAddress.setAddress(ntohl(addr->s_addr));
-            }
+            header->destinationAddress.setAddress(ntohl(addr->s_addr));
+        }
 #  endif
 #  if defined(IP_RECVIF) && defined(Q_OS_BSD4)
-            if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
-                    && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
-                sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
-                header->ifindex = sdl->sdl_index;
-            }
+        if (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_RECVIF
+                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sockaddr_dl))) {
+            sockaddr_dl *sdl = reinterpret_cast<sockaddr_dl *>(CMSG_DATA(cmsgptr));
+            header->ifindex = sdl->sdl_index;
+        }
 #  endif
 #endif
 
-            if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
-                    && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
-                        || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
-                static_assert(sizeof(header->hopLimit) == sizeof(int));
-                memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
-            }
+        if (cmsgptr->cmsg_len == CMSG_LEN(sizeof(int))
+                && ((cmsgptr->cmsg_level == IPPROTO_IPV6 && cmsgptr->cmsg_type == IPV6_HOPLIMIT)
+                    || (cmsgptr->cmsg_level == IPPROTO_IP && cmsgptr->cmsg_type == IP_TTL))) {
+            static_assert(sizeof(header->hopLimit) == sizeof(int));
+            memcpy(&header->hopLimit, CMSG_DATA(cmsgptr), sizeof(header->hopLimit));
+        }
 
 #ifndef QT_NO_SCTP
-            if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
-                && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
-                sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
+        if (cmsgptr->cmsg_level == IPPROTO_SCTP && cmsgptr->cmsg_type == SCTP_SNDRCV
+            && cmsgptr->cmsg_len >= CMSG_LEN(sizeof(sctp_sndrcvinfo))) {
+            sctp_sndrcvinfo *rcvInfo = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
 
-                header->streamNumber = int(rcvInfo->sinfo_stream);
-            }
-#endif
+            header->streamNumber = int(rcvInfo->sinfo_stream);
         }
+#endif
+    }
+}
+
+/*
+    Sets the error for a failed recvmsg() and returns the value to report:
+    -2 if no datagram was available, -1 otherwise.
+*/
+static qint64 qt_receiveDatagramError(QNativeSocketEnginePrivate *d)
+{
+    switch (errno) {
+#if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EAGAIN:
+        // No datagram was available for reading
+        return -2;
+    case ECONNREFUSED:
+        d->setError(QAbstractSocket::ConnectionRefusedError,
+                    QNativeSocketEnginePrivate::ConnectionRefusedErrorString);
+        break;
+    default:
+        d->setError(QAbstractSocket::NetworkError,
+                    QNativeSocketEnginePrivate::ReceiveDatagramErrorString);
+    }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxSize, QIpPacketHeader *header,
+                                                         QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    struct msghdr msg;
+    ReceiveMessage storage;
+    char c;
+
+    // we need to receive at least one byte, even if our user isn't interested in it
+    qt_initReceiveMessage(&msg, &storage, maxSize ? data : &c, maxSize ? maxSize : 1, options);
+
+    ssize_t recvResult = 0;
+    do {
+        recvResult = ::recvmsg(socketDescriptor, &msg, 0);
+    } while (recvResult == -1 && errno == EINTR);
+
+    if (recvResult == -1) {
+        recvResult = qt_receiveDatagramError(this);
+        if (header)
+            header->clear();
+    } else if (options != QAbstractSocketEngine::WantNone) {
+        Q_ASSERT(header);
+        qt_parseReceivedMessage(&msg, storage, localPort, header);
     }
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
@@ -1041,37 +1100,28 @@ qint64 QNativeSocketEnginePrivate::nativeReceiveDatagram(char *data, qint64 maxS
     return qint64((maxSize || recvResult < 0) ? recvResult : Q_INT64_C(0));
 }
 
-qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+static void qt_initSendMessage(QNativeSocketEnginePrivate *d, msghdr *msg, SendMessage *storage,
+                               const char *data, qint64 len, const QIpPacketHeader &header)
 {
-    // we use quintptr to force the alignment
-    quintptr cbuf[(CMSG_SPACE(sizeof(struct in6_pktinfo)) + CMSG_SPACE(sizeof(int))
-#ifndef QT_NO_SCTP
-                   + CMSG_SPACE(sizeof(struct sctp_sndrcvinfo))
-#endif
-                   + sizeof(quintptr) - 1) / sizeof(quintptr)];
+    struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(&storage->cbuf);
 
-    struct cmsghdr *cmsgptr = reinterpret_cast<struct cmsghdr *>(cbuf);
-    struct msghdr msg;
-    struct iovec vec;
-    qt_sockaddr aa;
-
-    memset(&msg, 0, sizeof(msg));
-    memset(&aa, 0, sizeof(aa));
-    vec.iov_base = const_cast<char *>(data);
-    vec.iov_len = len;
-    msg.msg_iov = &vec;
-    msg.msg_iovlen = 1;
-    msg.msg_control = &cbuf;
+    memset(msg, 0, sizeof(*msg));
+    memset(&storage->aa, 0, sizeof(storage->aa));
+    storage->vec.iov_base = const_cast<char *>(data);
+    storage->vec.iov_len = len;
+    msg->msg_iov = &storage->vec;
+    msg->msg_iovlen = 1;
+    msg->msg_control = &storage->cbuf;
 
     if (header.destinationPort != 0) {
-        msg.msg_name = &aa.a;
-        setPortAndAddress(header.destinationPort, header.destinationAddress,
-                          &aa, &msg.msg_namelen);
+        msg->msg_name = &storage->aa.a;
+        d->setPortAndAddress(header.destinationPort, header.destinationAddress,
+                             &storage->aa, &msg->msg_namelen);
     }
 
-    if (msg.msg_namelen == sizeof(aa.a6)) {
+    if (msg->msg_namelen == sizeof(storage->aa.a6)) {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_HOPLIMIT;
@@ -1081,7 +1131,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         if (header.ifindex != 0 || !header.senderAddress.isNull()) {
             struct in6_pktinfo *data = reinterpret_cast<in6_pktinfo *>(CMSG_DATA(cmsgptr));
             memset(data, 0, sizeof(*data));
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr->cmsg_level = IPPROTO_IPV6;
             cmsgptr->cmsg_type = IPV6_PKTINFO;
@@ -1093,7 +1143,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
         }
     } else {
         if (header.hopLimit != -1) {
-            msg.msg_controllen += CMSG_SPACE(sizeof(int));
+            msg->msg_controllen += CMSG_SPACE(sizeof(int));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(int));
             cmsgptr->cmsg_level = IPPROTO_IP;
             cmsgptr->cmsg_type = IP_TTL;
@@ -1115,7 +1165,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
             data->s_addr = htonl(header.senderAddress.toIPv4Address());
 #  endif
             cmsgptr->cmsg_level = IPPROTO_IP;
-            msg.msg_controllen += CMSG_SPACE(sizeof(*data));
+            msg->msg_controllen += CMSG_SPACE(sizeof(*data));
             cmsgptr->cmsg_len = CMSG_LEN(sizeof(*data));
             cmsgptr = reinterpret_cast<cmsghdr *>(reinterpret_cast<char *>(cmsgptr) + CMSG_SPACE(sizeof(*data)));
         }
@@ -1126,7 +1176,7 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     if (header.streamNumber != -1) {
         struct sctp_sndrcvinfo *data = reinterpret_cast<sctp_sndrcvinfo *>(CMSG_DATA(cmsgptr));
         memset(data, 0, sizeof(*data));
-        msg.msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
+        msg->msg_controllen += CMSG_SPACE(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_len = CMSG_LEN(sizeof(sctp_sndrcvinfo));
         cmsgptr->cmsg_level = IPPROTO_SCTP;
         cmsgptr->cmsg_type =  SCTP_SNDRCV;
@@ -1135,28 +1185,46 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     }
 #endif
 
-    if (msg.msg_controllen == 0)
-        msg.msg_control = nullptr;
-    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (msg->msg_controllen == 0)
+        msg->msg_control = nullptr;
+}
 
-    if (sentBytes < 0) {
-        switch (errno) {
+/*
+    Sets the error for a failed sendmsg() and returns the value to report:
+    -2 if the operation would block, -1 otherwise.
+*/
+static qint64 qt_sendDatagramError(QNativeSocketEnginePrivate *d)
+{
+    switch (errno) {
 #if defined(EWOULDBLOCK) && EWOULDBLOCK != EAGAIN
-        case EWOULDBLOCK:
+    case EWOULDBLOCK:
 #endif
-        case EAGAIN:
-            sentBytes = -2;
-            break;
-        case EMSGSIZE:
-            setError(QAbstractSocket::DatagramTooLargeError, DatagramTooLargeErrorString);
-            break;
-        case ECONNRESET:
-            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
-            break;
-        default:
-            setError(QAbstractSocket::NetworkError, SendDatagramErrorString);
-        }
+    case EAGAIN:
+        return -2;
+    case EMSGSIZE:
+        d->setError(QAbstractSocket::DatagramTooLargeError,
+                    QNativeSocketEnginePrivate::DatagramTooLargeErrorString);
+        break;
+    case ECONNRESET:
+        d->setError(QAbstractSocket::RemoteHostClosedError,
+                    QNativeSocketEnginePrivate::RemoteHostClosedErrorString);
+        break;
+    default:
+        d->setError(QAbstractSocket::NetworkError,
+                    QNativeSocketEnginePrivate::SendDatagramErrorString);
     }
+    return -1;
+}
+
+qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 len, const QIpPacketHeader &header)
+{
+    struct msghdr msg;
+    SendMessage storage;
+    qt_initSendMessage(this, &msg, &storage, data, len, header);
+
+    ssize_t sentBytes = qt_safe_sendmsg(socketDescriptor, &msg, 0);
+    if (sentBytes < 0)
+        sentBytes = qt_sendDatagramError(this);
 
 #if defined (QNATIVESOCKETENGINE_DEBUG)
     qDebug("QNativeSocketEngine::sendDatagram(%p \"%s\", %lli, \"%s\", %i) == %lli", data,
@@ -1168,6 +1236,96 @@ qint64 QNativeSocketEnginePrivate::nativeSendDatagram(const char *data, qint64 l
     return qint64(sentBytes);
 }
 
+#if QT_CONFIG(sendmmsg)
+// datagrams per recvmmsg()/sendmmsg() call
+static constexpr qsizetype MaxDatagramBatch = 64;
+// Upper bound for the buffer that received datagrams are staged in: enough
+// for a full batch of the largest UDP datagrams, which is what
+// QUdpSocket::receiveDatagrams() asks for by default. The buffer is left
+// uninitialized, so only the pages that the kernel actually writes
+// datagrams into take up memory; for small datagrams, that's the first
+// page of each slot.
+static constexpr qint64 MaxDatagramBufferSize = MaxDatagramBatch * 0x10000;
+
+qsizetype QNativeSocketEnginePrivate::nativeReceiveDatagrams(QNetworkDatagramPrivate *datagrams,
+                                                             qsizetype count, qint64 maxSize,
+                                                             QAbstractSocketEngine::PacketHeaderOptions options)
+{
+    // The datagrams are received into one shared buffer and copied out
+    // afterwards, so that they don't each hold on to maxSize bytes.
+    // We need to receive at least one byte, even if our user isn't
+    // interested in it.
+    const qint64 slotSize = qMax(maxSize, qint64(1));
+    count = qMin(count, MaxDatagramBatch);
+    count = qMax(qMin(count, qsizetype(MaxDatagramBufferSize / slotSize)), qsizetype(1));
+    if (datagramBuffer.size() < slotSize * count)
+        datagramBuffer.resize(slotSize * count);
+
+    mmsghdr msgs[MaxDatagramBatch];
+    ReceiveMessage storage[MaxDatagramBatch];
+    for (qsizetype i = 0; i < count; ++i) {
+        qt_initReceiveMessage(&msgs[i].msg_hdr, &storage[i], datagramBuffer.data() + i * slotSize,
+                              slotSize, options);
+        msgs[i].msg_len = 0;
+    }
+
+    const int received = qt_safe_recvmmsg(socketDescriptor, msgs, uint(count), 0);
+    if (received < 0)
+        return qt_receiveDatagramError(this);
+
+    for (int i = 0; i < received; ++i) {
+        QNetworkDatagramPrivate &datagram = datagrams[i];
+        const qint64 size = maxSize ? qMin(qint64(msgs[i].msg_len), maxSize) : 0;
+        datagram.data = QByteArray(datagramBuffer.constData() + i * slotSize, size);
+        if (options != QAbstractSocketEngine::WantNone)
+            qt_parseReceivedMessage(&msgs[i].msg_hdr, storage[i], localPort, &datagram.header);
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeReceiveDatagrams(%p, %lli, %lli) == %i",
+           datagrams, qint64(count), maxSize, received);
+#endif
+
+    return received;
+}
+
+qsizetype QNativeSocketEnginePrivate::nativeSendDatagrams(const QNetworkDatagramPrivate *const *datagrams,
+                                                          qsizetype count)
+{
+    mmsghdr msgs[MaxDatagramBatch];
+    SendMessage storage[MaxDatagramBatch];
+
+    qsizetype sent = 0;
+    while (sent < count) {
+        const qsizetype batch = qMin(count - sent, MaxDatagramBatch);
+        for (qsizetype i = 0; i < batch; ++i) {
+            const QNetworkDatagramPrivate *datagram = datagrams[sent + i];
+            qt_initSendMessage(this, &msgs[i].msg_hdr, &storage[i], datagram->data.constData(),
+                               datagram->data.size(), datagram->header);
+            msgs[i].msg_len = 0;
+        }
+
+        const int result = qt_safe_sendmmsg(socketDescriptor, msgs, uint(batch), 0);
+        if (result < 0) {
+            // report the error with the next call if some datagrams went out
+            if (sent == 0)
+                return qt_sendDatagramError(this);
+            break;
+        }
+        sent += result;
+        if (result < batch)
+            break;
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendDatagrams(%p, %lli) == %lli",
+           datagrams, qint64(count), qint64(sent));
+#endif
+
+    return sent;
+}
+#endif // QT_CONFIG(sendmmsg)
+
 bool QNativeSocketEnginePrivate::fetchConnectionParameters()
 {
     localPort = 0;
@@ -1332,6 +1490,101 @@ qint64 QNativeSocketEnginePrivate::nativeWrite(const char *data, qint64 len)
 
     return qint64(writtenBytes);
 }
+
+#if QT_CONFIG(writev)
+qint64 QNativeSocketEnginePrivate::nativeWriteChunks(const QByteArrayView *chunks, qsizetype count)
+{
+    Q_Q(QNativeSocketEngine);
+
+    QVarLengthArray<iovec, 32> vectors(qMin(count, qsizetype(IOV_MAX)));
+    for (qsizetype i = 0; i < vectors.size(); ++i) {
+        vectors[i].iov_base = const_cast<char *>(chunks[i].data());
+        vectors[i].iov_len = size_t(chunks[i].size());
+    }
+
+    // writev() has no MSG_NOSIGNAL equivalent
+    qt_ignore_sigpipe();
+    ssize_t writtenBytes;
+    EINTR_LOOP(writtenBytes, ::writev(socketDescriptor, vectors.constData(), int(vectors.size())));
+
+    if (writtenBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            writtenBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+#if EWOULDBLOCK-0 && EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            writtenBytes = 0;
+            break;
+        default:
+            setError(QAbstractSocket::UnknownSocketError, WriteErrorString);
+            break;
+        }
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeWriteChunks(%p, %lld) == %lld", chunks,
+           qint64(count), qint64(writtenBytes));
+#endif
+
+    return qint64(writtenBytes);
+}
+#endif // QT_CONFIG(writev)
+
+#if QT_CONFIG(sendfile)
+qint64 QNativeSocketEnginePrivate::nativeSendFile(int fileDescriptor, qint64 offset, qint64 length)
+{
+    Q_Q(QNativeSocketEngine);
+
+    // Linux transfers at most 0x7ffff000 bytes per call
+    constexpr qint64 MaxSendFileChunk = 0x7ffff000;
+    off_t fileOffset = off_t(offset);
+
+    // sendfile() has no MSG_NOSIGNAL equivalent
+    qt_ignore_sigpipe();
+    ssize_t sentBytes;
+    EINTR_LOOP(sentBytes, ::sendfile(socketDescriptor, fileDescriptor, &fileOffset,
+                                     size_t(qMin(length, MaxSendFileChunk))));
+
+    if (sentBytes < 0) {
+        switch (errno) {
+        case EPIPE:
+        case ECONNRESET:
+            sentBytes = -1;
+            setError(QAbstractSocket::RemoteHostClosedError, RemoteHostClosedErrorString);
+            q->close();
+            break;
+#if EWOULDBLOCK-0 && EWOULDBLOCK != EAGAIN
+        case EWOULDBLOCK:
+#endif
+        case EAGAIN:
+            sentBytes = 0;
+            break;
+        default:
+            sentBytes = -1;
+            setError(QAbstractSocket::UnknownSocketError, WriteErrorString);
+            break;
+        }
+    } else if (sentBytes == 0 && length > 0) {
+        // the file shrank underneath us
+        sentBytes = -1;
+        setError(QAbstractSocket::UnknownSocketError, WriteErrorString);
+    }
+
+#if defined (QNATIVESOCKETENGINE_DEBUG)
+    qDebug("QNativeSocketEnginePrivate::nativeSendFile(%d, %lld, %lld) == %lld", fileDescriptor,
+           offset, length, qint64(sentBytes));
+#endif
+
+    return qint64(sentBytes);
+}
+#endif // QT_CONFIG(sendfile)
+
 /*
 */
 qint64 QNativeSocketEnginePrivate::nativeRead(char *data, qint64 maxSize)
@@ -102,6 +102,7 @@
 #include "qnetworkdatagram.h"
 #include "qnetworkinterface.h"
 #include "qabstractsocket_p.h"
+#include "qvarlengtharray.h"
 
 QT_BEGIN_NAMESPACE
 
@@ -431,6 +432,62 @@ qint64 QUdpSocket::writeDatagram(const QNetworkDatagram &datagram)
     return sent;
 }
 
+/*!
+    \since 6.4
+
+    Sends the datagrams in \a datagrams, like writeDatagram() does for each of
+    them, and returns the number of datagrams that were sent. Where the
+    operating system supports it, several datagrams are sent with a single
+    system call, which is considerably cheaper than calling writeDatagram()
+    in a loop when sending many small datagrams.
+
+    If not all datagrams could be sent, the return value tells how many of
+    the first datagrams went out. If none was sent because of an error,
+    this function returns -1 and errorOccurred() is emitted; the error is
+    QAbstractSocket::TemporaryError if the socket's send buffer was full. The
+    bytesWritten() signal is emitted once with the total size of the
+    datagrams that were sent.
+
+    \sa writeDatagram(), receiveDatagrams()
+*/
+qsizetype QUdpSocket::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    Q_D(QUdpSocket);
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::writeDatagrams(%lld)", qint64(datagrams.size()));
+#endif
+    if (datagrams.isEmpty())
+        return 0;
+    if (!d->doEnsureInitialized(QHostAddress::Any, 0, datagrams.constFirst().destinationAddress()))
+        return -1;
+    if (state() == UnconnectedState)
+        bind();
+
+    QVarLengthArray<const QNetworkDatagramPrivate *, 64> privates;
+    privates.reserve(datagrams.size());
+    for (const QNetworkDatagram &datagram : datagrams)
+        privates.append(datagram.d);
+
+    qsizetype sent = d->socketEngine->writeDatagrams(privates.constData(), privates.size());
+    d->cachedSocketDescriptor = d->socketEngine->socketDescriptor();
+
+    if (sent >= 0) {
+        qint64 bytes = 0;
+        for (qsizetype i = 0; i < sent; ++i)
+            bytes += privates.at(i)->data.size();
+        emit bytesWritten(bytes);
+    } else {
+        if (sent == -2) {
+            // Socket engine reports EAGAIN. Treat as a temporary error.
+            d->setErrorAndEmit(QAbstractSocket::TemporaryError,
+                               tr("Unable to send a datagram"));
+            return -1;
+        }
+        d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+    }
+    return sent;
+}
+
 /*!
     \since 5.8
 
@@ -476,6 +533,66 @@ QNetworkDatagram QUdpSocket::receiveDatagram(qint64 maxSize)
     return result;
 }
 
+/*!
+    \since 6.4
+
+    Receives up to \a maxCount pending datagrams, each no larger than
+    \a maxSize bytes, and returns them along with their sender's and
+    destination's addresses and ports, like receiveDatagram() does. Where the
+    operating system supports it, several datagrams are received with a
+    single system call, which is considerably cheaper than calling
+    receiveDatagram() in a loop when receiving many small datagrams.
+
+    Returns an empty list if no datagram is pending. If an error occurs
+    before any datagram was received, errorOccurred() is emitted.
+
+    Datagrams larger than \a maxSize are truncated. If \a maxSize is -1
+    (the default), datagrams of up to 65535 bytes are received in full. The
+    socket then keeps a staging buffer with room for a batch of such
+    datagrams, though only the parts of it that datagrams were received
+    into use physical memory. Pass the largest size you expect instead to
+    keep that buffer small.
+
+    \sa receiveDatagram(), writeDatagrams(), hasPendingDatagrams()
+*/
+QList<QNetworkDatagram> QUdpSocket::receiveDatagrams(qsizetype maxCount, qint64 maxSize)
+{
+    Q_D(QUdpSocket);
+
+#if defined QUDPSOCKET_DEBUG
+    qDebug("QUdpSocket::receiveDatagrams(%lld, %lld)", qint64(maxCount), maxSize);
+#endif
+    QT_CHECK_BOUND("QUdpSocket::receiveDatagrams()", QList<QNetworkDatagram>());
+
+    // the largest payload a UDP header can describe
+    if (maxSize < 0)
+        maxSize = 0xffff;
+
+    QList<QNetworkDatagram> result;
+    QVarLengthArray<QNetworkDatagramPrivate, 64> batch;
+    while (result.size() < maxCount) {
+        batch.resize(qMin(maxCount - result.size(), qsizetype(64)));
+        const qsizetype received = d->socketEngine->readDatagrams(batch.data(), batch.size(),
+                                                                  maxSize,
+                                                                  QAbstractSocketEngine::WantAll);
+        if (received <= 0) {
+            if (received == -1 && result.isEmpty())
+                d->setErrorAndEmit(d->socketEngine->error(), d->socketEngine->errorString());
+            break;
+        }
+        result.reserve(result.size() + received);
+        for (qsizetype i = 0; i < received; ++i)
+            result.append(QNetworkDatagram(*new QNetworkDatagramPrivate(std::move(batch[i]))));
+        // the engine may return fewer datagrams than asked for even if more
+        // are pending, so keep going until it reports that none are left
+        batch.clear();
+    }
+
+    d->hasPendingData = false;
+    d->socketEngine->setReadNotificationEnabled(true);
+    return result;
+}
+
 /*!
     Receives a datagram no larger than \a maxSize bytes and stores
     it in \a data. The sender's host address and port is stored in
@@ -145,6 +145,9 @@ protected:
     QVariant lastInsertId() const override;
     bool prepare(const QString &query) override;
     bool exec() override;
+#ifdef LIBPQ_HAS_PIPELINING
+    bool execBatch(bool arrayBind = false) override;
+#endif
 };
 
 class QPSQLDriverPrivate final : public QSqlDriverPrivate
@@ -162,6 +165,7 @@ public:
     mutable bool pendingNotifyCheck = false;
     bool hasBackslashEscape = false;
     bool isUtf8 = false;
+    bool pipelineBatch = false;
 
     void appendTables(QStringList &tl, QSqlQuery &t, QChar type);
     PGresult *exec(const char *stmt);
@@ -178,6 +182,10 @@ public:
     void setDatestyle();
     void setByteaOutput();
     void detectBackslashEscape();
+    void initSession();
+#ifdef LIBPQ_HAS_PIPELINING
+    void resetConnection();
+#endif
     mutable QHash<int, QString> oidToTable;
 };
 
@@ -304,6 +312,9 @@ public:
     bool preparedQueriesEnabled = false;
 
     bool processResults();
+#ifdef LIBPQ_HAS_PIPELINING
+    bool fetchPipelineResult();
+#endif
 };
 
 static QSqlError qMakeError(const QString &err, QSqlError::ErrorType type,
@@ -366,6 +377,35 @@ bool QPSQLResultPrivate::processResults()
     return false;
 }
 
+#ifdef LIBPQ_HAS_PIPELINING
+bool QPSQLResultPrivate::fetchPipelineResult()
+{
+    Q_Q(QPSQLResult);
+    // In pipeline mode the results of each statement are terminated by a nullptr
+    PGresult *next = PQgetResult(drv_d_func()->connection);
+    bool ok = false;
+    switch (PQresultStatus(next)) {
+    case PGRES_COMMAND_OK:
+    case PGRES_TUPLES_OK:
+        if (result)
+            PQclear(result);
+        result = next;
+        ok = true;
+        break;
+    default:
+        q->setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                        "Unable to execute statement"), QSqlError::StatementError, drv_d_func(), next));
+        PQclear(next);
+        break;
+    }
+    if (next) {
+        while (PGresult *extra = PQgetResult(drv_d_func()->connection))
+            PQclear(extra);
+    }
+    return ok;
+}
+#endif
+
 static QMetaType qDecodePSQLType(int t)
 {
     int type = QMetaType::UnknownType;
@@ -939,6 +979,118 @@ bool QPSQLResult::exec()
     return d->processResults();
 }
 
+#ifdef LIBPQ_HAS_PIPELINING
+// Number of statements sent before collecting the results of the previous batch
+static const qsizetype PipelineWindowSize = 256;
+
+bool QPSQLResult::execBatch(bool arrayBind)
+{
+    Q_D(QPSQLResult);
+    if (!d->drv_d_func()->pipelineBatch || !d->preparedQueriesEnabled
+        || d->preparedStmtId.isEmpty()) {
+        return QSqlResult::execBatch(arrayBind);
+    }
+
+    const QList<QVariant> values = boundValues();
+    if (values.isEmpty())
+        return false;
+    QList<QVariantList> columns;
+    columns.reserve(values.size());
+    for (qsizetype i = 0; i < values.size(); ++i) {
+        // output parameters need one round trip per statement
+        if (bindValueType(i) & QSql::Out)
+            return QSqlResult::execBatch(arrayBind);
+        columns.append(values.at(i).toList());
+    }
+    const qsizetype rowCount = columns.at(0).size();
+
+    cleanup();
+    QPSQLDriverPrivate *drv = d->drv_d_func();
+    PGconn *connection = drv->connection;
+
+    // Discard any prior query results that the application didn't eat.
+    drv->discardResults();
+    drv->currentStmtId = drv->generateStatementId();
+    if (!PQenterPipelineMode(connection)) {
+        setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                "Unable to send query"), QSqlError::StatementError, drv));
+        return false;
+    }
+
+    // Keep up to two windows of statements in flight: while the server
+    // executes one, we collect the results of the previous one.
+    QList<QVariant> row(columns.size());
+    qsizetype sent = 0;
+    qsizetype received = 0;
+    bool ok = true;
+    while (ok && sent < rowCount) {
+        const qsizetype windowEnd = qMin(sent + PipelineWindowSize, rowCount);
+        for (; sent < windowEnd; ++sent) {
+            for (qsizetype i = 0; i < columns.size(); ++i)
+                row[i] = columns.at(i).value(sent);
+            const QString params = qCreateParamString(row, driver());
+            const QString stmt = QStringLiteral("EXECUTE %1 (%2)").arg(d->preparedStmtId, params);
+            const QByteArray encodedStmt = drv->isUtf8 ? stmt.toUtf8() : stmt.toLocal8Bit();
+            if (!PQsendQueryParams(connection, encodedStmt.constData(), 0, nullptr, nullptr,
+                                   nullptr, nullptr, 0)) {
+                setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                        "Unable to send query"), QSqlError::StatementError, drv));
+                ok = false;
+                break;
+            }
+        }
+        if (ok && (!PQsendFlushRequest(connection) || PQflush(connection) < 0)) {
+            setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                    "Unable to send query"), QSqlError::StatementError, drv));
+            ok = false;
+        }
+        while (ok && received + PipelineWindowSize < sent) {
+            ok = d->fetchPipelineResult();
+            ++received;
+        }
+    }
+
+    // The statements up to the sync point run in one implicit transaction;
+    // a failing statement makes the server skip all the following ones.
+    const bool synced = PQpipelineSync(connection);
+    if (synced) {
+        while (ok && received < sent) {
+            ok = d->fetchPipelineResult();
+            ++received;
+        }
+        // Skip the statements aborted by an error, up to the sync point. Two
+        // nullptr results in a row mean that nothing is left in the pipeline.
+        int nullResults = 0;
+        while (nullResults < 2) {
+            PGresult *result = PQgetResult(connection);
+            if (!result) {
+                ++nullResults;
+                continue;
+            }
+            nullResults = 0;
+            const bool synced = PQresultStatus(result) == PGRES_PIPELINE_SYNC;
+            PQclear(result);
+            if (synced)
+                break;
+        }
+    }
+    if (!synced || !PQexitPipelineMode(connection)) {
+        // Without a sync point, the server keeps the implicit transaction
+        // open and the remaining results can't be drained; libpq refuses
+        // to leave pipeline mode then. Start over with a new session.
+        setLastError(qMakeError(QCoreApplication::translate("QPSQLResult",
+                                "Unable to send query"), QSqlError::ConnectionError, drv));
+        drv->resetConnection();
+        ok = false;
+    }
+    drv->checkPendingNotifications();
+
+    setSelect(false);
+    setActive(ok);
+    return ok;
+}
+#endif // LIBPQ_HAS_PIPELINING
+
 ///////////////////////////////////////////////////////////////////
 
 bool QPSQLDriverPrivate::setEncodingUtf8()
@@ -989,6 +1141,35 @@ void QPSQLDriverPrivate::detectBackslashEscape()
     }
 }
 
+void QPSQLDriverPrivate::initSession()
+{
+    pro = getPSQLVersion();
+    detectBackslashEscape();
+    isUtf8 = setEncodingUtf8();
+    setDatestyle();
+    setByteaOutput();
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+void QPSQLDriverPrivate::resetConnection()
+{
+    Q_Q(QPSQLDriver);
+    PQreset(connection);
+    if (PQstatus(connection) != CONNECTION_OK)
+        return;
+    initSession();
+
+    // The new session has a new socket and no subscriptions
+    if (sn) {
+        delete sn;
+        sn = nullptr;
+        const QStringList names = std::exchange(seid, {});
+        for (const QString &name : names)
+            q->subscribeToNotification(name);
+    }
+}
+#endif
+
 static QPSQLDriver::Protocol qMakePSQLVersion(int vMaj, int vMin)
 {
     switch (vMaj) {
@@ -1166,6 +1347,11 @@ bool QPSQLDriver::hasFeature(DriverFeature f) const
     case PositionalPlaceholders:
         return d->pro >= QPSQLDriver::Version8_2;
     case BatchOperations:
+#ifdef LIBPQ_HAS_PIPELINING
+        return d->pipelineBatch && d->pro >= QPSQLDriver::Version8_2;
+#else
+        return false;
+#endif
     case NamedPlaceholders:
     case SimpleLocking:
     case FinishQuery:
@@ -1213,9 +1399,20 @@ bool QPSQLDriver::open(const QString &db,
         connectString.append(" port="_L1).append(qQuote(QString::number(port)));
 
     // add any connect options - the server will handle error detection
-    if (!connOpts.isEmpty()) {
-        QString opt = connOpts;
-        opt.replace(';'_L1, ' '_L1, Qt::CaseInsensitive);
+    static const auto pipelineBatchConnectOption = "QPSQL_PIPELINE_BATCH"_L1;
+    d->pipelineBatch = false;
+    const QStringList opts = connOpts.split(u';', Qt::SkipEmptyParts);
+    for (const QString &option : opts) {
+        const QString opt = option.trimmed();
+        if (opt == pipelineBatchConnectOption) {
+#ifdef LIBPQ_HAS_PIPELINING
+            d->pipelineBatch = true;
+#else
+            qWarning("QPSQLDriver::open: %s needs libpq 14 or later, ignoring",
+                     pipelineBatchConnectOption.data());
+#endif
+            continue;
+        }
         connectString.append(u' ').append(opt);
     }
 
@@ -1228,11 +1425,7 @@ bool QPSQLDriver::open(const QString &db,
         return false;
     }
 
-    d->pro = d->getPSQLVersion();
-    d->detectBackslashEscape();
-    d->isUtf8 = d->setEncodingUtf8();
-    d->setDatestyle();
-    d->setByteaOutput();
+    d->initSession();
 
     setOpen(true);
     setOpenError(false);
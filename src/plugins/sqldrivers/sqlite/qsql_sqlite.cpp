@@ -39,6 +39,7 @@
 
 #include "qsql_sqlite_p.h"
 
+#include <qcache.h>
 #include <qcoreapplication.h>
 #include <qdatetime.h>
 #include <qdebug.h>
@@ -52,7 +53,6 @@
 #include <qstringlist.h>
 #include <qvariant.h>
 #if QT_CONFIG(regularexpression)
-#include <qcache.h>
 #include <qregularexpression.h>
 #endif
 #include <QScopedValueRollback>
@@ -144,6 +144,16 @@ protected:
     void virtual_hook(int id, void *data) override;
 };
 
+// An idle prepared statement, owned by the statement cache
+struct QSQLiteCachedStatement
+{
+    Q_DISABLE_COPY_MOVE(QSQLiteCachedStatement)
+    explicit QSQLiteCachedStatement(sqlite3_stmt *stmt) : stmt(stmt) {}
+    ~QSQLiteCachedStatement() { sqlite3_finalize(stmt); }
+
+    sqlite3_stmt *stmt;
+};
+
 class QSQLiteDriverPrivate : public QSqlDriverPrivate
 {
     Q_DECLARE_PUBLIC(QSQLiteDriver)
@@ -153,8 +163,41 @@ public:
     sqlite3 *access = nullptr;
     QList<QSQLiteResult *> results;
     QStringList notificationid;
+
+    sqlite3_stmt *takeCachedStatement(const QString &query);
+    void recycleStatement(const QString &query, sqlite3_stmt *stmt);
+
+    // statements that are not in use by any result, keyed by query text
+    QCache<QString, QSQLiteCachedStatement> statementCache{0};
+    qint64 statementCacheHits = 0;
+    qint64 statementCacheMisses = 0;
 };
 
+sqlite3_stmt *QSQLiteDriverPrivate::takeCachedStatement(const QString &query)
+{
+    if (statementCache.maxCost() <= 0)
+        return nullptr;
+
+    QSQLiteCachedStatement *cached = statementCache.take(query);
+    if (!cached) {
+        ++statementCacheMisses;
+        return nullptr;
+    }
+    ++statementCacheHits;
+    sqlite3_stmt *stmt = qExchange(cached->stmt, nullptr);
+    delete cached;
+    return stmt;
+}
+
+void QSQLiteDriverPrivate::recycleStatement(const QString &query, sqlite3_stmt *stmt)
+{
+    // Reset right away, so that an idle statement holds no locks and no
+    // pointers into bound values that may go away.
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    statementCache.insert(query, new QSQLiteCachedStatement(stmt));
+}
+
 
 class QSQLiteResultPrivate : public QSqlCachedResultPrivate
 {
@@ -170,6 +213,8 @@ public:
     void finalize();
 
     sqlite3_stmt *stmt = nullptr;
+    // query text of stmt if it may go back to the statement cache
+    QString cacheKey;
     QSqlRecord rInf;
     QList<QVariant> firstRow;
     bool skippedStatus = false; // the status of the fetchNext() that's skipped
@@ -193,8 +238,13 @@ void QSQLiteResultPrivate::finalize()
     if (!stmt)
         return;
 
-    sqlite3_finalize(stmt);
+    QSQLiteDriverPrivate *drv = const_cast<QSQLiteDriverPrivate *>(drv_d_func());
+    if (drv && !cacheKey.isNull() && drv->statementCache.maxCost() > 0)
+        drv->recycleStatement(cacheKey, stmt);
+    else
+        sqlite3_finalize(stmt);
     stmt = 0;
+    cacheKey.clear();
 }
 
 void QSQLiteResultPrivate::initColumns(bool emptyResultset)
@@ -387,6 +437,13 @@ bool QSQLiteResult::prepare(const QString &query)
 
     setSelect(false);
 
+    QSQLiteDriverPrivate *drv = const_cast<QSQLiteDriverPrivate *>(d->drv_d_func());
+    d->stmt = drv->takeCachedStatement(query);
+    if (d->stmt) {
+        d->cacheKey = query;
+        return true;
+    }
+
     const void *pzTail = nullptr;
     const auto size = int((query.size() + 1) * sizeof(QChar));
 
@@ -409,6 +466,7 @@ bool QSQLiteResult::prepare(const QString &query)
         d->finalize();
         return false;
     }
+    d->cacheKey = query;
     return true;
 }
 
@@ -727,6 +785,8 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
     bool openReadOnlyOption = false;
     bool openUriOption = false;
     bool useExtendedResultCodes = true;
+    static const auto statementCacheSizeConnectOption = "QSQLITE_STMT_CACHE_SIZE"_L1;
+    int statementCacheSize = 0;
 #if QT_CONFIG(regularexpression)
     static const auto regexpConnectOption = "QSQLITE_ENABLE_REGEXP"_L1;
     bool defineRegexp = false;
@@ -752,6 +812,14 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
             sharedCache = true;
         } else if (option == "QSQLITE_NO_USE_EXTENDED_RESULT_CODES"_L1) {
             useExtendedResultCodes = false;
+        } else if (option.startsWith(statementCacheSizeConnectOption)) {
+            option = option.mid(statementCacheSizeConnectOption.size()).trimmed();
+            if (option.startsWith(u'=')) {
+                bool ok;
+                const int size = option.mid(1).trimmed().toInt(&ok);
+                if (ok && size >= 0)
+                    statementCacheSize = size;
+            }
         }
 #if QT_CONFIG(regularexpression)
         else if (option.startsWith(regexpConnectOption)) {
@@ -783,6 +851,9 @@ bool QSQLiteDriver::open(const QString & db, const QString &, const QString &, c
     if (res == SQLITE_OK) {
         sqlite3_busy_timeout(d->access, timeOut);
         sqlite3_extended_result_codes(d->access, useExtendedResultCodes);
+        d->statementCache.setMaxCost(statementCacheSize);
+        d->statementCacheHits = 0;
+        d->statementCacheMisses = 0;
         setOpen(true);
         setOpenError(false);
 #if QT_CONFIG(regularexpression)
@@ -814,6 +885,7 @@ void QSQLiteDriver::close()
     if (isOpen()) {
         for (QSQLiteResult *result : qAsConst(d->results))
             result->d_func()->finalize();
+        d->statementCache.clear();
 
         if (d->access && (d->notificationid.count() > 0)) {
             d->notificationid.clear();
@@ -830,6 +902,45 @@ void QSQLiteDriver::close()
     }
 }
 
+/*!
+    \internal
+    \since 6.4
+
+    Returns the maximum number of prepared statements kept for reuse, as
+    set with the \c QSQLITE_STMT_CACHE_SIZE connect option.
+*/
+int QSQLiteDriver::statementCacheSize() const
+{
+    Q_D(const QSQLiteDriver);
+    return d->statementCache.maxCost();
+}
+
+/*!
+    \internal
+    \since 6.4
+
+    Returns how many times a prepared query was found in the statement cache
+    since the connection was opened.
+*/
+qint64 QSQLiteDriver::statementCacheHits() const
+{
+    Q_D(const QSQLiteDriver);
+    return d->statementCacheHits;
+}
+
+/*!
+    \internal
+    \since 6.4
+
+    Returns how many times a prepared query had to be compiled because it
+    was not in the statement cache since the connection was opened.
+*/
+qint64 QSQLiteDriver::statementCacheMisses() const
+{
+    Q_D(const QSQLiteDriver);
+    return d->statementCacheMisses;
+}
+
 QSqlResult *QSQLiteDriver::createResult() const
 {
     return new QSQLiteResult(this);
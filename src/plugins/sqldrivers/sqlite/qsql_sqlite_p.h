@@ -70,6 +70,9 @@ class Q_EXPORT_SQLDRIVER_SQLITE QSQLiteDriver : public QSqlDriver
 {
     Q_DECLARE_PRIVATE(QSQLiteDriver)
     Q_OBJECT
+    Q_PROPERTY(int statementCacheSize READ statementCacheSize)
+    Q_PROPERTY(qint64 statementCacheHits READ statementCacheHits)
+    Q_PROPERTY(qint64 statementCacheMisses READ statementCacheMisses)
     friend class QSQLiteResultPrivate;
 public:
     explicit QSQLiteDriver(QObject *parent = nullptr);
@@ -97,6 +100,11 @@ public:
     bool subscribeToNotification(const QString &name) override;
     bool unsubscribeFromNotification(const QString &name) override;
     QStringList subscribedToNotifications() const override;
+
+    int statementCacheSize() const;
+    qint64 statementCacheHits() const;
+    qint64 statementCacheMisses() const;
+
 private Q_SLOTS:
     void handleNotification(const QString &tableName, qint64 rowid);
 };
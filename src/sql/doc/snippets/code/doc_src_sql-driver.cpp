@@ -149,3 +149,17 @@ QString connectString = QStringLiteral(
 db.setDatabaseName(connectString);
 //! [39]
 }
+
+
+void statementCache()
+{
+//! [44]
+QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE");
+db.setDatabaseName("/path/to/db.sqlite");
+db.setConnectOptions("QSQLITE_STMT_CACHE_SIZE=64");
+db.open();
+// ... run queries ...
+qDebug() << "statement cache hits:" << db.driver()->property("statementCacheHits").toLongLong()
+         << "misses:" << db.driver()->property("statementCacheMisses").toLongLong();
+//! [44]
+}
@@ -1182,6 +1182,7 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li tty
     \li requiressl
     \li service
+    \li QPSQL_PIPELINE_BATCH
     \endlist
 
     \header \li DB2 \li OCI
@@ -1210,6 +1211,7 @@ QSqlRecord QSqlDatabase::record(const QString& tablename) const
     \li QSQLITE_ENABLE_SHARED_CACHE
     \li QSQLITE_ENABLE_REGEXP
     \li QSQLITE_NO_USE_EXTENDED_RESULT_CODES
+    \li QSQLITE_STMT_CACHE_SIZE
     \endlist
 
     \li
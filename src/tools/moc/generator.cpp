@@ -39,6 +39,7 @@
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qplugin.h>
 #include <QtCore/qstringview.h>
+#include <QtCore/qmath.h>
 
 #include <math.h>
 #include <stdio.h>
@@ -142,6 +143,24 @@ static int aggregateParameterCount(const QList<FunctionDef> &list)
     return sum;
 }
 
+// Builds the hash table of \a names for QMetaObjectPrivate's MemberNameIndex
+static QList<uint> memberNameIndex(const QList<QByteArray> &names)
+{
+    if (names.isEmpty())
+        return {};
+    // keep a third of the buckets empty, so that probing stays short
+    const uint size = qNextPowerOfTwo(quint32(names.count() + names.count() / 2));
+    const uint mask = size - 1;
+    QList<uint> buckets(size, 0);
+    for (int i = 0; i < names.count(); ++i) {
+        uint bucket = QMetaObjectPrivate::memberNameHash(names.at(i)) & mask;
+        while (buckets.at(bucket))
+            bucket = (bucket + 1) & mask;
+        buckets[bucket] = i + 1;
+    }
+    return buckets;
+}
+
 bool Generator::registerableMetaType(const QByteArray &propertyType)
 {
     if (metaTypes.contains(propertyType))
@@ -349,7 +368,21 @@ void Generator::generateCode()
 // build the data array
 //
 
+    QList<QByteArray> methodNames;
+    for (const QList<FunctionDef> *list : { &cdef->signalList, &cdef->slotList, &cdef->methodList }) {
+        for (const FunctionDef &f : *list)
+            methodNames += f.name;
+    }
+    QList<QByteArray> propertyNames;
+    for (const PropertyDef &p : qAsConst(cdef->propertyList))
+        propertyNames += p.name;
+    const QList<uint> methodNameIndex = memberNameIndex(methodNames);
+    const QList<uint> propertyNameIndex = memberNameIndex(propertyNames);
+    const bool hasMemberNameIndex = !methodNameIndex.isEmpty() || !propertyNameIndex.isEmpty();
+
     int index = MetaObjectPrivateFieldCount;
+    if (hasMemberNameIndex)
+        index += 2 + methodNameIndex.count() + propertyNameIndex.count();
     fprintf(out, "static const uint qt_meta_data_%s[] = {\n", qualifiedClassNameIdentifier.constData());
     fprintf(out, "\n // content:\n");
     fprintf(out, "    %4d,       // revision\n", int(QMetaObjectPrivate::OutputRevision));
@@ -387,9 +420,22 @@ void Generator::generateCode()
         // by qdbusxml2cpp which generate code that require that we call qt_metacall for properties
         flags |= PropertyAccessInStaticMetaCall;
     }
+    if (hasMemberNameIndex)
+        flags |= MemberNameIndex;
     fprintf(out, "    %4d,       // flags\n", flags);
     fprintf(out, "    %4d,       // signalCount\n", int(cdef->signalList.count()));
 
+    if (hasMemberNameIndex) {
+        fprintf(out, "\n // member name index: method buckets, property buckets\n");
+        fprintf(out, "    %4d, %4d,\n", int(methodNameIndex.count()), int(propertyNameIndex.count()));
+        for (const QList<uint> *table : { &methodNameIndex, &propertyNameIndex }) {
+            for (int i = 0; i < table->count(); ++i)
+                fprintf(out, "%s%4u,", i % 10 ? " " : (i ? "\n    " : "    "), table->at(i));
+            if (!table->isEmpty())
+                fprintf(out, "\n");
+        }
+    }
+
 
 //
 // Build classinfo array
@@ -43,6 +43,9 @@
 #include <QOperatingSystemVersion>
 #include <QStorageInfo>
 #include <QScopeGuard>
+#if QT_CONFIG(future)
+#include <QFuture>
+#endif
 
 #include <private/qabstractfileengine_p.h>
 #include <private/qfsfileengine_p.h>
@@ -273,6 +276,10 @@ private slots:
     void mapWrittenFile_data();
     void mapWrittenFile();
 
+#if QT_CONFIG(future)
+    void readWriteAsync();
+#endif
+
     void openStandardStreamsFileDescriptors();
     void openStandardStreamsBufferedStreams();
 
@@ -3461,6 +3468,52 @@ static qint64 streamCurrentPosition(FILE *f)
     return 0;
 }
 
+#if QT_CONFIG(future)
+void tst_QFile::readWriteAsync()
+{
+    QTemporaryFile file;
+    QVERIFY2(file.open(), msgOpenFailed(file).constData());
+
+    const QByteArray data("Hello, asynchronous world!");
+    // still buffered in QFileDevice, the asynchronous calls flush it first
+    QCOMPARE(file.write(data), data.size());
+
+    QCOMPARE(file.readAsync(7, 12).result(), QByteArray("asynchronous"));
+    QCOMPARE(file.pos(), data.size());
+
+    QCOMPARE(file.writeAsync(0, "HELLO").result(), qint64(5));
+    QCOMPARE(file.pos(), data.size());
+    QCOMPARE(file.readAsync(0, 100).result(), QByteArray("HELLO, asynchronous world!"));
+
+    // reading at the end of the file is not an error
+    const QByteArray atEnd = file.readAsync(data.size(), 10).result();
+    QVERIFY(atEnd.isEmpty());
+    QVERIFY(!atEnd.isNull());
+
+    // synchronous reads see what was written asynchronously
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.read(5), QByteArray("HELLO"));
+
+    QList<QFuture<QByteArray>> reads;
+    for (int i = 0; i < 1000; ++i)
+        reads.append(file.readAsync(i % data.size(), 1));
+    QList<QFuture<qint64>> writes;
+    for (int i = 0; i < 100; ++i)
+        writes.append(file.writeAsync(data.size() + i, QByteArray(1, char('a' + i % 26))));
+    for (int i = 0; i < reads.size(); ++i)
+        QCOMPARE(reads.at(i).result(), file.readAsync(i % data.size(), 1).result());
+    for (const QFuture<qint64> &write : qAsConst(writes))
+        QCOMPARE(write.result(), qint64(1));
+    QCOMPARE(file.size(), data.size() + 100);
+
+    file.close();
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::readAsync: device not open");
+    QVERIFY(file.readAsync(0, 1).result().isNull());
+    QTest::ignoreMessage(QtWarningMsg, "QFileDevice::writeAsync: device not open");
+    QCOMPARE(file.writeAsync(0, "x").result(), qint64(-1));
+}
+#endif
+
 class MessageHandler {
 public:
     MessageHandler(QtMessageHandler messageHandler = handler)
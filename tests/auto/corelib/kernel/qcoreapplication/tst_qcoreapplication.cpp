@@ -36,6 +36,10 @@
 #include <private/qeventloop_p.h>
 #include <private/qthread_p.h>
 
+#include <memory>
+#include <numeric>
+#include <vector>
+
 #ifdef Q_OS_WIN
 #include <QtCore/qt_windows.h>
 #endif
@@ -1028,6 +1032,122 @@ void tst_QCoreApplication::threadedEventDelivery()
 
 }
 
+class OrderRecorder : public QObject
+{
+public:
+    class OrderEvent : public QEvent
+    {
+    public:
+        OrderEvent(int producer, int value)
+            : QEvent(QEvent::User), producer(producer), value(value)
+        { }
+        int producer;
+        int value;
+    };
+
+    QList<QList<int>> values;
+
+    void record(int producer, int value) { values[producer].append(value); }
+
+    bool event(QEvent *e) override
+    {
+        if (e->type() != QEvent::User)
+            return QObject::event(e);
+        auto *oe = static_cast<OrderEvent *>(e);
+        record(oe->producer, oe->value);
+        return true;
+    }
+};
+
+void tst_QCoreApplication::queuedCallsFromOtherThreads()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    // enough queued calls to overflow the lock-free queue, interleaved with
+    // ordinary events that take the locked path
+    const int producers = 4;
+    const int count = 3000;
+    OrderRecorder recorder;
+    recorder.values.resize(producers);
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int producer = 0; producer < producers; ++producer) {
+        threads.emplace_back(QThread::create([&recorder, producer, count] {
+            for (int i = 0; i < count; ++i) {
+                if (i % 10 == 0) {
+                    QCoreApplication::postEvent(&recorder, new OrderRecorder::OrderEvent(producer, i));
+                } else {
+                    QMetaObject::invokeMethod(&recorder, [&recorder, producer, i] {
+                        recorder.record(producer, i);
+                    }, Qt::QueuedConnection);
+                }
+            }
+        }));
+        threads.back()->start();
+    }
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait(10000));
+
+    QCoreApplication::sendPostedEvents();
+
+    QList<int> expected(count);
+    std::iota(expected.begin(), expected.end(), 0);
+    for (int producer = 0; producer < producers; ++producer)
+        QCOMPARE(recorder.values.at(producer), expected);
+}
+
+void tst_QCoreApplication::moveToThreadWhilePosting()
+{
+    int argc = 1;
+    char *argv[] = { const_cast<char*>(QTest::currentAppName()) };
+    TestApplication app(argc, argv);
+
+    QThread worker;
+    worker.start();
+    const auto cleanup = qScopeGuard([&worker] {
+        worker.quit();
+        worker.wait();
+    });
+
+    // moving objects out of this thread must neither wait for the posters
+    // to pause nor lose the events they post in the meantime
+    const int producers = 2;
+    QAtomicInt stop = 0;
+    QAtomicInt posted = 0;
+    int received = 0;
+    QObject receiver;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int producer = 0; producer < producers; ++producer) {
+        threads.emplace_back(QThread::create([&] {
+            while (!stop.loadRelaxed()) {
+                QMetaObject::invokeMethod(&receiver, [&received] { ++received; },
+                                          Qt::QueuedConnection);
+                posted.ref();
+            }
+        }));
+        threads.back()->start();
+    }
+
+    for (int i = 0; i < 200; ++i) {
+        auto *object = new QObject;
+        QMetaObject::invokeMethod(object, [] { }, Qt::QueuedConnection);
+        object->moveToThread(&worker);
+        object->deleteLater();
+        if (i % 10 == 0)
+            QCoreApplication::sendPostedEvents(&receiver);
+    }
+
+    stop.storeRelaxed(1);
+    for (const auto &thread : threads)
+        QVERIFY(thread->wait(10000));
+
+    QCoreApplication::sendPostedEvents(&receiver);
+    QCOMPARE(received, posted.loadRelaxed());
+}
+
 void tst_QCoreApplication::testTrWithPercantegeAtTheEnd()
 {
     QCoreApplication::translate("testcontext", "this will crash%", "testdisamb", 3);
@@ -63,6 +63,8 @@ private slots:
     void applicationEventFilters_auxThread();
     void threadedEventDelivery_data();
     void threadedEventDelivery();
+    void queuedCallsFromOtherThreads();
+    void moveToThreadWhilePosting();
     void testTrWithPercantegeAtTheEnd();
 #if QT_CONFIG(library)
     void addRemoveLibPaths();
@@ -330,6 +330,9 @@ private slots:
 
     void indexOfMethodPMF();
 
+    void indexOfMemberByName_data();
+    void indexOfMemberByName();
+
     void signalOffset_data();
     void signalOffset();
     void signalCount_data();
@@ -1766,6 +1769,51 @@ void tst_QMetaObject::indexOfMethodPMF()
     INDEXOFMETHODPMF_HELPER(QtTestCustomObject, sig_custom, (const CustomString &))
 }
 
+void tst_QMetaObject::indexOfMemberByName_data()
+{
+    QTest::addColumn<const QMetaObject *>("object");
+
+    QTest::newRow("QObject") << &QObject::staticMetaObject;
+    QTest::newRow("QtTestObject") << &QtTestObject::staticMetaObject;
+    QTest::newRow("QSortFilterProxyModel") << &QSortFilterProxyModel::staticMetaObject;
+    QTest::newRow("tst_QMetaObject") << &tst_QMetaObject::staticMetaObject;
+}
+
+void tst_QMetaObject::indexOfMemberByName()
+{
+    // Every member must be found by its name, whether it is looked up through
+    // the name index that moc generates or by a linear search. A subclass may
+    // redeclare a member, in which case its own one is found.
+    QFETCH(const QMetaObject *, object);
+
+    for (int i = 0; i < object->methodCount(); ++i) {
+        const QMetaMethod method = object->method(i);
+        const QByteArray signature = method.methodSignature();
+        const int index = object->indexOfMethod(signature.constData());
+        QVERIFY2(index >= i, signature.constData());
+        QCOMPARE(object->method(index).methodSignature(), signature);
+        if (method.methodType() == QMetaMethod::Signal)
+            QCOMPARE(object->indexOfSignal(signature.constData()), index);
+        else
+            QCOMPARE(object->indexOfSignal(signature.constData()), -1);
+        if (method.methodType() == QMetaMethod::Slot)
+            QCOMPARE(object->indexOfSlot(signature.constData()), index);
+    }
+
+    for (int i = 0; i < object->propertyCount(); ++i) {
+        const char *name = object->property(i).name();
+        const int index = object->indexOfProperty(name);
+        QVERIFY2(index >= i, name);
+        QCOMPARE(object->property(index).name(), name);
+    }
+
+    QCOMPARE(object->indexOfMethod("noSuchMethod()"), -1);
+    QCOMPARE(object->indexOfSignal("noSuchSignal()"), -1);
+    QCOMPARE(object->indexOfSlot("noSuchSlot()"), -1);
+    QCOMPARE(object->indexOfProperty("noSuchProperty"), -1);
+    QCOMPARE(object->indexOfMethod("deleteLater(int)"), -1);
+}
+
 namespace SignalTestHelper
 {
 // These functions use the public QMetaObject/QMetaMethod API to implement
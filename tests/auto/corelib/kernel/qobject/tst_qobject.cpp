@@ -72,6 +72,7 @@ private slots:
     void connectSlotsByName();
     void connectSignalsToSignalsWithDefaultArguments();
     void receivers();
+    void connectManySignals();
     void normalize();
     void qobject_castTemplate();
     void findChildren();
@@ -2455,6 +2456,93 @@ void tst_QObject::receivers()
     QCOMPARE(object.receivers(SIGNAL(destroyed())), 0);
 }
 
+class ManySignalsObject : public QObject
+{
+    Q_OBJECT
+public:
+    using QObject::receivers;
+    using QObject::isSignalConnected;
+
+signals:
+    void signal0();
+    void signal1();
+    void signal2();
+    void signal3();
+    void signal4();
+    void signal5();
+    void signal6();
+    void signal7();
+    void signal8();
+    void signal9();
+    void signal10();
+    void signal11();
+};
+
+void tst_QObject::connectManySignals()
+{
+    // Connecting to one signal after the other moves the connections from
+    // sparse storage to dense storage; check that none get lost on the way
+    using Signal = void (ManySignalsObject::*)();
+    const Signal signalFunctions[] = {
+        &ManySignalsObject::signal0, &ManySignalsObject::signal1, &ManySignalsObject::signal2,
+        &ManySignalsObject::signal3, &ManySignalsObject::signal4, &ManySignalsObject::signal5,
+        &ManySignalsObject::signal6, &ManySignalsObject::signal7, &ManySignalsObject::signal8,
+        &ManySignalsObject::signal9, &ManySignalsObject::signal10, &ManySignalsObject::signal11
+    };
+    const int signalCount = int(std::size(signalFunctions));
+    const int order[] = { 11, 3, 7, 0, 9, 5, 1, 10, 6, 2, 8, 4 };
+    static_assert(std::size(order) == std::size(signalFunctions));
+
+    ManySignalsObject sender;
+    QList<int> calls(signalCount);
+    auto emitAll = [&] {
+        calls.fill(0);
+        for (Signal signal : signalFunctions)
+            (sender.*signal)();
+    };
+    auto receivers = [&](int i) {
+        const QMetaMethod method = QMetaMethod::fromSignal(signalFunctions[i]);
+        const QByteArray signal = QByteArray::number(QSIGNAL_CODE) + method.methodSignature();
+        return sender.receivers(signal.constData());
+    };
+
+    QList<QMetaObject::Connection> connections(signalCount);
+    for (int n = 0; n < signalCount; ++n) {
+        const int i = order[n];
+        connections[i] = connect(&sender, signalFunctions[i], this, [&calls, i] { ++calls[i]; });
+        QVERIFY(connections.at(i));
+
+        emitAll();
+        for (int j = 0; j < signalCount; ++j) {
+            const bool connected = std::find(order, order + n + 1, j) != order + n + 1;
+            QCOMPARE(calls.at(j), connected ? 1 : 0);
+            QCOMPARE(receivers(j), connected ? 1 : 0);
+            QCOMPARE(sender.isSignalConnected(QMetaMethod::fromSignal(signalFunctions[j])), connected);
+        }
+    }
+
+    // a second connection to a connected signal is added to the same list
+    int extraCalls = 0;
+    connect(&sender, &ManySignalsObject::signal5, this, [&extraCalls] { ++extraCalls; });
+    emitAll();
+    QCOMPARE(calls.at(5), 1);
+    QCOMPARE(extraCalls, 1);
+    QCOMPARE(receivers(5), 2);
+
+    for (int i = 0; i < signalCount; i += 2)
+        QVERIFY(QObject::disconnect(connections.at(i)));
+    emitAll();
+    for (int j = 0; j < signalCount; ++j) {
+        QCOMPARE(calls.at(j), j % 2);
+        QCOMPARE(receivers(j), j % 2 + (j == 5 ? 1 : 0));
+    }
+
+    QVERIFY(sender.disconnect());
+    emitAll();
+    QCOMPARE(calls, QList<int>(signalCount));
+    QCOMPARE(extraCalls, 2);
+}
+
 enum Enum { };
 
 struct Struct { };
@@ -0,0 +1,388 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QSignalSpy>
+#include <QtCore/qset.h>
+#include <QtCore/qsharedmemorychannel.h>
+#include <QtCore/private/qsharedmemorychannel_p.h>
+#include <QtCore/qthread.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSharedMemoryChannel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void createAndAttach();
+    void invalidSizes();
+    void writeAndRead();
+    void reserveAndCommit();
+    void wrapAround();
+    void abandonedReservation();
+    void corruptedSegment();
+    void readyRead();
+    void waitForReadyRead();
+    void multipleProducersAndConsumers();
+
+private:
+    QString uniqueKey() const
+    {
+        return "tst_qsharedmemorychannel_%1_%2"_L1
+                .arg(QString::number(QCoreApplication::applicationPid()),
+                     QLatin1StringView(QTest::currentTestFunction()));
+    }
+};
+
+void tst_QSharedMemoryChannel::createAndAttach()
+{
+    const QString key = uniqueKey();
+    QSharedMemoryChannel attacher(key);
+    QVERIFY(!attacher.attach());
+    QCOMPARE(attacher.error(), QSharedMemoryChannel::NotFound);
+
+    QSharedMemoryChannel creator(key);
+    QVERIFY2(creator.create(5, 100), qPrintable(creator.errorString()));
+    QVERIFY(creator.isAttached());
+    QCOMPARE(creator.slotCount(), 8);
+    QVERIFY(creator.maxMessageSize() >= 100);
+
+    QVERIFY2(attacher.attach(), qPrintable(attacher.errorString()));
+    QCOMPARE(attacher.error(), QSharedMemoryChannel::NoError);
+    QCOMPARE(attacher.slotCount(), creator.slotCount());
+    QCOMPARE(attacher.maxMessageSize(), creator.maxMessageSize());
+    QVERIFY(!attacher.attach());
+    QCOMPARE(attacher.error(), QSharedMemoryChannel::AlreadyExists);
+
+    QSharedMemoryChannel other(key);
+    QVERIFY(!other.create(8, 100));
+    QCOMPARE(other.error(), QSharedMemoryChannel::AlreadyExists);
+
+    QVERIFY(attacher.detach());
+    QVERIFY(!attacher.isAttached());
+    QVERIFY(!attacher.detach());
+
+    // once the owner is gone, the channel can no longer be attached to
+    QVERIFY(creator.detach());
+    QVERIFY(!attacher.attach());
+    QVERIFY(other.create(8, 100));
+
+    QSharedMemoryChannel noKey;
+    QVERIFY(!noKey.create(8, 100));
+    QCOMPARE(noKey.error(), QSharedMemoryChannel::KeyError);
+}
+
+void tst_QSharedMemoryChannel::invalidSizes()
+{
+    QSharedMemoryChannel channel(uniqueKey());
+    QVERIFY(!channel.create(0, 100));
+    QCOMPARE(channel.error(), QSharedMemoryChannel::InvalidSize);
+    QVERIFY(!channel.create(8, -1));
+    QCOMPARE(channel.error(), QSharedMemoryChannel::InvalidSize);
+
+    QVERIFY(channel.create(1, 0));
+    QCOMPARE(channel.slotCount(), 1);
+    QVERIFY(!channel.write(QByteArray(channel.maxMessageSize() + 1, 'x')));
+    QCOMPARE(channel.error(), QSharedMemoryChannel::InvalidSize);
+    QVERIFY(channel.write(QByteArray(channel.maxMessageSize(), 'x')));
+}
+
+void tst_QSharedMemoryChannel::writeAndRead()
+{
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(4, 16), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(producer.key());
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    QVERIFY(!consumer.hasPendingMessages());
+    QVERIFY(consumer.read().isNull());
+    QVERIFY(consumer.beginRead().isNull());
+
+    for (int i = 0; i < 4; ++i)
+        QVERIFY(producer.write(QByteArray::number(i)));
+    QVERIFY(!producer.write("full"));
+    QVERIFY(!producer.reserve(1));
+
+    QVERIFY(consumer.hasPendingMessages());
+    QCOMPARE(consumer.read(), "0");
+    QVERIFY(producer.write("4"));
+    for (int i = 1; i < 5; ++i)
+        QCOMPARE(consumer.read(), QByteArray::number(i));
+    QVERIFY(!consumer.hasPendingMessages());
+
+    // empty messages are not the same as no message
+    QVERIFY(producer.write(QByteArrayView("", 0)));
+    const QByteArrayView empty = consumer.beginRead();
+    QVERIFY(!empty.isNull());
+    QVERIFY(empty.isEmpty());
+    consumer.endRead();
+    QVERIFY(consumer.beginRead().isNull());
+}
+
+void tst_QSharedMemoryChannel::reserveAndCommit()
+{
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(2, 64), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(producer.key());
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    QVERIFY(!producer.commit());
+    char *slot = producer.reserve(5);
+    QVERIFY(slot);
+    QTest::ignoreMessage(QtWarningMsg, "QSharedMemoryChannel::reserve: "
+                                       "The previous reservation was not committed");
+    QVERIFY(!producer.reserve(5));
+
+    // not visible until committed
+    memcpy(slot, "hello", 5);
+    QVERIFY(!consumer.hasPendingMessages());
+    QVERIFY(producer.commit());
+    QVERIFY(!producer.commit());
+
+    const QByteArrayView message = consumer.beginRead();
+    QCOMPARE(message, "hello");
+    QTest::ignoreMessage(QtWarningMsg, "QSharedMemoryChannel::beginRead: "
+                                       "endRead() was not called for the previous message");
+    QVERIFY(consumer.beginRead().isNull());
+
+    // the slot being read is not reused until it is released
+    QVERIFY(producer.write("a"));
+    QVERIFY(!producer.write("b"));
+    consumer.endRead();
+    QVERIFY(producer.write("b"));
+    QCOMPARE(consumer.read(), "a");
+    QCOMPARE(consumer.read(), "b");
+}
+
+void tst_QSharedMemoryChannel::wrapAround()
+{
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(4, 8), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(producer.key());
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    // batches of 0 to 4 messages, so that every slot is used at every fill level
+    for (int i = 0; i < 1000; ++i) {
+        for (int j = 0; j < i % 5; ++j)
+            QVERIFY(producer.write(QByteArray::number(i * 5 + j)));
+        for (int j = 0; j < i % 5; ++j)
+            QCOMPARE(consumer.read(), QByteArray::number(i * 5 + j));
+        QVERIFY(!consumer.hasPendingMessages());
+    }
+}
+
+void tst_QSharedMemoryChannel::abandonedReservation()
+{
+    QSharedMemoryChannel consumer;
+    {
+        QSharedMemoryChannel owner(uniqueKey());
+        QVERIFY2(owner.create(4, 8), qPrintable(owner.errorString()));
+        consumer.setKey(owner.key());
+        QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+        QSharedMemoryChannel producer(owner.key());
+        QVERIFY2(producer.attach(), qPrintable(producer.errorString()));
+        QVERIFY(producer.write("1"));
+        QVERIFY(producer.reserve(1));
+        QVERIFY(owner.write("2"));
+        QCOMPARE(consumer.read(), "1");
+        // blocked by the pending reservation
+        QVERIFY(!consumer.hasPendingMessages());
+
+        QVERIFY(producer.detach());
+        QVERIFY(consumer.hasPendingMessages());
+        QCOMPARE(consumer.read(), "2");
+        QVERIFY(!consumer.hasPendingMessages());
+
+        QVERIFY(owner.write("3"));
+    }
+    // pending messages outlive the owner of the channel
+    QVERIFY(consumer.isAttached());
+    QCOMPARE(consumer.read(), "3");
+}
+
+void tst_QSharedMemoryChannel::corruptedSegment()
+{
+    using namespace QSharedMemoryChannelLayout;
+
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(4, 8), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(producer.key());
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+    const qsizetype slotCount = consumer.slotCount();
+    const qsizetype maxMessageSize = consumer.maxMessageSize();
+    QVERIFY(producer.write("1"));
+    QVERIFY(producer.write("2"));
+
+    // another process scribbling over the segment after we attached
+    QSharedMemory segment("qipc_channel_"_L1 + producer.key());
+    QVERIFY2(segment.attach(), qPrintable(segment.errorString()));
+    auto header = static_cast<Header *>(segment.data());
+    header->slotCount = 1U << 30;
+    header->slotSize = ~0U & ~quint32(CacheLineSize - 1);
+    auto firstSlot = reinterpret_cast<Slot *>(static_cast<char *>(segment.data()) + HeaderSize);
+    firstSlot->size = 1U << 30;
+
+    QCOMPARE(consumer.slotCount(), slotCount);
+    QCOMPARE(consumer.maxMessageSize(), maxMessageSize);
+    QTest::ignoreMessage(QtWarningMsg,
+                         "QSharedMemoryChannel::beginRead: skipping a message of invalid size 1073741824");
+    QCOMPARE(consumer.read(), "2");
+    QVERIFY(!consumer.hasPendingMessages());
+}
+
+void tst_QSharedMemoryChannel::readyRead()
+{
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(16, 8), qPrintable(producer.errorString()));
+    QVERIFY(producer.write("early"));
+
+    QSharedMemoryChannel consumer(producer.key());
+    QSignalSpy spy(&consumer, &QSharedMemoryChannel::readyRead);
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    // messages written before connecting are announced too
+    QTRY_COMPARE(spy.count(), 1);
+    QCOMPARE(consumer.read(), "early");
+
+    QVERIFY(producer.write("a"));
+    QVERIFY(producer.write("b"));
+    QTRY_COMPARE(spy.count(), 2);
+    QCOMPARE(consumer.read(), "a");
+    QCOMPARE(consumer.read(), "b");
+
+    // nothing left, so no signal
+    QTest::qWait(10);
+    QCOMPARE(spy.count(), 2);
+
+    QThread *thread = QThread::create([&] { QVERIFY(producer.write("thread")); });
+    thread->start();
+    QTRY_COMPARE(spy.count(), 3);
+    QVERIFY(thread->wait());
+    delete thread;
+    QCOMPARE(consumer.read(), "thread");
+}
+
+void tst_QSharedMemoryChannel::waitForReadyRead()
+{
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(16, 8), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(producer.key());
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    QVERIFY(!consumer.waitForReadyRead(10));
+
+    QVERIFY(producer.write("now"));
+    QVERIFY(consumer.waitForReadyRead(0));
+    QCOMPARE(consumer.read(), "now");
+
+    QThread *thread = QThread::create([&] {
+        QThread::msleep(50);
+        producer.write("later");
+    });
+    thread->start();
+    QVERIFY(consumer.waitForReadyRead(5000));
+    QCOMPARE(consumer.read(), "later");
+    QVERIFY(thread->wait());
+    delete thread;
+}
+
+void tst_QSharedMemoryChannel::multipleProducersAndConsumers()
+{
+    constexpr int ProducerCount = 4;
+    constexpr int ConsumerCount = 3;
+    constexpr int MessagesPerProducer = 5000;
+
+    QSharedMemoryChannel owner(uniqueKey());
+    QVERIFY2(owner.create(32, sizeof(int) * 2), qPrintable(owner.errorString()));
+
+    QAtomicInt remaining = ProducerCount * MessagesPerProducer;
+    QList<QThread *> threads;
+    for (int p = 0; p < ProducerCount; ++p) {
+        threads << QThread::create([&, p] {
+            QSharedMemoryChannel channel(owner.key());
+            if (!channel.attach())
+                return;
+            for (int i = 0; i < MessagesPerProducer; ) {
+                if (char *slot = channel.reserve(sizeof(int) * 2)) {
+                    const int message[2] = { p, i++ };
+                    memcpy(slot, message, sizeof(message));
+                    channel.commit();
+                } else {
+                    QThread::yieldCurrentThread();
+                }
+            }
+        });
+    }
+
+    QList<QList<int>> received(ConsumerCount * ProducerCount);
+    for (int c = 0; c < ConsumerCount; ++c) {
+        threads << QThread::create([&, c] {
+            QSharedMemoryChannel channel(owner.key());
+            if (!channel.attach())
+                return;
+            while (remaining.loadAcquire() > 0) {
+                const QByteArrayView message = channel.beginRead();
+                if (message.isNull()) {
+                    channel.waitForReadyRead(10);
+                    continue;
+                }
+                int data[2];
+                memcpy(data, message.data(), sizeof(data));
+                channel.endRead();
+                received[c * ProducerCount + data[0]] << data[1];
+                remaining.deref();
+            }
+        });
+    }
+
+    for (QThread *thread : std::as_const(threads))
+        thread->start();
+    for (QThread *thread : std::as_const(threads)) {
+        QVERIFY(thread->wait(60000));
+        delete thread;
+    }
+
+    QCOMPARE(remaining.loadRelaxed(), 0);
+    QVERIFY(!owner.hasPendingMessages());
+    for (int p = 0; p < ProducerCount; ++p) {
+        QSet<int> all;
+        for (int c = 0; c < ConsumerCount; ++c) {
+            // each consumer sees the messages of a producer in order
+            const QList<int> &list = received.at(c * ProducerCount + p);
+            QVERIFY(std::is_sorted(list.cbegin(), list.cend()));
+            for (int i : list)
+                all.insert(i);
+        }
+        QCOMPARE(all.size(), MessagesPerProducer);
+    }
+}
+
+QTEST_MAIN(tst_QSharedMemoryChannel)
+#include "tst_qsharedmemorychannel.moc"
@@ -33,6 +33,7 @@
 #include <QtCore/QCoreApplication>
 #include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
+#include <QtCore/QTemporaryFile>
 #include <QtNetwork/QTcpServer>
 #include <QtNetwork/QTcpSocket>
 #include <QtNetwork/QUdpSocket>
@@ -40,6 +41,7 @@
 #define NATIVESOCKETENGINE QNativeSocketEngine
 #ifdef Q_OS_UNIX
 #include <private/qnet_unix_p.h>
+#include <private/qeventdispatcher_unix_p.h>
 #include <sys/select.h>
 #endif
 #include <limits>
@@ -59,6 +61,9 @@ private slots:
     void mixingWithTimers();
 #ifdef Q_OS_UNIX
     void posixSockets();
+#endif
+#if QT_CONFIG(epoll)
+    void epollDispatcher();
 #endif
     void asyncMultipleDatagram();
     void activationReason_data();
@@ -362,6 +367,95 @@ void tst_QSocketNotifier::posixSockets()
 }
 #endif
 
+#if QT_CONFIG(epoll)
+class ActivationCounter : public QSocketNotifier
+{
+public:
+    ActivationCounter(qintptr socket, Type type)
+        : QSocketNotifier(socket, type)
+    {
+        // driven by a private dispatcher, not by the thread's one
+        setEnabled(false);
+    }
+
+    int activations = 0;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == QEvent::SockAct) {
+            ++activations;
+            return true;
+        }
+        return QSocketNotifier::event(e);
+    }
+};
+
+void tst_QSocketNotifier::epollDispatcher()
+{
+    qputenv("QT_EVENT_DISPATCHER_EPOLL", "1");
+    QEventDispatcherUNIX dispatcher;
+    qunsetenv("QT_EVENT_DISPATCHER_EPOLL");
+
+    int fds[2];
+    QCOMPARE(::pipe(fds), 0);
+
+    ActivationCounter reader(fds[0], QSocketNotifier::Read);
+    ActivationCounter writer(fds[1], QSocketNotifier::Write);
+    dispatcher.registerSocketNotifier(&reader);
+    dispatcher.registerSocketNotifier(&writer);
+
+    // an empty pipe is writable, but not readable
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(reader.activations, 0);
+    QCOMPARE(writer.activations, 1);
+
+    dispatcher.unregisterSocketNotifier(&writer);
+    QCOMPARE(::write(fds[1], "q", 1), 1);
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(reader.activations, 1);
+    QCOMPARE(writer.activations, 1);
+
+    // level-triggered, like poll()
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(reader.activations, 2);
+
+    char c;
+    QCOMPARE(::read(fds[0], &c, 1), 1);
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(reader.activations, 2);
+
+    dispatcher.unregisterSocketNotifier(&reader);
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+
+    // epoll does not support regular files, which poll() reports as always ready
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    ActivationCounter fileReader(file.handle(), QSocketNotifier::Read);
+    dispatcher.registerSocketNotifier(&fileReader);
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(fileReader.activations, 1);
+    dispatcher.unregisterSocketNotifier(&fileReader);
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QCOMPARE(fileReader.activations, 1);
+
+    // epoll refuses closed fds, which poll() reports with POLLNVAL
+    QCOMPARE(::pipe(fds), 0);
+    qt_safe_close(fds[0]);
+    qt_safe_close(fds[1]);
+    ActivationCounter closedReader(fds[0], QSocketNotifier::Read);
+    dispatcher.registerSocketNotifier(&closedReader);
+    const QByteArray warning = "QSocketNotifier: Invalid socket " + QByteArray::number(fds[0])
+                               + " with type Read, disabling...";
+    QTest::ignoreMessage(QtWarningMsg, warning.constData());
+    dispatcher.processEvents(QEventLoop::AllEvents);
+    QVERIFY(!closedReader.isEnabled());
+    QCOMPARE(closedReader.activations, 0);
+    dispatcher.unregisterSocketNotifier(&closedReader);
+}
+#endif
+
 void tst_QSocketNotifier::async_readDatagramSlot()
 {
     char buf[1];
@@ -85,6 +85,7 @@ private slots:
     void timerOrder();
     void timerOrder_data();
     void timerOrderBackgroundThread();
+    void manyTimersFireInOrder();
     void timerOrderBackgroundThread_data() { timerOrder_data(); }
 
     void dontBlockEvents();
@@ -1259,6 +1260,50 @@ void tst_QTimer::timerOrderBackgroundThread()
 #endif
 }
 
+void tst_QTimer::manyTimersFireInOrder()
+{
+    // enough timers with long enough intervals to occupy several levels of
+    // the Unix timer wheel, some of them stopped or restarted
+    constexpr int count = 150;
+    QObject parent;
+    QList<QTimer *> timers;
+    QList<int> fired;
+    QList<int> early;
+    QElapsedTimer elapsed;
+    elapsed.start();
+
+    for (int i = 0; i < count; ++i) {
+        const int interval = (i * 37) % count * 5; // distinct, in random order
+        auto *timer = new QTimer(&parent);
+        timer->setTimerType(Qt::PreciseTimer);
+        timer->setSingleShot(true);
+        timer->setInterval(interval);
+        connect(timer, &QTimer::timeout, timer, [&, interval] {
+            if (elapsed.elapsed() < interval)
+                early << interval;
+            fired << interval;
+        });
+        timer->start();
+        timers << timer;
+    }
+
+    QList<int> expected;
+    for (int i = 0; i < count; ++i) {
+        if (i % 5 == 4) {
+            timers.at(i)->stop();
+            continue;
+        }
+        if (i % 2)
+            timers.at(i)->start();
+        expected << timers.at(i)->interval();
+    }
+    std::sort(expected.begin(), expected.end());
+
+    QTRY_COMPARE_WITH_TIMEOUT(fired.size(), expected.size(), 5000);
+    QCOMPARE(fired, expected);
+    QVERIFY2(early.isEmpty(), QTest::toString(early));
+}
+
 struct StaticSingleShotUser
 {
     StaticSingleShotUser()
@@ -30,7 +30,13 @@
 #include <QtCore/qdir.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qplugin.h>
+#include <QtCore/qpluginloader.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qtemporarydir.h>
 #include <private/qfactoryloader_p.h>
+#if QT_CONFIG(library)
+#include <private/qpluginmetadatacache_p.h>
+#endif
 #include "plugin1/plugininterface1.h"
 #include "plugin2/plugininterface2.h"
 
@@ -54,6 +60,7 @@ public slots:
 private slots:
     void usingTwoFactoriesFromSameDir();
     void extraSearchPath();
+    void metaDataCache();
 };
 
 static const char binFolderC[] = "bin";
@@ -134,5 +141,85 @@ void tst_QFactoryLoader::extraSearchPath()
 #endif
 }
 
+void tst_QFactoryLoader::metaDataCache()
+{
+#if !QT_CONFIG(library) || defined(Q_OS_ANDROID)
+    QSKIP("Test not applicable in this configuration.");
+#else
+    auto findPlugin = [this](const char *name) {
+        const QFileInfoList candidates =
+                QDir(binFolder).entryInfoList({ u'*' + QLatin1String(name) + u'*' }, QDir::Files);
+        for (const QFileInfo &fi : candidates) {
+            if (QLibrary::isLibrary(fi.fileName()))
+                return fi.absoluteFilePath();
+        }
+        return QString();
+    };
+    const QString plugin1 = findPlugin("plugin1");
+    const QString plugin2 = findPlugin("plugin2");
+    QVERIFY(!plugin1.isEmpty());
+    QVERIFY(!plugin2.isEmpty());
+
+    QTemporaryDir tempDir;
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    const QString cacheFile = tempDir.filePath("cache/plugins.cbor");
+    const QString pluginDir = tempDir.filePath("plugins");
+    const QString pluginFile = pluginDir + u'/' + QFileInfo(plugin1).fileName();
+    QVERIFY(QDir().mkpath(pluginDir));
+    QVERIFY(QFile::copy(plugin1, pluginFile));
+
+    qputenv("QT_PLUGIN_METADATA_CACHE", QFile::encodeName(cacheFile));
+    auto cleanup = qScopeGuard([] { qunsetenv("QT_PLUGIN_METADATA_CACHE"); });
+    QCoreApplication::setLibraryPaths(QStringList());
+
+    auto pluginCount = [&](const char *iid) {
+        QFactoryLoader loader(iid, "/nonexistent");
+        loader.setExtraSearchPath(pluginDir);
+        return loader.metaData().size();
+    };
+
+    // populate the cache
+    QCOMPARE(pluginCount(PluginInterface1_iid), 1);
+    QVERIFY(QFile::exists(cacheFile));
+
+    // overwrite the plugin without changing its size and modification time:
+    // the metadata must come from the cache
+    QDateTime modificationTime;
+    {
+        QFile file(pluginFile);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        modificationTime = file.fileTime(QFileDevice::FileModificationTime);
+        QCOMPARE(file.write(QByteArray(file.size(), 'x')), file.size());
+        QVERIFY(file.flush());
+        QVERIFY(file.setFileTime(modificationTime, QFileDevice::FileModificationTime));
+    }
+    QCOMPARE(pluginCount(PluginInterface1_iid), 1);
+    QCOMPARE(QPluginLoader(pluginFile).metaData().value("IID").toString(),
+             QLatin1String(PluginInterface1_iid));
+
+    // changing the modification time invalidates the entry
+    {
+        QFile file(pluginFile);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.setFileTime(modificationTime.addSecs(-60),
+                                 QFileDevice::FileModificationTime));
+    }
+    QCOMPARE(pluginCount(PluginInterface1_iid), 0);
+    QVERIFY(QPluginLoader(pluginFile).metaData().isEmpty());
+
+    // replacing the plugin makes it read again
+    QVERIFY(QFile::remove(pluginFile));
+    QVERIFY(QFile::copy(plugin2, pluginFile));
+    QCOMPARE(pluginCount(PluginInterface1_iid), 0);
+    QCOMPARE(pluginCount(PluginInterface2_iid), 1);
+
+    // and the cache now holds the metadata of the new file
+    QPluginMetaDataCache *cache = QPluginMetaDataCache::instance();
+    QVERIFY(cache);
+    QVERIFY(!cache->value(QFileInfo(pluginFile).canonicalFilePath(),
+                          QPluginMetaDataCache::stamp(pluginFile)).isNull());
+#endif
+}
+
 QTEST_MAIN(tst_QFactoryLoader)
 #include "tst_qfactoryloader.moc"
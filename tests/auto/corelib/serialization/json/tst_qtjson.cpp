@@ -126,6 +126,8 @@ private Q_SLOTS:
     void parseEscapes();
     void makeEscapes_data();
     void makeEscapes();
+    void escapesInLongStrings_data();
+    void escapesInLongStrings();
 
     void assignObjects();
     void assignArrays();
@@ -2711,6 +2713,45 @@ void tst_QtJson::makeEscapes()
     QCOMPARE(json, result);
 }
 
+void tst_QtJson::escapesInLongStrings_data()
+{
+    QTest::addColumn<QString>("special");
+    QTest::addColumn<QByteArray>("escaped");
+
+    QTest::newRow("quote") << "\"" << QByteArray(R"(\")");
+    QTest::newRow("backslash") << "\\" << QByteArray(R"(\\)");
+    QTest::newRow("newline") << "\n" << QByteArray(R"(\n)");
+    QTest::newRow("control") << QString(u'\x01') << QByteArray(R"(\u0001)");
+    QTest::newRow("delete") << QString(u'\x7f') << QByteArray("\x7f");
+    QTest::newRow("latin1") << QString(u'\xe9') << QByteArray("\xc3\xa9");
+    QTest::newRow("cjk") << QString(u'\u4e2d') << QByteArray("\xe4\xb8\xad");
+    QTest::newRow("surrogate") << QString(char16_t(0xd800)) << QByteArray(R"(\ud800)");
+}
+
+void tst_QtJson::escapesInLongStrings()
+{
+    // the parser and the writer skip over plain US-ASCII in blocks, so move
+    // the special character across every offset within a few blocks
+    QFETCH(QString, special);
+    QFETCH(QByteArray, escaped);
+
+    for (int length = 0; length < 72; ++length) {
+        for (int pos = 0; pos <= length; ++pos) {
+            const QString input = QString(pos, u'a') + special + QString(length - pos, u'b');
+            const QByteArray expected = "[\"" + QByteArray(pos, 'a') + escaped
+                    + QByteArray(length - pos, 'b') + "\"]";
+
+            const QByteArray json = QJsonDocument(QJsonArray{ input }).toJson(QJsonDocument::Compact);
+            QCOMPARE(json, expected);
+
+            QJsonParseError error;
+            const QJsonDocument doc = QJsonDocument::fromJson(json, &error);
+            QCOMPARE(error.error, QJsonParseError::NoError);
+            QCOMPARE(doc.array().first().toString(), input);
+        }
+    }
+}
+
 void tst_QtJson::assignObjects()
 {
     const char *json =
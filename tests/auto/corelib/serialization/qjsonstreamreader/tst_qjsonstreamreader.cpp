@@ -0,0 +1,453 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QtCore/qjsonstreamreader.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsonobject.h>
+#include <QTest>
+
+class tst_QJsonStreamReader : public QObject
+{
+    Q_OBJECT
+
+private Q_SLOTS:
+    void basics();
+    void setData();
+    void tokens_data();
+    void tokens();
+    void strings_data();
+    void strings();
+    void numbers_data();
+    void numbers();
+    void errors_data();
+    void errors();
+    void deepNesting();
+    void skipCurrentContainer();
+    void rebuildDocument_data();
+    void rebuildDocument();
+};
+
+static QString tokenString(const QJsonStreamReader &reader)
+{
+    switch (reader.tokenType()) {
+    case QJsonStreamReader::NoToken:
+        return QStringLiteral("?");
+    case QJsonStreamReader::Invalid:
+        return QStringLiteral("!");
+    case QJsonStreamReader::StartObject:
+        return QStringLiteral("{");
+    case QJsonStreamReader::EndObject:
+        return QStringLiteral("}");
+    case QJsonStreamReader::StartArray:
+        return QStringLiteral("[");
+    case QJsonStreamReader::EndArray:
+        return QStringLiteral("]");
+    case QJsonStreamReader::Key:
+        return u'k' + reader.text();
+    case QJsonStreamReader::String:
+        return u's' + reader.text();
+    case QJsonStreamReader::Number:
+        return u'n' + reader.rawText().toString();
+    case QJsonStreamReader::Bool:
+        return reader.toBool() ? QStringLiteral("true") : QStringLiteral("false");
+    case QJsonStreamReader::Null:
+        return QStringLiteral("null");
+    case QJsonStreamReader::EndDocument:
+        return QStringLiteral("$");
+    }
+    return QString();
+}
+
+static QString readAll(QJsonStreamReader &reader)
+{
+    QStringList result;
+    while (!reader.atEnd()) {
+        reader.readNext();
+        result << tokenString(reader);
+    }
+    return result.join(u' ');
+}
+
+static QJsonValue readValue(QJsonStreamReader &reader)
+{
+    switch (reader.tokenType()) {
+    case QJsonStreamReader::StartObject: {
+        QJsonObject object;
+        while (reader.readNext() == QJsonStreamReader::Key) {
+            const QString key = reader.text();
+            reader.readNext();
+            object.insert(key, readValue(reader));
+        }
+        return object;
+    }
+    case QJsonStreamReader::StartArray: {
+        QJsonArray array;
+        while (reader.readNext() != QJsonStreamReader::EndArray && !reader.atEnd())
+            array.append(readValue(reader));
+        return array;
+    }
+    case QJsonStreamReader::String:
+        return reader.text();
+    case QJsonStreamReader::Number:
+        if (reader.isInteger())
+            return reader.toInteger();
+        return reader.toDouble();
+    case QJsonStreamReader::Bool:
+        return reader.toBool();
+    case QJsonStreamReader::Null:
+        return QJsonValue::Null;
+    default:
+        break;
+    }
+    return QJsonValue::Undefined;
+}
+
+void tst_QJsonStreamReader::basics()
+{
+    QJsonStreamReader reader;
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QVERIFY(!reader.atEnd());
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.error().error, QJsonParseError::NoError);
+    QCOMPARE(reader.containerDepth(), 0);
+    QVERIFY(reader.rawText().isNull());
+    QVERIFY(reader.text().isNull());
+
+    // no data is an error, just like QJsonDocument::fromJson()
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+    QVERIFY(reader.atEnd());
+    QVERIFY(reader.hasError());
+    QCOMPARE(reader.error().error, QJsonParseError::IllegalValue);
+
+    // and it stays that way
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+}
+
+void tst_QJsonStreamReader::setData()
+{
+    const QByteArray first = "[1]";
+    const QByteArray second = "{\"a\":true}";
+
+    QJsonStreamReader reader(first);
+    QCOMPARE(readAll(reader), "[ n1 ] $");
+    QVERIFY(reader.isEndDocument());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    reader.setData(second.constData(), second.size());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(readAll(reader), "{ ka true } $");
+
+    reader.clear();
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::NoToken);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Invalid);
+
+    // the raw-data constructor does not copy
+    QJsonStreamReader raw(second.constData(), second.size());
+    QCOMPARE(raw.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(raw.readNext(), QJsonStreamReader::Key);
+    QCOMPARE(raw.rawText().data(), second.constData() + 2);
+}
+
+void tst_QJsonStreamReader::tokens_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+
+    QTest::newRow("empty-array") << QByteArray("[]") << "[ ] $";
+    QTest::newRow("empty-object") << QByteArray("{}") << "{ } $";
+    QTest::newRow("whitespace") << QByteArray(" \t\r\n[ \n] \r\n") << "[ ] $";
+    QTest::newRow("bom") << QByteArray("\xef\xbb\xbf[null]") << "[ null ] $";
+    QTest::newRow("literals") << QByteArray("[true,false,null]") << "[ true false null ] $";
+    QTest::newRow("members") << QByteArray("{\"a\": 1, \"b\": \"x\", \"c\": null}")
+                             << "{ ka n1 kb sx kc null } $";
+    QTest::newRow("nested") << QByteArray("[[], {}, [{\"a\": [1, 2]}]]")
+                            << "[ [ ] { } [ { ka [ n1 n2 ] } ] ] $";
+    QTest::newRow("duplicate-keys") << QByteArray("{\"a\":1,\"a\":2}") << "{ ka n1 ka n2 } $";
+}
+
+void tst_QJsonStreamReader::tokens()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+
+    QJsonStreamReader reader(json);
+    QCOMPARE(readAll(reader), expected);
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.containerDepth(), 0);
+}
+
+void tst_QJsonStreamReader::strings_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QString>("expected");
+    QTest::addColumn<bool>("hasEscapeSequences");
+
+    QTest::newRow("empty") << QByteArray("\"\"") << "" << false;
+    QTest::newRow("ascii") << QByteArray("\"Hello\"") << "Hello" << false;
+    QTest::newRow("utf8") << QByteArray("\"R\xc3\xa9sum\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80\"")
+                          << QString::fromUtf8("R\xc3\xa9sum\xc3\xa9 \xe2\x82\xac \xf0\x9f\x98\x80")
+                          << false;
+    QTest::newRow("escapes") << QByteArray(R"("\"\\\/\b\f\n\r\t")") << "\"\\/\b\f\n\r\t" << true;
+    QTest::newRow("unicode-escape") << QByteArray(R"("a\u00e9\u20ACb")")
+                                    << QString::fromUtf8("a\xc3\xa9\xe2\x82\xac" "b") << true;
+    QTest::newRow("surrogate-escapes") << QByteArray(R"("\ud83d\ude00")")
+                                       << QString::fromUtf8("\xf0\x9f\x98\x80") << true;
+    QTest::newRow("escape-and-utf8") << QByteArray("\"\xc3\xa9\\n\"")
+                                     << QString::fromUtf8("\xc3\xa9\n") << true;
+}
+
+void tst_QJsonStreamReader::strings()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QString, expected);
+    QFETCH(bool, hasEscapeSequences);
+
+    const QByteArray array = '[' + json + ']';
+    const QByteArray object = "{" + json + ':' + json + '}';
+
+    QJsonStreamReader reader(array);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.currentOffset(), 1);
+    QCOMPARE(reader.text(), expected);
+    QCOMPARE(reader.hasEscapeSequences(), hasEscapeSequences);
+    QCOMPARE(reader.rawText(), QUtf8StringView(json.mid(1, json.size() - 2)));
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndArray);
+    QVERIFY(reader.rawText().isNull());
+    QVERIFY(!reader.hasEscapeSequences());
+
+    reader.setData(object);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Key);
+    QCOMPARE(reader.text(), expected);
+    QCOMPARE(reader.hasEscapeSequences(), hasEscapeSequences);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::String);
+    QCOMPARE(reader.text(), expected);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndObject);
+
+    // compare to QJsonDocument
+    QCOMPARE(QJsonDocument::fromJson(array).array().at(0).toString(), expected);
+}
+
+void tst_QJsonStreamReader::numbers_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<bool>("isInteger");
+    QTest::addColumn<qint64>("integer");
+    QTest::addColumn<double>("value");
+
+    QTest::newRow("zero") << QByteArray("0") << true << qint64(0) << 0.;
+    QTest::newRow("negative") << QByteArray("-42") << true << qint64(-42) << -42.;
+    QTest::newRow("max") << QByteArray("9223372036854775807") << true
+                         << std::numeric_limits<qint64>::max() << 9223372036854775807.;
+    QTest::newRow("min") << QByteArray("-9223372036854775808") << true
+                         << std::numeric_limits<qint64>::min() << -9223372036854775808.;
+    QTest::newRow("overflow") << QByteArray("18446744073709551616") << false
+                              << qint64(0) << 18446744073709551616.;
+    QTest::newRow("fraction") << QByteArray("1.5") << false << qint64(0) << 1.5;
+    QTest::newRow("integral-fraction") << QByteArray("2.0") << true << qint64(2) << 2.;
+    QTest::newRow("exponent") << QByteArray("1e3") << true << qint64(1000) << 1000.;
+    QTest::newRow("negative-exponent") << QByteArray("-25E-1") << false << qint64(0) << -2.5;
+}
+
+void tst_QJsonStreamReader::numbers()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(bool, isInteger);
+    QFETCH(qint64, integer);
+    QFETCH(double, value);
+
+    const QByteArray array = '[' + json + ']';
+    QJsonStreamReader reader(array);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.rawText(), QUtf8StringView(json));
+    QCOMPARE(reader.isInteger(), isInteger);
+    QCOMPARE(reader.toInteger(-1), isInteger ? integer : -1);
+    QCOMPARE(reader.toDouble(), value);
+    QVERIFY(!reader.toBool());
+    QVERIFY(reader.text().isNull());
+
+    // compare to QJsonDocument
+    const QJsonValue v = QJsonDocument::fromJson(array).array().at(0);
+    QCOMPARE(v.isDouble(), true);
+    QCOMPARE(v.toDouble(), value);
+    if (isInteger)
+        QCOMPARE(v.toInteger(), integer);
+}
+
+void tst_QJsonStreamReader::errors_data()
+{
+    QTest::addColumn<QByteArray>("json");
+    QTest::addColumn<QJsonParseError::ParseError>("error");
+
+    QTest::newRow("empty") << QByteArray() << QJsonParseError::IllegalValue;
+    QTest::newRow("scalar") << QByteArray("1") << QJsonParseError::IllegalValue;
+    QTest::newRow("garbage") << QByteArray("[] x") << QJsonParseError::GarbageAtEnd;
+    QTest::newRow("two-documents") << QByteArray("{}{}") << QJsonParseError::GarbageAtEnd;
+    QTest::newRow("unterminated-object") << QByteArray("{\"a\":1 ") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("unterminated-array") << QByteArray("[1 ") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("unterminated-empty-array") << QByteArray("[") << QJsonParseError::UnterminatedArray;
+    QTest::newRow("missing-name-separator") << QByteArray("{\"a\" 1}") << QJsonParseError::MissingNameSeparator;
+    QTest::newRow("missing-value-separator") << QByteArray("[1 2]") << QJsonParseError::MissingValueSeparator;
+    QTest::newRow("trailing-comma-object") << QByteArray("{\"a\":1,}") << QJsonParseError::MissingObject;
+    QTest::newRow("trailing-comma-array") << QByteArray("[1,]") << QJsonParseError::MissingObject;
+    QTest::newRow("missing-value") << QByteArray("{\"a\":,}") << QJsonParseError::IllegalValue;
+    QTest::newRow("non-string-key") << QByteArray("{1:2}") << QJsonParseError::UnterminatedObject;
+    QTest::newRow("bad-literal") << QByteArray("[nul]") << QJsonParseError::IllegalValue;
+    QTest::newRow("short-literal") << QByteArray("[tru") << QJsonParseError::IllegalValue;
+    QTest::newRow("bad-number") << QByteArray("[-]") << QJsonParseError::IllegalNumber;
+    QTest::newRow("number-at-end") << QByteArray("[1") << QJsonParseError::TerminationByNumber;
+    QTest::newRow("unterminated-string") << QByteArray("[\"abc") << QJsonParseError::UnterminatedString;
+    QTest::newRow("bad-escape") << QByteArray("[\"\\u12x4\"]") << QJsonParseError::IllegalEscapeSequence;
+    QTest::newRow("bad-utf8") << QByteArray("[\"\xc3\x28\"]") << QJsonParseError::IllegalUTF8String;
+}
+
+void tst_QJsonStreamReader::errors()
+{
+    QFETCH(QByteArray, json);
+    QFETCH(QJsonParseError::ParseError, error);
+
+    QJsonParseError documentError;
+    QJsonDocument::fromJson(json, &documentError);
+    QCOMPARE(documentError.error, error);
+
+    QJsonStreamReader reader(json);
+    while (!reader.atEnd())
+        reader.readNext();
+    QVERIFY(reader.hasError());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::Invalid);
+    QCOMPARE(reader.error().error, error);
+    QVERIFY(!reader.error().errorString().isEmpty());
+}
+
+void tst_QJsonStreamReader::deepNesting()
+{
+    constexpr int limit = 1024;
+    QByteArray json = QByteArray(limit, '[') + QByteArray(limit, ']');
+
+    QJsonStreamReader reader(json);
+    while (reader.readNext() == QJsonStreamReader::StartArray)
+        ;
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.containerDepth(), limit - 1);
+    while (reader.readNext() == QJsonStreamReader::EndArray)
+        ;
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndDocument);
+
+    json = '[' + json + ']';
+    reader.setData(json);
+    while (!reader.atEnd())
+        reader.readNext();
+    QCOMPARE(reader.error().error, QJsonParseError::DeepNesting);
+    QCOMPARE(reader.error().offset, limit + 1);
+}
+
+void tst_QJsonStreamReader::skipCurrentContainer()
+{
+    const QByteArray json = R"({"skip": {"a": [1, {"b": "}"}], "c": "]"}, "keep": [true, {}], "last": 1})";
+    QJsonStreamReader reader(json);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Key);
+    QCOMPARE(reader.rawText(), "skip");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartObject);
+    QCOMPARE(reader.containerDepth(), 2);
+    QVERIFY(reader.skipCurrentContainer());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndObject);
+    QCOMPARE(reader.containerDepth(), 1);
+
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Key);
+    QCOMPARE(reader.rawText(), "keep");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Bool);
+
+    // skips the rest of the enclosing array
+    QVERIFY(reader.skipCurrentContainer());
+    QCOMPARE(reader.tokenType(), QJsonStreamReader::EndArray);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Key);
+    QCOMPARE(reader.rawText(), "last");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::Number);
+    QCOMPARE(reader.currentOffset(), json.size() - 2);
+
+    QVERIFY(reader.skipCurrentContainer());
+    QCOMPARE(reader.containerDepth(), 0);
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+    QVERIFY(!reader.skipCurrentContainer());
+
+    // errors inside the skipped container are reported
+    reader.setData(R"([{"a": [1 2]}])");
+    QCOMPARE(reader.readNext(), QJsonStreamReader::StartArray);
+    QVERIFY(!reader.skipCurrentContainer());
+    QCOMPARE(reader.error().error, QJsonParseError::MissingValueSeparator);
+}
+
+void tst_QJsonStreamReader::rebuildDocument_data()
+{
+    QTest::addColumn<QByteArray>("json");
+
+    QTest::newRow("array") << QByteArray(R"([1, -2.5, "three", true, false, null, [], {}])");
+    QTest::newRow("object") << QByteArray(R"({
+        "firstName": "John",
+        "lastName": "Sm\u00efth",
+        "age": 25,
+        "address": {
+            "streetAddress": "21 2nd Street",
+            "city": "New York",
+            "postalCode": 10021
+        },
+        "phoneNumbers": [
+            { "type": "home", "number": "212 555-1234" },
+            { "type": "fax", "number": "646 555-4567" }
+        ],
+        "big": 1.7976931348623157e308,
+        "empty": ""
+    })");
+}
+
+void tst_QJsonStreamReader::rebuildDocument()
+{
+    QFETCH(QByteArray, json);
+
+    QJsonParseError error;
+    const QJsonDocument document = QJsonDocument::fromJson(json, &error);
+    QCOMPARE(error.error, QJsonParseError::NoError);
+
+    QJsonStreamReader reader(json);
+    reader.readNext();
+    const QJsonValue value = readValue(reader);
+    QVERIFY(!reader.hasError());
+    QCOMPARE(reader.readNext(), QJsonStreamReader::EndDocument);
+
+    if (document.isArray())
+        QCOMPARE(value, QJsonValue(document.array()));
+    else
+        QCOMPARE(value, QJsonValue(document.object()));
+}
+
+QTEST_MAIN(tst_QJsonStreamReader)
+#include "tst_qjsonstreamreader.moc"
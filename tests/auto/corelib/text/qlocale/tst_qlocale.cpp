@@ -37,6 +37,7 @@
 #if QT_CONFIG(process)
 #  include <QProcess>
 #endif
+#include <QRandomGenerator>
 #include <QScopedArrayPointer>
 #include <QTimeZone>
 
@@ -96,6 +97,7 @@ private slots:
     void fpExceptions();
     void negativeZero_data();
     void negativeZero();
+    void shortestRoundTrip();
     void dayOfWeek();
     void dayOfWeek_data();
     void formatDate();
@@ -1573,6 +1575,42 @@ void tst_QLocale::negativeZero()
     QCOMPARE(locale.toString(std::copysign(0.0, -1.0)), expect);
 }
 
+void tst_QLocale::shortestRoundTrip()
+{
+    // The C locale and QString::number() share a fast path; both must produce
+    // the shortest representation that reads back as the same double.
+    QRandomGenerator rng(1234);
+    const QLocale c = QLocale::c();
+    for (int i = 0; i < 10000; ++i) {
+        quint64 bits = rng.generate64();
+        double d;
+        memcpy(&d, &bits, sizeof(d));
+        if (!qIsFinite(d))
+            continue;
+
+        const QString shortest = QString::number(d, 'g', QLocale::FloatingPointShortest);
+        QCOMPARE(c.toString(d, 'g', QLocale::FloatingPointShortest), shortest);
+        QCOMPARE(c.toString(d, 'e', 6), QString::number(d, 'e', 6));
+
+        bool ok = false;
+        QCOMPARE(shortest.toDouble(&ok), d);
+        QVERIFY2(ok, qPrintable(shortest));
+        QCOMPARE(c.toDouble(shortest, &ok), d);
+        QVERIFY(ok);
+        QCOMPARE(shortest.toLatin1().toDouble(&ok), d);
+        QVERIFY(ok);
+
+        // One digit fewer must no longer be the same number
+        const qsizetype exponent = shortest.indexOf(u'e');
+        QString mantissa = exponent < 0 ? shortest : shortest.first(exponent);
+        if (mantissa.count(u'.') && mantissa.size() > 3) {
+            QString truncated = shortest;
+            truncated.remove(mantissa.size() - 1, 1);
+            QVERIFY2(truncated.toDouble() != d, qPrintable(shortest));
+        }
+    }
+}
+
 void tst_QLocale::dayOfWeek_data()
 {
     QTest::addColumn<QDate>("date");
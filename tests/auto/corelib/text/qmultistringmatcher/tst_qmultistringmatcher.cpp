@@ -0,0 +1,287 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QMultiStringMatcher>
+#include <QRandomGenerator>
+
+using namespace Qt::StringLiterals;
+
+using Indexes = QList<qsizetype>;
+
+class tst_QMultiStringMatcher : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void matchingPatterns_data();
+    void matchingPatterns();
+    void utf8_data();
+    void utf8();
+    void nonBmpCaseFolding();
+    void setters();
+    void compareWithContains_data();
+    void compareWithContains();
+    void largeAlphabet_data();
+    void largeAlphabet();
+};
+
+void tst_QMultiStringMatcher::empty()
+{
+    QMultiStringMatcher matcher;
+    QVERIFY(matcher.patterns().isEmpty());
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseSensitive);
+    QVERIFY(!matcher.containsAny(u"text"));
+    QVERIFY(!matcher.containsAny(QByteArrayView("text")));
+    QVERIFY(matcher.matchingPatterns(u"text").isEmpty());
+    QVERIFY(matcher.matchingPatterns(QByteArrayView()).isEmpty());
+
+    // an empty pattern matches everything, even an empty subject
+    matcher.setPatterns({ u"x"_s, QString() });
+    QVERIFY(matcher.containsAny(QStringView()));
+    QVERIFY(matcher.containsAny(QByteArrayView()));
+    QCOMPARE(matcher.matchingPatterns(QStringView()), Indexes{ 1 });
+    QCOMPARE(matcher.matchingPatterns(u"xyz"), Indexes({ 0, 1 }));
+}
+
+void tst_QMultiStringMatcher::matchingPatterns_data()
+{
+    QTest::addColumn<QStringList>("patterns");
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::addColumn<QString>("subject");
+    QTest::addColumn<Indexes>("expected");
+
+    const QStringList classic = { u"he"_s, u"she"_s, u"his"_s, u"hers"_s };
+    QTest::newRow("classic-ushers") << classic << Qt::CaseSensitive << u"ushers"_s
+                                    << Indexes{ 0, 1, 3 };
+    QTest::newRow("classic-this") << classic << Qt::CaseSensitive << u"this"_s << Indexes{ 2 };
+    QTest::newRow("classic-none") << classic << Qt::CaseSensitive << u"hits"_s << Indexes{};
+    QTest::newRow("classic-case") << classic << Qt::CaseSensitive << u"USHERS"_s << Indexes{};
+    QTest::newRow("classic-nocase") << classic << Qt::CaseInsensitive << u"USHERS"_s
+                                    << Indexes{ 0, 1, 3 };
+
+    QTest::newRow("suffix") << QStringList{ u"abcd"_s, u"bc"_s, u"c"_s } << Qt::CaseSensitive
+                            << u"xabcx"_s << Indexes{ 1, 2 };
+    QTest::newRow("duplicates") << QStringList{ u"error"_s, u"warn"_s, u"error"_s }
+                                << Qt::CaseSensitive << u"an error"_s << Indexes{ 0, 2 };
+    QTest::newRow("at-ends") << QStringList{ u"start"_s, u"end"_s } << Qt::CaseSensitive
+                             << u"start and end"_s << Indexes{ 0, 1 };
+    QTest::newRow("whole") << QStringList{ u"subject"_s } << Qt::CaseSensitive << u"subject"_s
+                           << Indexes{ 0 };
+    QTest::newRow("longer-than-subject") << QStringList{ u"subjects"_s } << Qt::CaseSensitive
+                                         << u"subject"_s << Indexes{};
+    QTest::newRow("repeats") << QStringList{ u"aaa"_s, u"aab"_s } << Qt::CaseSensitive
+                             << u"aaaab"_s << Indexes{ 0, 1 };
+
+    QTest::newRow("non-latin1") << QStringList{ u"Ξεσκεπάζω"_s, u"ψυχοφθόρα"_s, u"中文"_s }
+                                << Qt::CaseSensitive << u"την ψυχοφθόρα, 中文"_s << Indexes{ 1, 2 };
+    QTest::newRow("non-latin1-nocase") << QStringList{ u"ΞΕΣΚΕΠΆΖΩ"_s, u"Straße"_s }
+                                       << Qt::CaseInsensitive << u"ξεσκεπάζω STRAẞE"_s
+                                       << Indexes{ 0, 1 };
+    QTest::newRow("kelvin-nocase") << QStringList{ u"k"_s } << Qt::CaseInsensitive
+                                   << u"K"_s << Indexes{ 0 };
+    QTest::newRow("non-bmp") << QStringList{ u"\U0001f600"_s, u"\U0001f601"_s }
+                             << Qt::CaseSensitive << u"smile \U0001f601"_s << Indexes{ 1 };
+}
+
+void tst_QMultiStringMatcher::matchingPatterns()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, subject);
+    QFETCH(Indexes, expected);
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    QCOMPARE(matcher.patterns(), patterns);
+    QCOMPARE(matcher.caseSensitivity(), cs);
+    QCOMPARE(matcher.matchingPatterns(subject), expected);
+    QCOMPARE(matcher.containsAny(subject), !expected.isEmpty());
+}
+
+void tst_QMultiStringMatcher::utf8_data()
+{
+    matchingPatterns_data();
+}
+
+void tst_QMultiStringMatcher::utf8()
+{
+    QFETCH(QStringList, patterns);
+    QFETCH(Qt::CaseSensitivity, cs);
+    QFETCH(QString, subject);
+    QFETCH(Indexes, expected);
+
+    // case-insensitive matching of UTF-8 only handles US-ASCII
+    if (cs == Qt::CaseInsensitive) {
+        auto isAscii = [](const QString &s) {
+            return std::all_of(s.begin(), s.end(), [](QChar c) { return c.unicode() < 0x80; });
+        };
+        if (!isAscii(subject) || !std::all_of(patterns.cbegin(), patterns.cend(), isAscii))
+            QSKIP("Case-insensitive non-US-ASCII text");
+    }
+
+    const QMultiStringMatcher matcher(patterns, cs);
+    const QByteArray utf8 = subject.toUtf8();
+    QCOMPARE(matcher.matchingPatterns(utf8), expected);
+    QCOMPARE(matcher.containsAny(utf8), !expected.isEmpty());
+}
+
+void tst_QMultiStringMatcher::nonBmpCaseFolding()
+{
+    // DESERET CAPITAL LETTER LONG I and DESERET SMALL LETTER LONG I
+    const QMultiStringMatcher matcher({ u"x\U00010400"_s, u"\U00010428y"_s }, Qt::CaseInsensitive);
+    QCOMPARE(matcher.matchingPatterns(u"x\U00010428"), Indexes{ 0 });
+    QCOMPARE(matcher.matchingPatterns(u"X\U00010400Y"), Indexes({ 0, 1 }));
+    QCOMPARE(matcher.matchingPatterns(u"\U00010400"), Indexes{});
+    // a lone surrogate doesn't get in the way
+    QCOMPARE(matcher.matchingPatterns(u"\xd801" "x\U00010400"_s), Indexes{ 0 });
+}
+
+void tst_QMultiStringMatcher::setters()
+{
+    QMultiStringMatcher matcher({ u"Alpha"_s, u"beta"_s });
+    const QMultiStringMatcher copy = matcher;
+    QCOMPARE(matcher.matchingPatterns(u"alpha beta"), Indexes{ 1 });
+
+    matcher.setCaseSensitivity(Qt::CaseInsensitive);
+    QCOMPARE(matcher.matchingPatterns(u"alpha beta"), Indexes({ 0, 1 }));
+    QCOMPARE(matcher.patterns(), QStringList({ u"Alpha"_s, u"beta"_s }));
+
+    matcher.setPatterns({ u"gamma"_s });
+    QCOMPARE(matcher.caseSensitivity(), Qt::CaseInsensitive);
+    QCOMPARE(matcher.matchingPatterns(u"alpha GAMMA"), Indexes{ 0 });
+
+    // the copy isn't affected
+    QCOMPARE(copy.caseSensitivity(), Qt::CaseSensitive);
+    QCOMPARE(copy.matchingPatterns(u"alpha beta"), Indexes{ 1 });
+
+    QMultiStringMatcher moved = std::move(matcher);
+    QCOMPARE(moved.matchingPatterns(u"gamma"), Indexes{ 0 });
+    matcher = copy;
+    QCOMPARE(matcher.matchingPatterns(u"Alpha"), Indexes{ 0 });
+}
+
+void tst_QMultiStringMatcher::compareWithContains_data()
+{
+    QTest::addColumn<Qt::CaseSensitivity>("cs");
+    QTest::newRow("sensitive") << Qt::CaseSensitive;
+    QTest::newRow("insensitive") << Qt::CaseInsensitive;
+}
+
+void tst_QMultiStringMatcher::compareWithContains()
+{
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    // small alphabets, so that patterns overlap and occur often
+    static const char16_t alphabet[] = u"abABéÉ中";
+    QRandomGenerator rng(1234);
+    auto randomString = [&](int maxLength) {
+        QString s;
+        for (int i = rng.bounded(1, maxLength + 1); i > 0; --i)
+            s += QChar(alphabet[rng.bounded(int(std::size(alphabet)) - 1)]);
+        return s;
+    };
+
+    for (int round = 0; round < 200; ++round) {
+        QStringList patterns;
+        for (int i = rng.bounded(1, 20); i > 0; --i)
+            patterns.append(randomString(5));
+        const QMultiStringMatcher matcher(patterns, cs);
+
+        for (int i = 0; i < 20; ++i) {
+            const QString subject = randomString(40);
+            const QByteArray utf8 = subject.toUtf8();
+            Indexes expected;
+            Indexes expectedUtf8;
+            for (qsizetype p = 0; p < patterns.size(); ++p) {
+                if (subject.contains(patterns.at(p), cs))
+                    expected.append(p);
+                // QByteArray has no case-insensitive search: fold US-ASCII by hand
+                const QByteArray needle = patterns.at(p).toUtf8();
+                if (cs == Qt::CaseSensitive ? utf8.contains(needle)
+                                            : utf8.toLower().contains(needle.toLower())) {
+                    expectedUtf8.append(p);
+                }
+            }
+            QCOMPARE(matcher.matchingPatterns(subject), expected);
+            QCOMPARE(matcher.containsAny(subject), !expected.isEmpty());
+            QCOMPARE(matcher.matchingPatterns(utf8), expectedUtf8);
+            QCOMPARE(matcher.containsAny(utf8), !expectedUtf8.isEmpty());
+        }
+    }
+}
+
+void tst_QMultiStringMatcher::largeAlphabet_data()
+{
+    compareWithContains_data();
+}
+
+void tst_QMultiStringMatcher::largeAlphabet()
+{
+    QFETCH(Qt::CaseSensitivity, cs);
+
+    // thousands of distinct characters in long patterns: too many states
+    // times classes for a dense table
+    QRandomGenerator rng(5678);
+    auto randomChar = [&] {
+        return rng.bounded(10) ? QChar(char16_t(0x4e00 + rng.bounded(6000)))
+                               : QChar(char16_t(u'a' + rng.bounded(3)));
+    };
+    QStringList patterns;
+    for (int i = 0; i < 300; ++i) {
+        QString pattern;
+        for (int j = rng.bounded(40, 80); j > 0; --j)
+            pattern += randomChar();
+        patterns.append(pattern);
+    }
+    const QMultiStringMatcher matcher(patterns, cs);
+
+    for (int i = 0; i < 50; ++i) {
+        // pieces of patterns, some of them whole
+        QString subject;
+        for (int j = rng.bounded(1, 6); j > 0; --j) {
+            const QString &pattern = patterns.at(rng.bounded(int(patterns.size())));
+            const qsizetype from = rng.bounded(3) ? rng.bounded(int(pattern.size())) : 0;
+            subject += pattern.sliced(from);
+            subject += randomChar();
+        }
+        if (cs == Qt::CaseInsensitive)
+            subject = subject.toUpper();
+        Indexes expected;
+        for (qsizetype p = 0; p < patterns.size(); ++p) {
+            if (subject.contains(patterns.at(p), cs))
+                expected.append(p);
+        }
+        QCOMPARE(matcher.matchingPatterns(subject), expected);
+        QCOMPARE(matcher.containsAny(subject), !expected.isEmpty());
+        QCOMPARE(matcher.matchingPatterns(subject.toUtf8()), expected);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QMultiStringMatcher)
+#include "tst_qmultistringmatcher.moc"
@@ -0,0 +1,207 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QRandomGenerator>
+#include <QRegularExpressionSet>
+
+using namespace Qt::StringLiterals;
+
+using Indexes = QList<qsizetype>;
+
+class tst_QRegularExpressionSet : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void empty();
+    void matchingExpressions_data();
+    void matchingExpressions();
+    void invalidExpressions();
+    void utf8();
+    void setters();
+    void compareWithMatch_data();
+    void compareWithMatch();
+};
+
+void tst_QRegularExpressionSet::empty()
+{
+    QRegularExpressionSet set;
+    QVERIFY(set.expressions().isEmpty());
+    QVERIFY(!set.matchesAny(u"text"));
+    QVERIFY(set.matchingExpressions(u"text").isEmpty());
+}
+
+void tst_QRegularExpressionSet::matchingExpressions_data()
+{
+    QTest::addColumn<QString>("subject");
+    QTest::addColumn<Indexes>("expected");
+
+    QTest::newRow("none") << u"all is well"_s << Indexes{};
+    QTest::newRow("refused") << u"[net] connection refused"_s << Indexes{ 0 };
+    QTest::newRow("not-at-start") << u"x [net] connection refused"_s << Indexes{};
+    QTest::newRow("timeout") << u"timeout after 10 ms"_s << Indexes{ 1 };
+    QTest::newRow("timeout-no-digits") << u"timeout after ms"_s << Indexes{};
+    QTest::newRow("disk") << u"DISK sda1 IS FULL"_s << Indexes{ 2 };
+    QTest::newRow("several") << u"[io] connection refused: disk sdb is full, timeout after 5 ms"_s
+                             << Indexes{ 0, 1, 2 };
+    QTest::newRow("unfiltered") << u"code 404"_s << Indexes{ 3 };
+    QTest::newRow("unfiltered-alternative") << u"beta"_s << Indexes{ 4 };
+}
+
+static QList<QRegularExpression> routingRules()
+{
+    return {
+        QRegularExpression(u"^\\[(\\w+)\\] connection refused"_s),
+        QRegularExpression(u"timeout after \\d+ ms"_s),
+        QRegularExpression(u"disk \\w+ is full"_s, QRegularExpression::CaseInsensitiveOption),
+        QRegularExpression(u"\\d{3}"_s),
+        QRegularExpression(u"alpha|beta"_s),
+    };
+}
+
+void tst_QRegularExpressionSet::matchingExpressions()
+{
+    QFETCH(QString, subject);
+    QFETCH(Indexes, expected);
+
+    const QRegularExpressionSet set(routingRules());
+    QCOMPARE(set.expressions(), routingRules());
+    QCOMPARE(set.matchingExpressions(subject), expected);
+    QCOMPARE(set.matchesAny(subject), !expected.isEmpty());
+}
+
+void tst_QRegularExpressionSet::invalidExpressions()
+{
+    const QRegularExpressionSet set({ QRegularExpression(u"abc("_s),
+                                      QRegularExpression(u"abc"_s),
+                                      QRegularExpression(u"*"_s) });
+    QCOMPARE(set.matchingExpressions(u"abc("), Indexes{ 1 });
+}
+
+void tst_QRegularExpressionSet::utf8()
+{
+    const QRegularExpressionSet set(routingRules());
+    QCOMPARE(set.matchingExpressions(QByteArrayView("disk sda is full, timeout after 5 ms")),
+             (Indexes{ 1, 2 }));
+    QVERIFY(!set.matchesAny(QByteArrayView("all is well")));
+    QVERIFY(set.matchesAny(QByteArrayView("beta")));
+
+    // invalid sequences match the replacement character, as after fromUtf8()
+    const QRegularExpressionSet replacement({ QRegularExpression(u"a\\x{fffd}b"_s),
+                                              QRegularExpression(u"a\\x{fffd}?c"_s) });
+    QCOMPARE(replacement.matchingExpressions(QByteArrayView("xa\xff" "b")), Indexes{ 0 });
+    QCOMPARE(replacement.matchingExpressions(QByteArrayView("xa\xff" "c")), Indexes{ 1 });
+    QCOMPARE(replacement.matchingExpressions(QByteArrayView("xa\xef\xbf\xbd" "b")), Indexes{ 0 });
+}
+
+void tst_QRegularExpressionSet::setters()
+{
+    QRegularExpressionSet set(routingRules());
+    const QRegularExpressionSet copy = set;
+    set.setExpressions({ QRegularExpression(u"full"_s) });
+    QCOMPARE(set.expressions().size(), 1);
+    QCOMPARE(set.matchingExpressions(u"disk is full"), Indexes{ 0 });
+    QCOMPARE(copy.matchingExpressions(u"disk sda is full"), Indexes{ 2 });
+
+    QRegularExpressionSet moved = std::move(set);
+    QCOMPARE(moved.matchingExpressions(u"full"), Indexes{ 0 });
+    set = copy;
+    QCOMPARE(set.expressions(), routingRules());
+}
+
+void tst_QRegularExpressionSet::compareWithMatch_data()
+{
+    QTest::addColumn<QString>("pattern");
+    QTest::addColumn<QRegularExpression::PatternOptions>("options");
+
+    const auto none = QRegularExpression::PatternOptions();
+    const auto caseInsensitive = QRegularExpression::PatternOptions(QRegularExpression::CaseInsensitiveOption);
+    const auto extended = QRegularExpression::PatternOptions(QRegularExpression::ExtendedPatternSyntaxOption);
+
+    // Patterns exercising the literal extraction: the result must always be
+    // the same as matching each expression on its own
+    const char16_t *const patterns[] = {
+        u"abc", u"ab?c", u"ab*c", u"ab+c", u"ab{0}c", u"ab{0,2}c", u"ab{1,}c", u"ab{2}c",
+        u"ab{,2}c", u"ab{x}c", u"a{", u"ab??c", u"ab+?c", u"ab*+c", u"a.c", u"a\\.c", u"a\\bc",
+        u"\\x61bc", u"\\x{62}c", u"a\\cbc", u"\\pLbc", u"\\p{Lu}bc", u"a\\Qb|c\\Ec", u"a\\Ebc",
+        u"a[bc]c", u"a[]b]c", u"a[^]b]c", u"a[[:alpha:]]c", u"a[\\]]bc", u"(ab)c", u"(ab)?c",
+        u"(?:ab)+c", u"(?=ab)abc", u"(?!b)abc", u"(?<=a)bc", u"(?<x>a)bc", u"(?P<x>a)bc",
+        u"(?'x'a)bc", u"(?#a(b)abc", u"(?i)abc", u"a(?i)bc", u"(?i:ab)c", u"(*UCP)abc",
+        u"a(b|c)c", u"ab|bc", u"(a)\\1bc", u"a\\10bc", u"a\\tb", u"^abc$", u"a#b c",
+        u"a b c", u"aBc", u"ABC", u"AKc", u"aéc", u"Ébc", u"a\U0001f600?b",
+        u"a\U0001f600b", u"\\Aab\\z", u"a\\Kbc", u"a\\gbc", u"a(b(*ACCEPT))cde",
+        u"a(?:b|(c(*ACCEPT:x)))de", u"(a(*COMMIT)b)c", u"a\uFFFDb",
+    };
+    for (const char16_t *pattern : patterns) {
+        QTest::addRow("%ls", qUtf16Printable(QString::fromUtf16(pattern))) << QString::fromUtf16(pattern) << none;
+        QTest::addRow("%ls-i", qUtf16Printable(QString::fromUtf16(pattern))) << QString::fromUtf16(pattern) << caseInsensitive;
+        QTest::addRow("%ls-x", qUtf16Printable(QString::fromUtf16(pattern))) << QString::fromUtf16(pattern) << extended;
+    }
+}
+
+void tst_QRegularExpressionSet::compareWithMatch()
+{
+    QFETCH(QString, pattern);
+    QFETCH(QRegularExpression::PatternOptions, options);
+
+    // The expression alone doesn't always need a filter, so add it twice to
+    // a set with a literal that always matches: the results must agree anyway
+    const QRegularExpression re(pattern, options);
+    const QRegularExpressionSet set({ re, QRegularExpression(u"a"_s), re });
+
+    static const char16_t alphabet[] = u"aAbBc.|\t #KéÉ";
+    QRandomGenerator rng(4321);
+    QStringList subjects = { pattern, u"abc"_s, u"ABC"_s, u"a\U0001f600b"_s, u"ab"_s, u"bc"_s,
+                             u"xxab"_s, u"xxac"_s, u"a\uFFFDb"_s };
+    for (int i = 0; i < 300; ++i) {
+        QString s;
+        for (int j = rng.bounded(8); j > 0; --j)
+            s += QChar(alphabet[rng.bounded(int(std::size(alphabet)) - 1)]);
+        subjects.append(s);
+    }
+
+    for (const QString &subject : std::as_const(subjects)) {
+        const bool matches = re.isValid() && re.match(subject).hasMatch();
+        const bool matchesA = subject.contains(u'a');
+        Indexes expected;
+        if (matches)
+            expected.append(0);
+        if (matchesA)
+            expected.append(1);
+        if (matches)
+            expected.append(2);
+        QCOMPARE(set.matchingExpressions(subject), expected);
+        QCOMPARE(set.matchesAny(subject), matches || matchesA);
+        QCOMPARE(set.matchingExpressions(subject.toUtf8()), expected);
+        QCOMPARE(set.matchesAny(subject.toUtf8()), matches || matchesA);
+    }
+}
+
+QTEST_APPLESS_MAIN(tst_QRegularExpressionSet)
+#include "tst_qregularexpressionset.moc"
@@ -61,6 +61,9 @@ private slots:
     void utf8stateful_data();
     void utf8stateful();
 
+    void utf8LongText_data();
+    void utf8LongText();
+
     void utfHeaders_data();
     void utfHeaders();
 
@@ -1477,6 +1480,64 @@ void tst_QStringConverter::utf8stateful()
     }
 }
 
+void tst_QStringConverter::utf8LongText_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+    QTest::addColumn<QString>("utf16");
+
+    // long enough to go through the SIMD code paths, with every kind of
+    // sequence landing on every position of a block
+    auto addRow = [](const char *name, const char *utf8, const char16_t *utf16) {
+        QTest::newRow(name) << QByteArray(utf8).repeated(4) << QString::fromUtf16(utf16).repeated(4);
+    };
+    addRow("latin1", "Pöschl Düsseldorf Ærøskøbing señor café",
+           u"Pöschl Düsseldorf Ærøskøbing señor café");
+    addRow("greek", "Ξεσκεπάζω την ψυχοφθόρα βδελυγμία",
+           u"Ξεσκεπάζω την ψυχοφθόρα βδελυγμία");
+    addRow("cjk", "我能吞下玻璃而不伤身体。いろはにほへと",
+           u"我能吞下玻璃而不伤身体。いろはにほへと");
+    addRow("mixed", "x\u00e9\u07ff\u0800\ud7ff\ue000\uffff\U0001f600y\u20ac",
+           u"x\u00e9\u07ff\u0800\ud7ff\ue000\uffff\U0001f600y\u20ac");
+}
+
+void tst_QStringConverter::utf8LongText()
+{
+    QFETCH(QByteArray, utf8);
+    QFETCH(QString, utf16);
+
+    QCOMPARE(QString::fromUtf8(utf8), utf16);
+    QCOMPARE(utf16.toUtf8(), utf8);
+    {
+        QStringDecoder decoder(QStringDecoder::Utf8);
+        QCOMPARE(QString(decoder(utf8)), utf16);
+        QVERIFY(!decoder.hasError());
+    }
+
+    // Insert invalid or four-byte sequences at every character boundary:
+    // the result must be the same as decoding the pieces separately
+    static const char *const pieces[] = {
+        "\x80", "\xff", "\xc0\x80", "\xe0\x80\x80", "\xed\xa0\x80", "\xf0\x9f\x98\x80"
+    };
+    qsizetype offset = 0;
+    for (qsizetype i = 0; i <= utf16.size(); ++i) {
+        if (i > 0) {
+            const char16_t c = utf16.at(i - 1).unicode();
+            if (QChar::isHighSurrogate(c))
+                continue;   // between the two halves of a surrogate pair
+            offset += c < 0x80 ? 1 : c < 0x800 ? 2 : QChar::isLowSurrogate(c) ? 4 : 3;
+        }
+
+        for (const char *piece : pieces) {
+            const QByteArray input = utf8.left(offset) + piece + utf8.mid(offset);
+            const QString expected = utf16.left(i) + QString::fromUtf8(piece) + utf16.mid(i);
+            QCOMPARE(QString::fromUtf8(input), expected);
+
+            QStringDecoder decoder(QStringDecoder::Utf8);
+            QCOMPARE(QString(decoder(input)), expected);
+        }
+    }
+}
+
 void tst_QStringConverter::utfHeaders_data()
 {
     QTest::addColumn<QStringConverter::Encoding>("encoding");
@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+
+#include <QtCore/qlocale.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qstringformat.h>
+
+#include <limits>
+
+using namespace Qt::StringLiterals;
+
+class tst_QStringFormat : public QObject
+{
+    Q_OBJECT
+private slots:
+    void parse();
+    void literalOnly();
+    void strings();
+    void characters();
+    void integers();
+    void floatingPoint();
+    void localized();
+    void reorderedAndRepeated();
+    void percentSigns();
+    void stringBuilder();
+    void compareWithArg();
+};
+
+void tst_QStringFormat::parse()
+{
+    using namespace QtPrivate;
+
+    constexpr auto p1 = qParseFormat<9>(u"a %1 b %2");
+    static_assert(p1.error == QFormatError::NoError);
+    static_assert(p1.argumentCount == 2);
+    static_assert(p1.segmentCount == 4);
+    static_assert(p1.literalSize == 5);
+    static_assert(p1.segments[1].argument == 0);
+    static_assert(p1.segments[3].argument == 1);
+
+    constexpr auto p2 = qParseFormat<3>(u"%L1");
+    static_assert(p2.error == QFormatError::NoError);
+    static_assert(p2.localized[0]);
+
+    constexpr auto p3 = qParseFormat<4>(u"%12%");
+    static_assert(p3.argumentCount == 12);
+    static_assert(p3.error == QFormatError::MissingPlaceholder);
+
+    static_assert(qParseFormat<2>(u"%0").error == QFormatError::InvalidPlaceholder);
+    static_assert(qParseFormat<5>(u"%1%L1").error == QFormatError::MixedLocalization);
+    static_assert(qParseFormat<3>(u"%%1").error == QFormatError::NoError);
+    static_assert(qParseFormat<3>(u"%%1").argumentCount == 1);
+    static_assert(qParseFormat<0>(u"").segmentCount == 0);
+}
+
+void tst_QStringFormat::literalOnly()
+{
+    QCOMPARE(QString(qFormat("").arg()), QString());
+    QCOMPARE(QString(qFormat("hello").arg()), u"hello"_s);
+    QCOMPARE(QString(qFormat("100%").arg()), u"100%"_s);
+}
+
+void tst_QStringFormat::strings()
+{
+    const QString s = u"string"_s;
+    QCOMPARE(QString(qFormat("<%1>").arg(s)), u"<string>"_s);
+    QCOMPARE(QString(qFormat("<%1>").arg(QStringView(s).left(3))), u"<str>"_s);
+    QCOMPARE(QString(qFormat("<%1>").arg("latin1"_L1)), u"<latin1>"_s);
+    QCOMPARE(QString(qFormat("<%1>").arg(u"utf16")), u"<utf16>"_s);
+    QCOMPARE(QString(qFormat("<%1>").arg(QString())), u"<>"_s);
+    QCOMPARE(QString(qFormat("%1%2").arg(u"é"_s, "\xe9"_L1)), u"éé"_s);
+}
+
+void tst_QStringFormat::characters()
+{
+    QCOMPARE(QString(qFormat("%1%2%3").arg(QChar(u'a'), u'b', QLatin1Char('c'))), u"abc"_s);
+}
+
+void tst_QStringFormat::integers()
+{
+    QCOMPARE(QString(qFormat("%1").arg(0)), u"0"_s);
+    QCOMPARE(QString(qFormat("%1").arg(-42)), u"-42"_s);
+    QCOMPARE(QString(qFormat("%1").arg(qint8(-128))), u"-128"_s);
+    QCOMPARE(QString(qFormat("%1").arg(quint16(65535))), u"65535"_s);
+    QCOMPARE(QString(qFormat("%1").arg(std::numeric_limits<qint64>::min())),
+             QString::number(std::numeric_limits<qint64>::min()));
+    QCOMPARE(QString(qFormat("%1").arg(std::numeric_limits<quint64>::max())),
+             QString::number(std::numeric_limits<quint64>::max()));
+}
+
+void tst_QStringFormat::floatingPoint()
+{
+    QCOMPARE(QString(qFormat("%1").arg(1.5)), u"1.5"_s);
+    QCOMPARE(QString(qFormat("%1").arg(1.5f)), u"1.5"_s);
+    QCOMPARE(QString(qFormat("%1").arg(1e100)), QString::number(1e100));
+}
+
+void tst_QStringFormat::localized()
+{
+    const QLocale saved;
+    QLocale::setDefault(QLocale(QLocale::German, QLocale::Germany));
+    auto restore = qScopeGuard([&] { QLocale::setDefault(saved); });
+
+    QCOMPARE(QString(qFormat("%L1 / %2").arg(1234567, 1234567)), u"1.234.567 / 1234567"_s);
+    QCOMPARE(QString(qFormat("%L1").arg(-1234)), u"-1.234"_s);
+    QCOMPARE(QString(qFormat("%L1").arg(quint64(1000))), u"1.000"_s);
+    QCOMPARE(QString(qFormat("%L1").arg(2.5)), u"2,5"_s);
+    QCOMPARE(QString(qFormat("%L1").arg(u"text"_s)), u"text"_s);
+}
+
+void tst_QStringFormat::reorderedAndRepeated()
+{
+    QCOMPARE(QString(qFormat("%2 %1 %2").arg(u"a"_s, 7)), u"7 a 7"_s);
+    QCOMPARE(QString(qFormat("%10%9%8%7%6%5%4%3%2%1").arg(1, 2, 3, 4, 5, 6, 7, 8, 9, 10)),
+             u"10987654321"_s);
+}
+
+void tst_QStringFormat::percentSigns()
+{
+    QCOMPARE(QString(qFormat("%%1%").arg(5)), u"%5%"_s);
+    QCOMPARE(QString(qFormat("%L%1").arg(5)), u"%L5"_s);
+    QCOMPARE(QString(qFormat("%x %1").arg(5)), u"%x 5"_s);
+}
+
+void tst_QStringFormat::stringBuilder()
+{
+    const QString key = u"key"_s;
+    const QString value = u"value"_s;
+    const QString result = u"  "_s % qFormat("%1=%2").arg(key, value) % u';';
+    QCOMPARE(result, u"  key=value;"_s);
+
+    QString s = u"x"_s;
+    s += qFormat("[%1]").arg(42);
+    QCOMPARE(s, u"x[42]"_s);
+
+    QCOMPARE(qFormat("%1%2").arg(key, 12345).size(), qsizetype(8));
+}
+
+void tst_QStringFormat::compareWithArg()
+{
+    const QString name = u"file.txt"_s;
+    const int count = 17;
+    const double ratio = 0.25;
+    QCOMPARE(QString(qFormat("%1: %2 (%3)").arg(name, count, ratio)),
+             u"%1: %2 (%3)"_s.arg(name).arg(count).arg(ratio));
+}
+
+QTEST_APPLESS_MAIN(tst_QStringFormat)
+#include "tst_qstringformat.moc"
@@ -108,6 +108,12 @@ private slots:
     void takeAllAndIncreaseMaxThreadCount();
     void waitForDoneAfterTake();
     void threadReuse();
+    void workStealing();
+    void workStealingPriority();
+    void workStealingTryTake();
+    void workStealingTryStart();
+    void workStealingThreadLimit();
+    void workStealingOwnerBlocked();
 
 private:
     QMutex m_functionTestMutex;
@@ -1460,5 +1466,184 @@ void tst_QThreadPool::threadReuse()
     }
 }
 
+class WorkStealingEnabler
+{
+public:
+    WorkStealingEnabler() { qputenv("QT_THREADPOOL_WORK_STEALING", "1"); }
+    ~WorkStealingEnabler() { qunsetenv("QT_THREADPOOL_WORK_STEALING"); }
+};
+
+void tst_QThreadPool::workStealing()
+{
+    WorkStealingEnabler enabler;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+
+    // tasks started from a pool thread go to that thread's local queue,
+    // and must still all run, be it locally or stolen by another thread
+    constexpr int Fanout = 100;
+    QAtomicInt leaves;
+    QSemaphore done;
+    for (int i = 0; i < 10; ++i) {
+        threadPool.start([&] {
+            for (int j = 0; j < Fanout; ++j) {
+                threadPool.start([&] {
+                    leaves.ref();
+                    done.release();
+                });
+            }
+        });
+    }
+    QVERIFY(done.tryAcquire(10 * Fanout, 10000));
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(leaves.loadRelaxed(), 10 * Fanout);
+}
+
+void tst_QThreadPool::workStealingPriority()
+{
+    WorkStealingEnabler enabler;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    QMutex mutex;
+    QList<int> order;
+    threadPool.start([&] {
+        for (int i = 0; i < 10; ++i) {
+            threadPool.start([&] {
+                QMutexLocker locker(&mutex);
+                order.append(0);
+            });
+        }
+        // a task with a higher priority must overtake the local queue
+        threadPool.start([&] {
+            QMutexLocker locker(&mutex);
+            order.append(1);
+        }, 1);
+    });
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(order.size(), 11);
+    QCOMPARE(order.first(), 1);
+}
+
+void tst_QThreadPool::workStealingTryTake()
+{
+    WorkStealingEnabler enabler;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(1);
+
+    bool taken = false;
+    bool ran = false;
+    auto runnable = QRunnable::create([&ran] { ran = true; });
+    runnable->setAutoDelete(false);
+    threadPool.start([&] {
+        threadPool.start(runnable);
+        taken = threadPool.tryTake(runnable);
+    });
+    QVERIFY(threadPool.waitForDone());
+    QVERIFY(taken);
+    QVERIFY(!ran);
+    delete runnable;
+
+    // clear() must also reach the local queues
+    QSemaphore sem;
+    QAtomicInt count;
+    threadPool.start([&] {
+        for (int i = 0; i < 10; ++i)
+            threadPool.start([&count] { count.ref(); });
+        sem.release();
+        QThread::msleep(50);
+    });
+    QVERIFY(sem.tryAcquire(1, 10000));
+    threadPool.clear();
+    QVERIFY(threadPool.waitForDone());
+    QCOMPARE(count.loadRelaxed(), 0);
+}
+
+void tst_QThreadPool::workStealingTryStart()
+{
+    WorkStealingEnabler enabler;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(2);
+
+    // tryStart() from a pool thread succeeds while another thread is
+    // available for the task, like QtConcurrent's thread engines expect
+    QSemaphore started;
+    QSemaphore release;
+    bool first = false;
+    bool second = true;
+    threadPool.start([&] {
+        first = threadPool.tryStart([&] {
+            started.release();
+            release.acquire();
+        });
+        QVERIFY(started.tryAcquire(1, 10000));
+        // both threads are busy now
+        second = threadPool.tryStart([] {});
+        release.release();
+    });
+    QVERIFY(threadPool.waitForDone());
+    QVERIFY(first);
+    QVERIFY(!second);
+}
+
+void tst_QThreadPool::workStealingThreadLimit()
+{
+    WorkStealingEnabler enabler;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(2);
+
+    // threads running their local tasks must notice that a thread was
+    // reserved, and drop back under the limit
+    QAtomicInt running;
+    QAtomicInt maxRunningAfterReserve;
+    QAtomicInt reservedAt;
+    QElapsedTimer timer;
+    timer.start();
+    auto leaf = [&] {
+        const int current = running.fetchAndAddOrdered(1) + 1;
+        const int reserved = reservedAt.loadAcquire();
+        // allow for the tasks that were already started
+        if (reserved && timer.elapsed() > reserved + 20)
+            maxRunningAfterReserve.storeRelaxed(qMax(maxRunningAfterReserve.loadRelaxed(), current));
+        QThread::msleep(1);
+        running.deref();
+    };
+    // every thread that steals a branch gets leaves in its own local queue
+    threadPool.start([&] {
+        for (int i = 0; i < 4; ++i) {
+            threadPool.start([&] {
+                for (int j = 0; j < 100; ++j)
+                    threadPool.start(leaf);
+            });
+        }
+    });
+    QTRY_COMPARE(running.loadAcquire(), 2);
+    threadPool.reserveThread();
+    reservedAt.storeRelease(int(qMax(timer.elapsed(), qint64(1))));
+    QVERIFY(threadPool.waitForDone());
+    threadPool.releaseThread();
+    QCOMPARE(maxRunningAfterReserve.loadRelaxed(), 1);
+}
+
+void tst_QThreadPool::workStealingOwnerBlocked()
+{
+    WorkStealingEnabler enabler;
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(4);
+
+    // a thread that queues tasks locally and then blocks must get them run
+    // by the others
+    constexpr int Tasks = 50;
+    QSemaphore done;
+    bool allDone = false;
+    threadPool.start([&] {
+        for (int i = 0; i < Tasks; ++i)
+            threadPool.start([&done] { done.release(); });
+        allDone = done.tryAcquire(Tasks, 10000);
+    });
+    QVERIFY(threadPool.waitForDone());
+    QVERIFY(allDone);
+}
+
 QTEST_MAIN(tst_QThreadPool);
 #include "tst_qthreadpool.moc"
@@ -0,0 +1,285 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+
+#include <qconcurrentcache.h>
+#include <qthread.h>
+
+#include <memory>
+#include <vector>
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+public slots:
+    void cleanup();
+private slots:
+    void empty();
+    void shardCount();
+    void insert();
+    void insertTooExpensive();
+    void remove();
+    void take();
+    void eviction();
+    void setMaxCost();
+    void statistics();
+    void objectOutlivesEviction();
+    void concurrentAccess();
+};
+
+struct Foo {
+    static QAtomicInt count;
+    Foo(int v = 0) : value(v) { count.ref(); }
+    ~Foo() { count.deref(); }
+    int value;
+};
+
+QAtomicInt Foo::count = 0;
+
+void tst_QConcurrentCache::cleanup()
+{
+    // always check for memory leaks
+    QCOMPARE(Foo::count.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::empty()
+{
+    QConcurrentCache<int, Foo> cache;
+    QCOMPARE(cache.maxCost(), 100);
+    QCOMPARE(cache.size(), 0);
+    QCOMPARE(cache.totalCost(), 0);
+    QVERIFY(cache.isEmpty());
+    QVERIFY(cache.keys().isEmpty());
+    QVERIFY(!cache.contains(1));
+    QVERIFY(!cache.object(1));
+    QVERIFY(!cache.remove(1));
+    QVERIFY(!cache.take(1));
+}
+
+void tst_QConcurrentCache::shardCount()
+{
+    using Cache = QConcurrentCache<int, Foo>;
+    QCOMPARE(Cache().shardCount(), qsizetype(16));
+    QCOMPARE(Cache(100, 0).shardCount(), qsizetype(1));
+    QCOMPARE(Cache(100, 1).shardCount(), qsizetype(1));
+    QCOMPARE(Cache(100, 5).shardCount(), qsizetype(8));
+    QCOMPARE(Cache(100, 64).shardCount(), qsizetype(64));
+}
+
+void tst_QConcurrentCache::insert()
+{
+    QConcurrentCache<int, Foo> cache(1000, 4);
+    for (int i = 0; i < 20; ++i)
+        QVERIFY(cache.insert(i, new Foo(i), 2));
+    QCOMPARE(cache.size(), 20);
+    QCOMPARE(cache.count(), 20);
+    QCOMPARE(cache.totalCost(), 40);
+    QCOMPARE(Foo::count.loadRelaxed(), 20);
+
+    QList<int> keys = cache.keys();
+    std::sort(keys.begin(), keys.end());
+    QCOMPARE(keys.size(), 20);
+    for (int i = 0; i < 20; ++i) {
+        QCOMPARE(keys.at(i), i);
+        QVERIFY(cache.contains(i));
+        QCOMPARE(cache.object(i)->value, i);
+        QCOMPARE(cache[i]->value, i);
+    }
+
+    // replacing an object deletes the old one
+    QVERIFY(cache.insert(5, new Foo(55), 3));
+    QCOMPARE(cache.size(), 20);
+    QCOMPARE(cache.totalCost(), 41);
+    QCOMPARE(Foo::count.loadRelaxed(), 20);
+    QCOMPARE(cache.object(5)->value, 55);
+
+    cache.clear();
+    QVERIFY(cache.isEmpty());
+    QCOMPARE(cache.totalCost(), 0);
+    QCOMPARE(Foo::count.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::insertTooExpensive()
+{
+    // each of the four shards gets a quarter of the maximum cost
+    QConcurrentCache<int, Foo> cache(100, 4);
+    QVERIFY(cache.insert(1, new Foo, 25));
+    QVERIFY(!cache.insert(2, new Foo, 26));
+    QVERIFY(!cache.contains(2));
+    QCOMPARE(Foo::count.loadRelaxed(), 1);
+
+    // a failed insertion removes the previous object, like QCache does
+    QVERIFY(!cache.insert(1, new Foo, 26));
+    QVERIFY(!cache.contains(1));
+    QCOMPARE(Foo::count.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::remove()
+{
+    QConcurrentCache<int, Foo> cache;
+    cache.insert(1, new Foo);
+    cache.insert(2, new Foo);
+    QVERIFY(cache.remove(1));
+    QVERIFY(!cache.remove(1));
+    QVERIFY(!cache.contains(1));
+    QVERIFY(cache.contains(2));
+    QCOMPARE(Foo::count.loadRelaxed(), 1);
+    QCOMPARE(cache.evictionCount(), quint64(0));
+}
+
+void tst_QConcurrentCache::take()
+{
+    QConcurrentCache<int, Foo> cache;
+    cache.insert(1, new Foo(42));
+    QSharedPointer<Foo> foo = cache.take(1);
+    QVERIFY(foo);
+    QCOMPARE(foo->value, 42);
+    QVERIFY(!cache.contains(1));
+    QVERIFY(!cache.take(1));
+    QCOMPARE(Foo::count.loadRelaxed(), 1);
+    foo.reset();
+    QCOMPARE(Foo::count.loadRelaxed(), 0);
+}
+
+void tst_QConcurrentCache::eviction()
+{
+    QConcurrentCache<int, Foo> cache(10, 1);
+    for (int i = 0; i < 10; ++i)
+        cache.insert(i, new Foo(i));
+    QCOMPARE(cache.evictionCount(), quint64(0));
+
+    // touch the oldest object, so that the next one gets evicted instead
+    QVERIFY(cache.object(0));
+    cache.insert(10, new Foo(10));
+    QCOMPARE(cache.size(), 10);
+    QCOMPARE(cache.evictionCount(), quint64(1));
+    QVERIFY(cache.contains(0));
+    QVERIFY(!cache.contains(1));
+
+    cache.insert(11, new Foo(11), 5);
+    QCOMPARE(cache.totalCost(), 10);
+    QCOMPARE(cache.evictionCount(), quint64(6));
+    QCOMPARE(Foo::count.loadRelaxed(), 6);
+}
+
+void tst_QConcurrentCache::setMaxCost()
+{
+    QConcurrentCache<int, Foo> cache(1000, 4);
+    for (int i = 0; i < 100; ++i)
+        cache.insert(i, new Foo(i));
+    QCOMPARE(cache.size(), 100);
+
+    cache.setMaxCost(40);
+    QCOMPARE(cache.maxCost(), 40);
+    QVERIFY(cache.totalCost() <= 40);
+    QCOMPARE(cache.evictionCount(), quint64(100 - cache.size()));
+    QCOMPARE(qsizetype(Foo::count.loadRelaxed()), cache.size());
+
+    // the shares of the shards add up to the maximum cost
+    cache.setMaxCost(7);
+    QVERIFY(cache.totalCost() <= 7);
+    cache.clear();
+    for (int i = 0; i < 1000; ++i)
+        cache.insert(i, new Foo(i));
+    QCOMPARE(cache.totalCost(), 7);
+}
+
+void tst_QConcurrentCache::statistics()
+{
+    QConcurrentCache<int, Foo> cache(2, 1);
+    cache.insert(1, new Foo);
+    cache.insert(2, new Foo);
+    QVERIFY(cache.object(1));
+    QVERIFY(cache.object(2));
+    QVERIFY(!cache.object(3));
+    QVERIFY(cache.contains(1)); // not counted
+    cache.insert(3, new Foo);
+    QCOMPARE(cache.hitCount(), quint64(2));
+    QCOMPARE(cache.missCount(), quint64(1));
+    QCOMPARE(cache.evictionCount(), quint64(1));
+
+    cache.resetStatistics();
+    QCOMPARE(cache.hitCount(), quint64(0));
+    QCOMPARE(cache.missCount(), quint64(0));
+    QCOMPARE(cache.evictionCount(), quint64(0));
+}
+
+void tst_QConcurrentCache::objectOutlivesEviction()
+{
+    QConcurrentCache<int, Foo> cache(1, 1);
+    cache.insert(1, new Foo(1));
+    QSharedPointer<Foo> foo = cache.object(1);
+    cache.insert(2, new Foo(2));
+    QVERIFY(!cache.contains(1));
+    QCOMPARE(Foo::count.loadRelaxed(), 2);
+    QCOMPARE(foo->value, 1);
+    foo.reset();
+    QCOMPARE(Foo::count.loadRelaxed(), 1);
+}
+
+void tst_QConcurrentCache::concurrentAccess()
+{
+    constexpr int ThreadCount = 4;
+    constexpr int Iterations = 20000;
+    constexpr int KeyCount = 500;
+    QConcurrentCache<int, Foo> cache(200, 8);
+    QAtomicInt wrongValues = 0;
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < ThreadCount; ++t) {
+        threads.emplace_back(QThread::create([&cache, &wrongValues, t] {
+            uint key = uint(t);
+            for (int i = 0; i < Iterations; ++i) {
+                key = (key * 1103515245u + 12345u) % KeyCount;
+                const int k = int(key);
+                if (QSharedPointer<Foo> foo = cache.object(k)) {
+                    if (foo->value != k)
+                        wrongValues.ref();
+                } else {
+                    cache.insert(k, new Foo(k), 1 + k % 3);
+                }
+                if (i % 100 == 0)
+                    cache.remove(k);
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        QVERIFY(thread->wait());
+
+    QCOMPARE(wrongValues.loadRelaxed(), 0);
+    QVERIFY(cache.totalCost() <= cache.maxCost());
+    QCOMPARE(cache.hitCount() + cache.missCount(), quint64(ThreadCount * Iterations));
+    QCOMPARE(qsizetype(Foo::count.loadRelaxed()), cache.size());
+    cache.clear();
+}
+
+QTEST_APPLESS_MAIN(tst_QConcurrentCache)
+#include "tst_qconcurrentcache.moc"
@@ -28,6 +28,7 @@
 
 
 #include <QtCore/QCoreApplication>
+#include <QBuffer>
 #include <QTest>
 #include <QScopeGuard>
 #include <QCryptographicHash>
@@ -48,14 +49,20 @@ private slots:
     void intermediary_result_data();
     void intermediary_result();
     void sha1();
+    void sha2();
+    void blockBoundaries_data();
+    void blockBoundaries();
     void sha3_data();
     void sha3();
     void blake2_data();
     void blake2();
     void files_data();
     void files();
+    void device();
     void hashLength_data();
     void hashLength();
+    void hashMany_data() { hashLength_data(); }
+    void hashMany();
     // keep last
     void moreThan4GiBOfData_data();
     void moreThan4GiBOfData();
@@ -213,6 +220,50 @@ void tst_QCryptographicHash::sha1()
              QByteArray("34AA973CD4C4DAA4F61EEB2BDBAD27316534016F"));
 }
 
+void tst_QCryptographicHash::sha2()
+{
+    QCOMPARE(QCryptographicHash::hash("abc", QCryptographicHash::Sha224).toHex(),
+             QByteArray("23097d223405d8228642a477bda255b32aadbce4bda0b3f7e36c9da7"));
+    QCOMPARE(QCryptographicHash::hash("abc", QCryptographicHash::Sha256).toHex(),
+             QByteArray("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad"));
+    QCOMPARE(QCryptographicHash::hash("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+                                      QCryptographicHash::Sha256).toHex(),
+             QByteArray("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1"));
+    QCOMPARE(QCryptographicHash::hash(QByteArray(1'000'000, 'a'), QCryptographicHash::Sha256).toHex(),
+             QByteArray("cdc76e5c9914fb9281a1c7e284d73e67f1809a48a497200e046d39ccc7112cd0"));
+}
+
+void tst_QCryptographicHash::blockBoundaries_data()
+{
+    QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
+    QTest::newRow("sha1") << QCryptographicHash::Sha1;
+    QTest::newRow("sha224") << QCryptographicHash::Sha224;
+    QTest::newRow("sha256") << QCryptographicHash::Sha256;
+    QTest::newRow("sha512") << QCryptographicHash::Sha512;
+}
+
+void tst_QCryptographicHash::blockBoundaries()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+
+    // Feeding the data in pieces of any size, across the block and padding
+    // boundaries, must not change the result
+    QByteArray data(300, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 31 + 7);
+
+    for (int length = 0; length <= data.size(); ++length) {
+        const QByteArrayView message = QByteArrayView(data).first(length);
+        const QByteArray expected = QCryptographicHash::hash(message, algorithm);
+        for (int chunk : { 1, 55, 56, 63, 64, 65, 128 }) {
+            QCryptographicHash hash(algorithm);
+            for (qsizetype i = 0; i < length; i += chunk)
+                hash.addData(message.sliced(i, qMin<qsizetype>(chunk, length - i)));
+            QCOMPARE(hash.resultView(), expected);
+        }
+    }
+}
+
 void tst_QCryptographicHash::sha3_data()
 {
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
@@ -408,6 +459,23 @@ void tst_QCryptographicHash::files()
     }
 }
 
+void tst_QCryptographicHash::device()
+{
+    // larger than the read buffer, and read from the middle
+    QByteArray data(200'000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 7 + 3);
+    QBuffer buffer(&data);
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QVERIFY(buffer.seek(1000));
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    QVERIFY(hash.addData(&buffer));
+    QVERIFY(buffer.atEnd());
+    QCOMPARE(hash.resultView(),
+             QCryptographicHash::hash(QByteArrayView(data).sliced(1000), QCryptographicHash::Sha256));
+}
+
 void tst_QCryptographicHash::hashLength_data()
 {
     QTest::addColumn<QCryptographicHash::Algorithm>("algorithm");
@@ -426,6 +494,26 @@ void tst_QCryptographicHash::hashLength()
     QCOMPARE(QCryptographicHash::hashLength(algorithm), output.length());
 }
 
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(const QCryptographicHash::Algorithm, algorithm);
+
+    QByteArray data(1000, Qt::Uninitialized);
+    for (int i = 0; i < data.size(); ++i)
+        data[i] = char(i * 13 + 5);
+
+    QList<QByteArrayView> messages;
+    for (qsizetype length : { 0, 1, 55, 56, 64, 200, 1000 })
+        messages.append(QByteArrayView(data).first(length));
+
+    const QByteArrayList hashes = QCryptographicHash::hashMany(messages, algorithm);
+    QCOMPARE(hashes.size(), messages.size());
+    for (qsizetype i = 0; i < messages.size(); ++i)
+        QCOMPARE(hashes.at(i), QCryptographicHash::hash(messages.at(i), algorithm));
+
+    QVERIFY(QCryptographicHash::hashMany({}, algorithm).isEmpty());
+}
+
 void tst_QCryptographicHash::moreThan4GiBOfData_data()
 {
 #if QT_POINTER_SIZE > 4
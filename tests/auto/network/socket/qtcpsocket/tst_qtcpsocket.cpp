@@ -60,6 +60,7 @@
 #endif
 #include <QRandomGenerator>
 #include <QStringList>
+#include <QTemporaryFile>
 #include <QTcpServer>
 #include <QTcpSocket>
 #ifndef QT_NO_SSL
@@ -202,6 +203,8 @@ private slots:
     void socketDiscardDataInWriteMode();
     void writeOnReadBufferOverflow();
     void readNotificationsAfterBind();
+    void sendFile();
+    void writeManyChunks();
 
 protected slots:
     void nonBlockingIMAP_hostFound();
@@ -3236,5 +3239,117 @@ void tst_QTcpSocket::readNotificationsAfterBind()
     QCOMPARE(spyReadyRead.count(), 0);
 }
 
+void tst_QTcpSocket::sendFile()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QByteArray contents(256 * 1024, Qt::Uninitialized);
+    for (qsizetype i = 0; i < contents.size(); ++i)
+        contents[i] = char(i * 7 + i / 251);
+
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QCOMPARE(file.write(contents), contents.size());
+
+    SocketPair socketPair;
+    QVERIFY(socketPair.create());
+    QTcpSocket *outgoing = socketPair.endPoints[0];
+    QTcpSocket *incoming = socketPair.endPoints[1];
+    QSignalSpy bytesWrittenSpy(outgoing, &QIODevice::bytesWritten);
+
+    QTest::ignoreMessage(QtWarningMsg, "QAbstractSocket::sendFile: Invalid offset or length");
+    QCOMPARE(outgoing->sendFile(&file, -1), qint64(-1));
+    QCOMPARE(outgoing->sendFile(&file, contents.size() + 1), qint64(0));
+
+    // interleave file ranges with regular writes
+    QByteArray expected = "head";
+    outgoing->write("head");
+    QCOMPARE(outgoing->sendFile(&file, 1000, 100000), qint64(100000));
+    expected += contents.mid(1000, 100000);
+    outgoing->write("middle");
+    expected += "middle";
+    QCOMPARE(outgoing->sendFile(&file, 200000), qint64(contents.size() - 200000));
+    expected += contents.mid(200000);
+    QCOMPARE(outgoing->sendFile(&file), qint64(contents.size()));
+    expected += contents;
+    // the file's position is left alone
+    QCOMPARE(file.pos(), qint64(contents.size()));
+    QVERIFY(file.seek(123));
+    QCOMPARE(outgoing->sendFile(&file, 0, 10), qint64(10));
+    expected += contents.first(10);
+    QCOMPARE(file.pos(), qint64(123));
+    outgoing->write("tail");
+    expected += "tail";
+    QCOMPARE(outgoing->bytesToWrite(), qint64(expected.size()));
+
+    // the file is no longer needed once queued
+    file.close();
+
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size() && timer.elapsed() < 10000) {
+        if (outgoing->bytesToWrite() > 0)
+            outgoing->waitForBytesWritten(100);
+        if (incoming->waitForReadyRead(100))
+            received += incoming->readAll();
+    }
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+    QCOMPARE(outgoing->bytesToWrite(), qint64(0));
+
+    qint64 totalWritten = 0;
+    for (const QList<QVariant> &arguments : std::as_const(bytesWrittenSpy))
+        totalWritten += arguments.at(0).toLongLong();
+    QCOMPARE(totalWritten, qint64(expected.size()));
+}
+
+void tst_QTcpSocket::writeManyChunks()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    SocketPair socketPair;
+    QVERIFY(socketPair.create());
+    QTcpSocket *outgoing = socketPair.endPoints[0];
+    QTcpSocket *incoming = socketPair.endPoints[1];
+    QSignalSpy bytesWrittenSpy(outgoing, &QIODevice::bytesWritten);
+
+    // Small copied writes and large shared QByteArrays alternate, so the
+    // write buffer holds many chunks, more than are written at once.
+    QByteArray expected;
+    for (int i = 0; i < 100; ++i) {
+        const QByteArray header = "header " + QByteArray::number(i) + '\n';
+        QByteArray body(4096 + 37 * i, Qt::Uninitialized);
+        for (qsizetype j = 0; j < body.size(); ++j)
+            body[j] = char(i + j);
+        QCOMPARE(outgoing->write(header.constData(), header.size()), header.size());
+        QCOMPARE(outgoing->write(body), body.size());
+        expected += header + body;
+    }
+    QCOMPARE(outgoing->bytesToWrite(), qint64(expected.size()));
+
+    QByteArray received;
+    QElapsedTimer timer;
+    timer.start();
+    while (received.size() < expected.size() && timer.elapsed() < 10000) {
+        if (outgoing->bytesToWrite() > 0)
+            outgoing->waitForBytesWritten(100);
+        if (incoming->waitForReadyRead(100))
+            received += incoming->readAll();
+    }
+    QCOMPARE(received.size(), expected.size());
+    QVERIFY(received == expected);
+    QCOMPARE(outgoing->bytesToWrite(), qint64(0));
+
+    qint64 totalWritten = 0;
+    for (const QList<QVariant> &arguments : std::as_const(bytesWrittenSpy))
+        totalWritten += arguments.at(0).toLongLong();
+    QCOMPARE(totalWritten, qint64(expected.size()));
+}
+
 QTEST_MAIN(tst_QTcpSocket)
 #include "tst_qtcpsocket.moc"
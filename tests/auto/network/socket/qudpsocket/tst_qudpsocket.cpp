@@ -127,6 +127,7 @@ private slots:
     void readyReadForEmptyDatagram();
     void asyncReadDatagram();
     void writeInHostLookupState();
+    void batchedDatagrams();
 
 protected slots:
     void empty_readyReadSlot();
@@ -1933,5 +1934,54 @@ void tst_QUdpSocket::writeInHostLookupState()
     QVERIFY(!socket.putChar('0'));
 }
 
+void tst_QUdpSocket::batchedDatagrams()
+{
+    QFETCH_GLOBAL(bool, setProxy);
+    if (setProxy)
+        return;
+
+    QUdpSocket server;
+    QVERIFY2(server.bind(QHostAddress::LocalHost, 0), server.errorString().toLatin1().constData());
+    QUdpSocket client;
+    QVERIFY2(client.bind(QHostAddress::LocalHost, 0), client.errorString().toLatin1().constData());
+
+    QVERIFY(server.receiveDatagrams(10).isEmpty());
+
+    QList<QNetworkDatagram> datagrams;
+    for (int i = 0; i < 100; ++i)
+        datagrams.append(QNetworkDatagram(QByteArray(i, char('a' + i % 26)), server.localAddress(),
+                                          server.localPort()));
+
+    QSignalSpy bytesspy(&client, &QUdpSocket::bytesWritten);
+    QCOMPARE(client.writeDatagrams(datagrams), datagrams.size());
+    QCOMPARE(bytesspy.count(), 1);
+    QCOMPARE(bytesspy.at(0).at(0).toLongLong(), qint64(99 * 100 / 2));
+
+    QList<QNetworkDatagram> received;
+    while (received.size() < datagrams.size()) {
+        if (!server.hasPendingDatagrams())
+            QVERIFY(server.waitForReadyRead(5000));
+        received += server.receiveDatagrams(datagrams.size() - received.size());
+    }
+    QCOMPARE(received.size(), datagrams.size());
+    for (int i = 0; i < received.size(); ++i) {
+        QCOMPARE(received.at(i).data(), datagrams.at(i).data());
+        QCOMPARE(received.at(i).senderAddress(), client.localAddress());
+        QCOMPARE(received.at(i).senderPort(), int(client.localPort()));
+        QCOMPARE(received.at(i).destinationPort(), int(server.localPort()));
+    }
+
+    // datagrams larger than maxSize are truncated
+    QCOMPARE(client.writeDatagrams({ datagrams.at(10), datagrams.at(20) }), 2);
+    received.clear();
+    while (received.size() < 2) {
+        if (!server.hasPendingDatagrams())
+            QVERIFY(server.waitForReadyRead(5000));
+        received += server.receiveDatagrams(2 - received.size(), 15);
+    }
+    QCOMPARE(received.at(0).data(), datagrams.at(10).data());
+    QCOMPARE(received.at(1).data(), datagrams.at(20).data().left(15));
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
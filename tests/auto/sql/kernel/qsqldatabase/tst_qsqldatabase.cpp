@@ -200,6 +200,8 @@ private slots:
 
     void sqlite_enableRegexp_data() { generic_data("QSQLITE"); }
     void sqlite_enableRegexp();
+    void sqlite_statementCache_data() { generic_data("QSQLITE"); }
+    void sqlite_statementCache();
 
     void sqlite_openError();
 
@@ -2414,6 +2416,74 @@ void tst_QSqlDatabase::sqlite_enableRegexp()
     QFAIL_SQL(q, next());
 }
 
+void tst_QSqlDatabase::sqlite_statementCache()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+    if (db.driverName().startsWith("QSQLITE2"))
+        QSKIP("SQLite3 specific test");
+
+    db.close();
+    db.setConnectOptions("QSQLITE_STMT_CACHE_SIZE=2");
+    QVERIFY_SQL(db, open());
+    const QSqlDriver *driver = db.driver();
+    QCOMPARE(driver->property("statementCacheSize").toInt(), 2);
+    QCOMPARE(driver->property("statementCacheHits").toLongLong(), 0);
+
+    const QString tableName(qTableName("stmtcache_test", __FILE__, db));
+    QSqlQuery q(db);
+    QVERIFY_SQL(q, exec(QString("CREATE TABLE %1(id INTEGER, text TEXT)").arg(tableName)));
+    const QString insert = QString("INSERT INTO %1 VALUES(?, ?)").arg(tableName);
+    const QString select = QString("SELECT text FROM %1 WHERE id = ?").arg(tableName);
+
+    for (int i = 0; i < 3; ++i) {
+        QSqlQuery insertQuery(db);
+        QVERIFY_SQL(insertQuery, prepare(insert));
+        insertQuery.addBindValue(i);
+        insertQuery.addBindValue(QString::number(i));
+        QVERIFY_SQL(insertQuery, exec());
+    }
+    // the statement is compiled once and reused by the following queries
+    const qint64 hits = driver->property("statementCacheHits").toLongLong();
+    QCOMPARE(hits, 2);
+
+    // two queries using the same text at the same time get separate statements
+    QSqlQuery first(db);
+    QSqlQuery second(db);
+    QVERIFY_SQL(first, prepare(select));
+    QVERIFY_SQL(second, prepare(select));
+    first.addBindValue(1);
+    second.addBindValue(2);
+    QVERIFY_SQL(first, exec());
+    QVERIFY_SQL(second, exec());
+    QVERIFY_SQL(first, next());
+    QVERIFY_SQL(second, next());
+    QCOMPARE(first.value(0).toString(), QString("1"));
+    QCOMPARE(second.value(0).toString(), QString("2"));
+    QCOMPARE(driver->property("statementCacheHits").toLongLong(), hits);
+
+    // a recycled statement starts over without stale bindings or results
+    first.clear();
+    second.clear();
+    QSqlQuery again(db);
+    QVERIFY_SQL(again, prepare(select));
+    QCOMPARE(driver->property("statementCacheHits").toLongLong(), hits + 1);
+    again.addBindValue(0);
+    QVERIFY_SQL(again, exec());
+    QVERIFY_SQL(again, next());
+    QCOMPARE(again.value(0).toString(), QString("0"));
+    QFAIL_SQL(again, next());
+
+    // restore the default connect options for the other tests
+    again.clear();
+    q.clear();
+    db.close();
+    db.setConnectOptions();
+    QVERIFY_SQL(db, open());
+    QCOMPARE(db.driver()->property("statementCacheSize").toInt(), 0);
+}
+
 void tst_QSqlDatabase::sqlite_openError()
 {
     // see QTBUG-70506
@@ -154,6 +154,8 @@ private slots:
     void batchExec();
     void QTBUG_43874_data() { generic_data(); }
     void QTBUG_43874();
+    void psql_batchExecPipelined_data() { generic_data("QPSQL"); }
+    void psql_batchExecPipelined();
     void oraArrayBind_data() { generic_data("QOCI"); }
     void oraArrayBind();
     void lastInsertId_data() { generic_data(); }
@@ -2703,7 +2705,7 @@ void tst_QSqlQuery::batchExec()
 
     // Only test the prepared stored procedure approach where the driver has support
     // for batch operations as this will not work without it
-    if (db.driver()->hasFeature(QSqlDriver::BatchOperations)) {
+    if (dbType == QSqlDriver::Oracle && db.driver()->hasFeature(QSqlDriver::BatchOperations)) {
         const QString procName = qTableName("qtest_batch_proc", __FILE__, db);
         QVERIFY_SQL(q, exec(QLatin1String(
                                 "create or replace procedure %1 (x in timestamp, y out timestamp) "
@@ -2749,6 +2751,59 @@ void tst_QSqlQuery::QTBUG_43874()
     QCOMPARE(q.value(0).toInt(), 1);
 }
 
+void tst_QSqlQuery::psql_batchExecPipelined()
+{
+    QFETCH(QString, dbName);
+    QSqlDatabase defaultDb = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(defaultDb);
+    // pipelining changes the semantics of a failing batch, so it's opt-in
+    QVERIFY(!defaultDb.driver()->hasFeature(QSqlDriver::BatchOperations));
+
+    const auto tidier = qScopeGuard([]() { QSqlDatabase::removeDatabase("pipelineTest"); });
+    QSqlDatabase db = QSqlDatabase::cloneDatabase(defaultDb, "pipelineTest");
+    db.setConnectOptions(QLatin1String("QPSQL_PIPELINE_BATCH"));
+    QVERIFY_SQL(db, open());
+    if (!db.driver()->hasFeature(QSqlDriver::BatchOperations))
+        QSKIP("Database can't do BatchOperations");
+
+    QSqlQuery q(db);
+    const QString tableName = qTableName("qtest_pipeline", __FILE__, db);
+    QVERIFY_SQL(q, exec(QLatin1String("CREATE TABLE %1 (id INT PRIMARY KEY, name VARCHAR(20))")
+                        .arg(tableName)));
+
+    // more rows than the driver keeps in flight at once
+    constexpr int rowCount = 1000;
+    QVariantList ids;
+    QVariantList names;
+    for (int i = 0; i < rowCount; ++i) {
+        ids << i;
+        names << QString::number(i);
+    }
+    QVERIFY_SQL(q, prepare(QLatin1String("INSERT INTO %1 (id, name) VALUES (?, ?)")
+                           .arg(tableName)));
+    q.addBindValue(ids);
+    q.addBindValue(names);
+    QVERIFY_SQL(q, execBatch());
+    QCOMPARE(q.numRowsAffected(), 1);
+
+    QVERIFY_SQL(q, exec(QLatin1String("SELECT COUNT(*), SUM(id) FROM %1").arg(tableName)));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+    QCOMPARE(q.value(1).toInt(), rowCount * (rowCount - 1) / 2);
+
+    // a duplicate key in the middle of the batch rolls back the whole batch
+    QVERIFY_SQL(q, prepare(QLatin1String("INSERT INTO %1 (id, name) VALUES (?, ?)")
+                           .arg(tableName)));
+    q.addBindValue(QVariantList{ rowCount, rowCount + 1, 0, rowCount + 2 });
+    q.addBindValue(QVariantList{ u"a"_s, u"b"_s, u"c"_s, u"d"_s });
+    QVERIFY(!q.execBatch());
+    QCOMPARE(q.lastError().type(), QSqlError::StatementError);
+
+    QVERIFY_SQL(q, exec(QLatin1String("SELECT COUNT(*) FROM %1").arg(tableName)));
+    QVERIFY(q.next());
+    QCOMPARE(q.value(0).toInt(), rowCount);
+}
+
 void tst_QSqlQuery::oraArrayBind()
 {
     QFETCH(QString, dbName);
@@ -28,8 +28,10 @@
 
 #include <QTest>
 #include <QVariantMap>
+#include <qjsonarray.h>
 #include <qjsondocument.h>
 #include <qjsonobject.h>
+#include <qjsonstreamreader.h>
 
 class BenchmarkQtJson: public QObject
 {
@@ -46,6 +48,14 @@ private Q_SLOTS:
     void parseNumbers();
     void parseJson();
     void parseJsonToVariant();
+    void parseLargeJson_data();
+    void parseLargeJson();
+    void streamLargeJson_data();
+    void streamLargeJson();
+    void parseStrings_data();
+    void parseStrings();
+    void toJsonStrings_data();
+    void toJsonStrings();
 
     void jsonObjectInsert();
     void variantMapInsert();
@@ -118,6 +128,122 @@ void BenchmarkQtJson::parseJsonToVariant()
     }
 }
 
+// Generates a log-like document: an array of flat records
+static QByteArray largeJson(int records)
+{
+    QByteArray json = "[\n";
+    for (int i = 0; i < records; ++i) {
+        if (i)
+            json += ",\n";
+        json += "{\"id\":" + QByteArray::number(i)
+                + ",\"timestamp\":" + QByteArray::number(1650000000000LL + i * 17)
+                + ",\"level\":\"" + (i % 10 ? "info" : "warning")
+                + "\",\"message\":\"request " + QByteArray::number(i) + " handled in \\\"/api/v1\\\"\""
+                + ",\"duration\":" + QByteArray::number(i * 0.25)
+                + ",\"tags\":[\"http\",\"server\"],\"cached\":" + (i % 3 ? "false" : "true")
+                + ",\"user\":null}";
+    }
+    json += "\n]\n";
+    return json;
+}
+
+void BenchmarkQtJson::parseLargeJson_data()
+{
+    QTest::addColumn<int>("records");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("100k") << 100000;
+}
+
+void BenchmarkQtJson::parseLargeJson()
+{
+    QFETCH(int, records);
+    const QByteArray testJson = largeJson(records);
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(testJson);
+        qint64 sum = 0;
+        for (const QJsonValue &record : doc.array())
+            sum += record[u"timestamp"].toInteger();
+        QVERIFY(sum);
+    }
+}
+
+void BenchmarkQtJson::streamLargeJson_data()
+{
+    parseLargeJson_data();
+}
+
+void BenchmarkQtJson::streamLargeJson()
+{
+    QFETCH(int, records);
+    const QByteArray testJson = largeJson(records);
+
+    QBENCHMARK {
+        QJsonStreamReader reader(testJson);
+        qint64 sum = 0;
+        while (!reader.atEnd()) {
+            if (reader.readNext() == QJsonStreamReader::Key && reader.rawText() == "timestamp") {
+                reader.readNext();
+                sum += reader.toInteger();
+            }
+        }
+        QVERIFY(!reader.hasError());
+        QVERIFY(sum);
+    }
+}
+
+void BenchmarkQtJson::parseStrings_data()
+{
+    QTest::addColumn<QString>("string");
+
+    QString ascii;
+    QString escaped;
+    QString nonAscii;
+    for (int i = 0; i < 256; ++i) {
+        ascii += QStringLiteral("The quick brown fox jumps over the lazy dog. ");
+        escaped += QStringLiteral("\"quoted\"\tpath: C:\\Temp\\file.txt\n");
+        nonAscii += QStringLiteral("Gr\u00fc\u00dfe aus K\u00f6ln, \u65e5\u672c\u8a9e. ");
+    }
+    QTest::newRow("short") << QStringLiteral("key");
+    QTest::newRow("ascii") << ascii;
+    QTest::newRow("escaped") << escaped;
+    QTest::newRow("non-ascii") << nonAscii;
+}
+
+void BenchmarkQtJson::parseStrings()
+{
+    QFETCH(QString, string);
+    QJsonArray array;
+    for (int i = 0; i < 64; ++i)
+        array.append(string);
+    const QByteArray json = QJsonDocument(array).toJson(QJsonDocument::Compact);
+
+    QBENCHMARK {
+        QJsonDocument doc = QJsonDocument::fromJson(json);
+        QCOMPARE(doc.array().size(), 64);
+    }
+}
+
+void BenchmarkQtJson::toJsonStrings_data()
+{
+    parseStrings_data();
+}
+
+void BenchmarkQtJson::toJsonStrings()
+{
+    QFETCH(QString, string);
+    QJsonArray array;
+    for (int i = 0; i < 64; ++i)
+        array.append(string + QString::number(i));
+    const QJsonDocument doc(array);
+
+    QBENCHMARK {
+        QByteArray json = doc.toJson(QJsonDocument::Compact);
+        QVERIFY(!json.isEmpty());
+    }
+}
+
 void BenchmarkQtJson::jsonObjectInsert()
 {
     QJsonObject object;
@@ -29,12 +29,39 @@
 #include <qtest.h>
 #include <qcoreapplication.h>
 
+#include <memory>
+#include <vector>
+
+class EventCounter : public QObject
+{
+public:
+    static const QEvent::Type CountEvent;
+
+    void count() { ++counter; }
+
+    int counter = 0;
+
+protected:
+    bool event(QEvent *e) override
+    {
+        if (e->type() == CountEvent) {
+            ++counter;
+            return true;
+        }
+        return QObject::event(e);
+    }
+};
+
+const QEvent::Type EventCounter::CountEvent = QEvent::Type(QEvent::registerEventType());
+
 class tst_QCoreApplication : public QObject
 {
 Q_OBJECT
 private slots:
     void event_posting_benchmark_data();
     void event_posting_benchmark();
+    void event_posting_multiple_producers_data();
+    void event_posting_multiple_producers();
 };
 
 void tst_QCoreApplication::event_posting_benchmark_data()
@@ -64,6 +91,54 @@ void tst_QCoreApplication::event_posting_benchmark()
     }
 }
 
+void tst_QCoreApplication::event_posting_multiple_producers_data()
+{
+    QTest::addColumn<int>("producers");
+    QTest::addColumn<bool>("queuedCall");
+    QTest::addColumn<int>("size");
+
+    for (int producers : {1, 2, 4, 8}) {
+        const QByteArray threads = QByteArray::number(producers) + " producers, ";
+        QTest::addRow("%sevents", threads.constData()) << producers << false << 100000;
+        QTest::addRow("%squeued calls", threads.constData()) << producers << true << 100000;
+    }
+}
+
+void tst_QCoreApplication::event_posting_multiple_producers()
+{
+    QFETCH(int, producers);
+    QFETCH(bool, queuedCall);
+    QFETCH(int, size);
+
+    EventCounter counter;
+    const int perProducer = size / producers;
+    const int total = perProducer * producers;
+
+    // benchmark several threads posting concurrently to an object living in
+    // the main thread, then delivering all of the events
+    QBENCHMARK {
+        counter.counter = 0;
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < producers; ++i) {
+            threads.emplace_back(QThread::create([&counter, perProducer, queuedCall] {
+                for (int i = 0; i < perProducer; ++i) {
+                    if (queuedCall) {
+                        QMetaObject::invokeMethod(&counter, &EventCounter::count,
+                                                  Qt::QueuedConnection);
+                    } else {
+                        QCoreApplication::postEvent(&counter, new QEvent(EventCounter::CountEvent));
+                    }
+                }
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            thread->wait();
+        QCoreApplication::sendPostedEvents();
+    }
+    QCOMPARE(counter.counter, total);
+}
+
 QTEST_MAIN(tst_QCoreApplication)
 
 #include "tst_bench_qcoreapplication.moc"
@@ -119,6 +119,8 @@ private slots:
     void indexOfSignal();
     void indexOfSlot_data();
     void indexOfSlot();
+    void indexOfSignalManySignals_data();
+    void indexOfSignalManySignals();
 
     void unconnected_data();
     void unconnected();
@@ -211,6 +213,26 @@ void tst_QMetaObject::indexOfSlot()
     }
 }
 
+void tst_QMetaObject::indexOfSignalManySignals_data()
+{
+    QTest::addColumn<QByteArray>("signal");
+    QTest::newRow("first") << QByteArray("extraSignal1()");
+    QTest::newRow("middle") << QByteArray("extraSignal35()");
+    QTest::newRow("last") << QByteArray("extraSignal70()");
+    QTest::newRow("inherited") << QByteArray("objectNameChanged(QString)");
+    QTest::newRow("missing") << QByteArray("extraSignal71()");
+}
+
+void tst_QMetaObject::indexOfSignalManySignals()
+{
+    QFETCH(QByteArray, signal);
+    const char *p = signal.constData();
+    const QMetaObject *mo = &LotsOfSignals::staticMetaObject;
+    QBENCHMARK {
+        (void)mo->indexOfSignal(p);
+    }
+}
+
 void tst_QMetaObject::unconnected_data()
 {
     QTest::addColumn<int>("signal_index");
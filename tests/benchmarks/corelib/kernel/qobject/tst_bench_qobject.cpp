@@ -32,6 +32,14 @@
 #include <qcoreapplication.h>
 #include <qdatetime.h>
 
+#include <memory>
+#include <vector>
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#  include <malloc.h>
+#  define HAVE_MALLINFO2
+#endif
+
 enum {
     CreationDeletionBenckmarkConstant = 34567,
     SignalsAndSlotsBenchmarkConstant = 456789
@@ -51,6 +59,10 @@ private slots:
     void connect_disconnect_benchmark_data();
     void connect_disconnect_benchmark();
     void receiver_destroyed_benchmark();
+    void small_objects_connection_memory_data();
+    void small_objects_connection_memory();
+    void small_objects_emit_data();
+    void small_objects_emit();
 
     void stdAllocator();
 };
@@ -305,6 +317,96 @@ void tst_QObject::receiver_destroyed_benchmark()
     }
 }
 
+// Many small objects with one or two connections each, as in a model layer
+static std::vector<std::unique_ptr<Object>> createSmallObjects(int count)
+{
+    std::vector<std::unique_ptr<Object>> objects;
+    objects.reserve(count);
+    for (int i = 0; i < count; ++i)
+        objects.emplace_back(new Object);
+    return objects;
+}
+
+static void connectSmallObjects(const std::vector<std::unique_ptr<Object>> &objects,
+                                int connectionCount, bool lastSignals)
+{
+    for (const auto &object : objects) {
+        if (lastSignals) {
+            QObject::connect(object.get(), &Object::signal9, object.get(), &Object::slot9);
+            if (connectionCount > 1)
+                QObject::connect(object.get(), &Object::signal8, object.get(), &Object::slot8);
+        } else {
+            QObject::connect(object.get(), &Object::signal0, object.get(), &Object::slot0);
+            if (connectionCount > 1)
+                QObject::connect(object.get(), &Object::signal1, object.get(), &Object::slot1);
+        }
+    }
+}
+
+static void emitSmallObjects(const std::vector<std::unique_ptr<Object>> &objects, bool lastSignals)
+{
+    for (const auto &object : objects) {
+        if (lastSignals)
+            emit object->signal9();
+        else
+            emit object->signal0();
+    }
+}
+
+static void smallObjectsData()
+{
+    QTest::addColumn<int>("connectionCount");
+    QTest::addColumn<bool>("lastSignals");
+    QTest::newRow("1 connection, first signal") << 1 << false;
+    QTest::newRow("2 connections, first signals") << 2 << false;
+    QTest::newRow("1 connection, last signal") << 1 << true;
+    QTest::newRow("2 connections, last signals") << 2 << true;
+}
+
+void tst_QObject::small_objects_connection_memory_data()
+{
+    smallObjectsData();
+}
+
+void tst_QObject::small_objects_connection_memory()
+{
+#ifdef HAVE_MALLINFO2
+    QFETCH(int, connectionCount);
+    QFETCH(bool, lastSignals);
+
+    const int objectCount = 100000;
+    const auto objects = createSmallObjects(objectCount);
+    const size_t before = mallinfo2().uordblks;
+    connectSmallObjects(objects, connectionCount, lastSignals);
+    // emitting releases the storage that got replaced while connecting
+    emitSmallObjects(objects, lastSignals);
+    const size_t after = mallinfo2().uordblks;
+
+    // heap memory used for the connections, per object
+    QTest::setBenchmarkResult(qreal(after - before) / objectCount, QTest::BytesAllocated);
+#else
+    QSKIP("This test needs mallinfo2() to measure the heap usage.");
+#endif
+}
+
+void tst_QObject::small_objects_emit_data()
+{
+    smallObjectsData();
+}
+
+void tst_QObject::small_objects_emit()
+{
+    QFETCH(int, connectionCount);
+    QFETCH(bool, lastSignals);
+
+    const auto objects = createSmallObjects(10000);
+    connectSmallObjects(objects, connectionCount, lastSignals);
+
+    QBENCHMARK {
+        emitSmallObjects(objects, lastSignals);
+    }
+}
+
 QTEST_MAIN(tst_QObject)
 
 #include "tst_bench_qobject.moc"
@@ -0,0 +1,161 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QtCore/qsharedmemorychannel.h>
+#include <QtCore/qthread.h>
+
+using namespace Qt::StringLiterals;
+
+class tst_QSharedMemoryChannel : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void writeRead_data();
+    void writeRead();
+    void zeroCopy();
+    void pingPong_data();
+    void pingPong();
+
+private:
+    QString uniqueKey(const char *name = "") const
+    {
+        return "tst_bench_qsharedmemorychannel_%1_%2%3"_L1
+                .arg(QString::number(QCoreApplication::applicationPid()),
+                     QLatin1StringView(QTest::currentTestFunction()), QLatin1StringView(name));
+    }
+};
+
+void tst_QSharedMemoryChannel::writeRead_data()
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("8") << 8;
+    QTest::newRow("64") << 64;
+    QTest::newRow("1024") << 1024;
+}
+
+void tst_QSharedMemoryChannel::writeRead()
+{
+    QFETCH(int, size);
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(1024, size), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(producer.key());
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+    const QByteArray message(size, 'x');
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            producer.write(message);
+        for (int i = 0; i < 1000; ++i)
+            consumer.read();
+    }
+}
+
+void tst_QSharedMemoryChannel::zeroCopy()
+{
+    QSharedMemoryChannel producer(uniqueKey());
+    QVERIFY2(producer.create(1024, sizeof(qint64)), qPrintable(producer.errorString()));
+    QSharedMemoryChannel consumer(producer.key());
+    QVERIFY2(consumer.attach(), qPrintable(consumer.errorString()));
+
+    qint64 sum = 0;
+    QBENCHMARK {
+        for (qint64 i = 0; i < 1000; ++i) {
+            memcpy(producer.reserve(sizeof(i)), &i, sizeof(i));
+            producer.commit();
+        }
+        for (int i = 0; i < 1000; ++i) {
+            qint64 value;
+            memcpy(&value, consumer.beginRead().data(), sizeof(value));
+            consumer.endRead();
+            sum += value;
+        }
+    }
+    QVERIFY(sum > 0);
+}
+
+void tst_QSharedMemoryChannel::pingPong_data()
+{
+    QTest::addColumn<bool>("blocking");
+
+    QTest::newRow("waitForReadyRead") << true;
+    QTest::newRow("polling") << false;
+}
+
+// round trip between two threads; the channels work the same way between
+// processes
+void tst_QSharedMemoryChannel::pingPong()
+{
+    QFETCH(bool, blocking);
+    QSharedMemoryChannel ping(uniqueKey("ping"));
+    QVERIFY2(ping.create(16, 64), qPrintable(ping.errorString()));
+    QSharedMemoryChannel pong(uniqueKey("pong"));
+    QVERIFY2(pong.create(16, 64), qPrintable(pong.errorString()));
+
+    auto receive = [blocking](QSharedMemoryChannel &channel) {
+        for (;;) {
+            const QByteArray message = channel.read();
+            if (!message.isNull())
+                return message;
+            if (blocking)
+                channel.waitForReadyRead(-1);
+            else
+                QThread::yieldCurrentThread();
+        }
+    };
+
+    QThread *thread = QThread::create([&] {
+        QSharedMemoryChannel in(ping.key());
+        QSharedMemoryChannel out(pong.key());
+        if (!in.attach() || !out.attach())
+            return;
+        for (;;) {
+            const QByteArray message = receive(in);
+            out.write(message);
+            if (message == "quit")
+                break;
+        }
+    });
+    thread->start();
+
+    QBENCHMARK {
+        ping.write("ping");
+        receive(pong);
+    }
+
+    ping.write("quit");
+    QCOMPARE(receive(pong), "quit");
+    QVERIFY(thread->wait());
+    delete thread;
+}
+
+QTEST_MAIN(tst_QSharedMemoryChannel)
+
+#include "tst_bench_qsharedmemorychannel.moc"
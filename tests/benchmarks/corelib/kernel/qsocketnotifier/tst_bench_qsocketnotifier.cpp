@@ -0,0 +1,126 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QSocketNotifier>
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+// Measures the cost of one socket notifier activation while a growing
+// number of idle notifiers is registered with the same event dispatcher.
+// Run once as is and once with QT_EVENT_DISPATCHER_EPOLL=1 (and QT_NO_GLIB=1
+// where applicable) to compare the poll() and epoll() backends.
+
+class tst_QSocketNotifier : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void activateWithIdleNotifiers_data();
+    void activateWithIdleNotifiers();
+};
+
+void tst_QSocketNotifier::initTestCase()
+{
+    // every idle notifier needs its own descriptor
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < limit.rlim_max) {
+        limit.rlim_cur = limit.rlim_max;
+        setrlimit(RLIMIT_NOFILE, &limit);
+    }
+}
+
+void tst_QSocketNotifier::activateWithIdleNotifiers_data()
+{
+    QTest::addColumn<int>("idleCount");
+    QTest::newRow("0 idle") << 0;
+    QTest::newRow("100 idle") << 100;
+    QTest::newRow("1000 idle") << 1000;
+    QTest::newRow("10000 idle") << 10000;
+    QTest::newRow("20000 idle") << 20000;
+}
+
+void tst_QSocketNotifier::activateWithIdleNotifiers()
+{
+    QFETCH(int, idleCount);
+
+    rlimit limit;
+    if (getrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur < rlim_t(idleCount + 64))
+        QSKIP("Not enough file descriptors available");
+
+    int idlePipe[2];
+    int activePipe[2];
+    QVERIFY(pipe(idlePipe) == 0);
+    QVERIFY(pipe(activePipe) == 0);
+
+    // nothing is ever written to idlePipe, so its duplicates never become readable
+    std::vector<int> idleFds;
+    std::vector<std::unique_ptr<QSocketNotifier>> idleNotifiers;
+    idleFds.reserve(idleCount);
+    idleNotifiers.reserve(idleCount);
+    for (int i = 0; i < idleCount; ++i) {
+        const int fd = dup(idlePipe[0]);
+        QVERIFY(fd != -1);
+        idleFds.push_back(fd);
+        idleNotifiers.emplace_back(new QSocketNotifier(fd, QSocketNotifier::Read));
+    }
+
+    int activations = 0;
+    QSocketNotifier notifier(activePipe[0], QSocketNotifier::Read);
+    connect(&notifier, &QSocketNotifier::activated, this, [&](QSocketDescriptor socket) {
+        char c;
+        if (read(socket, &c, 1) == 1)
+            ++activations;
+    });
+
+    int writes = 0;
+    QBENCHMARK {
+        QVERIFY(write(activePipe[1], "q", 1) == 1);
+        ++writes;
+        QCoreApplication::processEvents();
+    }
+    QCOMPARE(activations, writes);
+
+    idleNotifiers.clear();
+    for (int fd : idleFds)
+        close(fd);
+    close(idlePipe[0]);
+    close(idlePipe[1]);
+    close(activePipe[0]);
+    close(activePipe[1]);
+}
+
+QTEST_MAIN(tst_QSocketNotifier)
+
+#include "tst_bench_qsocketnotifier.moc"
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QCoreApplication>
+#include <QTimer>
+#include <QTest>
+
+#include <memory>
+#include <vector>
+
+class tst_QTimer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void restartIdleTimers_data();
+    void restartIdleTimers();
+    void activateAmongIdleTimers_data();
+    void activateAmongIdleTimers();
+};
+
+using Timers = std::vector<std::unique_ptr<QTimer>>;
+
+// Many long-running timers, like idle or keep-alive timeouts of connections
+static Timers startIdleTimers(int count, Qt::TimerType type, int interval)
+{
+    Timers timers;
+    timers.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        timers.emplace_back(new QTimer);
+        QTimer *timer = timers.back().get();
+        timer->setTimerType(type);
+        timer->start(interval + i % 1000);
+    }
+    return timers;
+}
+
+void tst_QTimer::restartIdleTimers_data()
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<Qt::TimerType>("type");
+    QTest::addColumn<int>("interval");
+
+    for (int count : {1000, 10000, 100000}) {
+        QTest::addRow("precise-%d", count) << count << Qt::PreciseTimer << 30000;
+        QTest::addRow("coarse-%d", count) << count << Qt::CoarseTimer << 10000;
+        QTest::addRow("verycoarse-%d", count) << count << Qt::VeryCoarseTimer << 60000;
+    }
+}
+
+void tst_QTimer::restartIdleTimers()
+{
+    QFETCH(int, count);
+    QFETCH(Qt::TimerType, type);
+    QFETCH(int, interval);
+
+    Timers timers = startIdleTimers(count, type, interval);
+
+    // restart a thousand of them in an arbitrary order, as when traffic
+    // arrives on some of the connections
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            timers[(i * 7919) % count]->start();
+    }
+}
+
+void tst_QTimer::activateAmongIdleTimers_data()
+{
+    QTest::addColumn<int>("count");
+
+    for (int count : {0, 1000, 10000, 100000})
+        QTest::addRow("%d", count) << count;
+}
+
+void tst_QTimer::activateAmongIdleTimers()
+{
+    QFETCH(int, count);
+
+    Timers timers = startIdleTimers(count, Qt::CoarseTimer, 10000);
+
+    // a zero timer is rescheduled every time it fires
+    int fired = 0;
+    QTimer zeroTimer;
+    connect(&zeroTimer, &QTimer::timeout, this, [&fired] { ++fired; });
+    zeroTimer.start(0);
+
+    QBENCHMARK {
+        for (int i = 0; i < 1000; ++i)
+            QCoreApplication::processEvents();
+    }
+    QVERIFY(fired > 0);
+}
+
+QTEST_MAIN(tst_QTimer)
+
+#include "tst_bench_qtimer.moc"
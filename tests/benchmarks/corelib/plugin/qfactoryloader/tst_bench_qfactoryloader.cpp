@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+#include <QTest>
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qlibrary.h>
+#include <QtCore/qscopeguard.h>
+#include <QtCore/qtemporarydir.h>
+#include <private/qfactoryloader_p.h>
+
+using namespace Qt::StringLiterals;
+
+static const char pluginIid[] = "org.qt-project.Qt.benchmarks.qfactoryloader";
+static constexpr int PluginCount = 100;
+
+class tst_QFactoryLoader : public QObject
+{
+    Q_OBJECT
+
+    QTemporaryDir tempDir;
+    QString pluginDir;
+
+private slots:
+    void initTestCase();
+    void construct_data();
+    void construct();
+};
+
+void tst_QFactoryLoader::initTestCase()
+{
+    QVERIFY2(tempDir.isValid(), qPrintable(tempDir.errorString()));
+    QCoreApplication::setLibraryPaths(QStringList());
+
+    const QString binFolder = QFINDTESTDATA("bin");
+    QVERIFY2(!binFolder.isEmpty(), "Unable to locate 'bin' folder");
+    QString plugin;
+    const QFileInfoList candidates = QDir(binFolder).entryInfoList(QDir::Files);
+    for (const QFileInfo &fi : candidates) {
+        if (QLibrary::isLibrary(fi.fileName()))
+            plugin = fi.absoluteFilePath();
+    }
+    QVERIFY(!plugin.isEmpty());
+
+    // a plugin directory with many plugins, like the ones of a full Qt installation
+    pluginDir = tempDir.filePath("plugins");
+    QVERIFY(QDir().mkpath(pluginDir));
+    const QString suffix = QFileInfo(plugin).completeSuffix();
+    for (int i = 0; i < PluginCount; ++i)
+        QVERIFY(QFile::copy(plugin, pluginDir + "/plugin"_L1 + QString::number(i) + u'.' + suffix));
+}
+
+void tst_QFactoryLoader::construct_data()
+{
+    QTest::addColumn<bool>("useCache");
+
+    QTest::newRow("no-cache") << false;
+    QTest::newRow("cache") << true;
+}
+
+void tst_QFactoryLoader::construct()
+{
+    QFETCH(bool, useCache);
+
+    if (useCache)
+        qputenv("QT_PLUGIN_METADATA_CACHE", QFile::encodeName(tempDir.filePath("cache.cbor")));
+    auto cleanup = qScopeGuard([] { qunsetenv("QT_PLUGIN_METADATA_CACHE"); });
+
+    auto scan = [this] {
+        QFactoryLoader loader(pluginIid, "/nonexistent");
+        loader.setExtraSearchPath(pluginDir);
+        return loader.metaData().size();
+    };
+
+    // warm up, and fill the cache if enabled
+    QCOMPARE(scan(), PluginCount);
+
+    QBENCHMARK {
+        scan();
+    }
+}
+
+QTEST_MAIN(tst_QFactoryLoader)
+
+#include "tst_bench_qfactoryloader.moc"
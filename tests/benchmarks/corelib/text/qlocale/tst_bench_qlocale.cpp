@@ -54,6 +54,10 @@ private Q_SLOTS:
     void toUpper_QLocale_2();
     void toUpper_QString();
     void number_QString();
+    void toString_double_data();
+    void toString_double();
+    void toDouble_data();
+    void toDouble();
 };
 
 static QString data()
@@ -392,6 +396,64 @@ void tst_QLocale::number_QString()
     }
 }
 
+static void doubleConversionData()
+{
+    QTest::addColumn<QLocale>("locale");
+    QTest::addColumn<double>("number");
+    QTest::addColumn<QString>("string");
+
+    const QLocale c = QLocale::c();
+    const QLocale english(QLocale::English, QLocale::UnitedStates);
+    const QLocale german(QLocale::German, QLocale::Germany);
+    const QLocale arabic(QLocale::Arabic, QLocale::Egypt);
+
+    QTest::newRow("C, 0.1") << c << 0.1 << QStringLiteral("0.1");
+    QTest::newRow("C, -1234.5678") << c << -1234.5678 << QStringLiteral("-1234.5678");
+    QTest::newRow("C, 1e+300") << c << 1.2345e300 << QStringLiteral("1.2345e+300");
+    QTest::newRow("en_US, -1234.5678") << english << -1234.5678 << QStringLiteral("-1,234.5678");
+    QTest::newRow("de_DE, -1234.5678") << german << -1234.5678 << QStringLiteral("-1.234,5678");
+    QTest::newRow("ar_EG, -1234.5678") << arabic << -1234.5678 << arabic.toString(-1234.5678, 'g',
+                                            QLocale::FloatingPointShortest);
+}
+
+void tst_QLocale::toString_double_data()
+{
+    doubleConversionData();
+}
+
+void tst_QLocale::toString_double()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(double, number);
+    QFETCH(QString, string);
+
+    QString result;
+    QBENCHMARK {
+        result = locale.toString(number, 'g', QLocale::FloatingPointShortest);
+    }
+    QCOMPARE(result, string);
+}
+
+void tst_QLocale::toDouble_data()
+{
+    doubleConversionData();
+}
+
+void tst_QLocale::toDouble()
+{
+    QFETCH(QLocale, locale);
+    QFETCH(double, number);
+    QFETCH(QString, string);
+
+    double result = 0;
+    bool ok = false;
+    QBENCHMARK {
+        result = locale.toDouble(string, &ok);
+    }
+    QVERIFY(ok);
+    QCOMPARE(result, number);
+}
+
 QTEST_MAIN(tst_QLocale)
 
 #include "tst_bench_qlocale.moc"
@@ -26,7 +26,9 @@
 **
 ****************************************************************************/
 
+#include <QMultiStringMatcher>
 #include <QRegularExpression>
+#include <QRegularExpressionSet>
 #include <QTest>
 
 /*!
@@ -70,6 +72,21 @@ private slots:
     void queryMatchResultsByGroupIndex();
     void queryMatchResultsByGroupName();
     void iterateThroughGlobalMatchResults();
+
+    void matchManyOneByOne();
+    void matchManyWithSet();
+    void containsManyOneByOne();
+    void containsManyWithMatcher();
+    void containsManyWithMatcherUtf8();
+
+private:
+    void initLogFilters();
+
+    QList<QRegularExpression> logRules;
+    QStringList logKeywords;
+    QStringList logLines;
+    qsizetype expectedRuleMatches = 0;
+    qsizetype expectedKeywordMatches = 0;
 };
 
 void tst_QRegularExpressionBenchmark::createDefault()
@@ -295,6 +312,120 @@ void tst_QRegularExpressionBenchmark::iterateThroughGlobalMatchResults()
     }
 }
 
+/*!
+    \internal A log router: a few hundred rules, each of which the lines are
+    matched against. The rules are specific enough that most lines only
+    match one or none of them.
+*/
+void tst_QRegularExpressionBenchmark::initLogFilters()
+{
+    if (!logLines.isEmpty())
+        return;
+
+    static const char *const components[] = {
+        "network", "storage", "scheduler", "renderer", "audio", "input", "license", "updater"
+    };
+    static const char *const events[] = {
+        "connection refused", "timeout after", "retrying", "cache miss", "queue full",
+        "checksum mismatch", "permission denied", "disconnected", "unexpected reply",
+        "buffer underrun", "invalid state", "out of memory"
+    };
+    for (int i = 0; i < 300; ++i) {
+        const QString component = QString::fromLatin1(components[i % std::size(components)]);
+        const QString event = QString::fromLatin1(events[i % std::size(events)]);
+        logKeywords.append(QStringLiteral("%1#%2 %3").arg(component).arg(i).arg(event));
+        logRules.append(QRegularExpression(QStringLiteral("^\\[\\d+\\] %1#%2 %3( \\d+ ms)?$")
+                                           .arg(component).arg(i).arg(event)));
+    }
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 10 == 0) {
+            logLines.append(QStringLiteral("[%1] %2 42 ms").arg(i).arg(logKeywords.at(i % 300)));
+        } else {
+            logLines.append(QStringLiteral("[%1] %2: nothing to report on %3")
+                            .arg(i).arg(QLatin1StringView(components[i % std::size(components)]))
+                            .arg(QLatin1StringView(events[i % std::size(events)])));
+        }
+    }
+
+    for (const QString &line : std::as_const(logLines)) {
+        for (const QRegularExpression &re : std::as_const(logRules))
+            expectedRuleMatches += re.match(line).hasMatch();
+        for (const QString &keyword : std::as_const(logKeywords))
+            expectedKeywordMatches += line.contains(keyword);
+    }
+    QCOMPARE(expectedRuleMatches, 100);
+}
+
+void tst_QRegularExpressionBenchmark::matchManyOneByOne()
+{
+    initLogFilters();
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QString &line : std::as_const(logLines)) {
+            for (const QRegularExpression &re : std::as_const(logRules))
+                matches += re.match(line).hasMatch();
+        }
+    }
+    QCOMPARE(matches, expectedRuleMatches);
+}
+
+void tst_QRegularExpressionBenchmark::matchManyWithSet()
+{
+    initLogFilters();
+    const QRegularExpressionSet set(logRules);
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QString &line : std::as_const(logLines))
+            matches += set.matchingExpressions(line).size();
+    }
+    QCOMPARE(matches, expectedRuleMatches);
+}
+
+void tst_QRegularExpressionBenchmark::containsManyOneByOne()
+{
+    initLogFilters();
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QString &line : std::as_const(logLines)) {
+            for (const QString &keyword : std::as_const(logKeywords))
+                matches += line.contains(keyword);
+        }
+    }
+    QCOMPARE(matches, expectedKeywordMatches);
+}
+
+void tst_QRegularExpressionBenchmark::containsManyWithMatcher()
+{
+    initLogFilters();
+    const QMultiStringMatcher matcher(logKeywords);
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QString &line : std::as_const(logLines))
+            matches += matcher.matchingPatterns(line).size();
+    }
+    QCOMPARE(matches, expectedKeywordMatches);
+}
+
+void tst_QRegularExpressionBenchmark::containsManyWithMatcherUtf8()
+{
+    initLogFilters();
+    const QMultiStringMatcher matcher(logKeywords);
+    QByteArrayList utf8Lines;
+    for (const QString &line : std::as_const(logLines))
+        utf8Lines.append(line.toUtf8());
+    qsizetype matches = 0;
+    QBENCHMARK {
+        matches = 0;
+        for (const QByteArray &line : std::as_const(utf8Lines))
+            matches += matcher.matchingPatterns(line).size();
+    }
+    QCOMPARE(matches, expectedKeywordMatches);
+}
+
 QTEST_MAIN(tst_QRegularExpressionBenchmark)
 
 #include "tst_bench_qregularexpression.moc"
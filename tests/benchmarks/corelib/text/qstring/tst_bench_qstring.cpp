@@ -26,10 +26,13 @@
 **
 ****************************************************************************/
 #include <QStringList>
+#include <QStringFormat>
 #include <QFile>
 #include <QTest>
 #include <limits>
 
+using namespace Qt::StringLiterals;
+
 class tst_QString: public QObject
 {
     Q_OBJECT
@@ -57,6 +60,19 @@ private slots:
     void number_double_data();
     void number_double();
 
+    void toDouble_data();
+    void toDouble();
+
+    void fromUtf8_data();
+    void fromUtf8();
+    void toUtf8_data() { fromUtf8_data(); }
+    void toUtf8();
+
+    void format_argChain();
+    void format_argMulti();
+    void format_qFormat();
+    void format_qFormatStringBuilder();
+
 private:
     void section_data_impl(bool includeRegExOnly = true);
     template <typename RX> void section_impl();
@@ -296,6 +312,13 @@ void tst_QString::number_double_data()
         { 0.0001, 'E', 1, QStringLiteral("1.0E-04") },
         { 1e8, 'E', 1, QStringLiteral("1.0E+08") },
         { -1e8, 'E', 1, QStringLiteral("-1.0E+08") },
+        { 0.1, 'g', QLocale::FloatingPointShortest, QStringLiteral("0.1") },
+        { -1234.5678, 'f', QLocale::FloatingPointShortest, QStringLiteral("-1234.5678") },
+        { 0.5 + qSqrt(1.25), 'g', QLocale::FloatingPointShortest,
+          QStringLiteral("1.618033988749895") },
+        { 3.3e-300, 'e', QLocale::FloatingPointShortest, QStringLiteral("3.3e-300") },
+        { std::numeric_limits<double>::max(), 'g', QLocale::FloatingPointShortest,
+          QStringLiteral("1.7976931348623157e+308") },
     };
 
     for (auto &datum : data) {
@@ -319,6 +342,122 @@ void tst_QString::number_double()
     QCOMPARE(actual, expected);
 }
 
+void tst_QString::toDouble_data()
+{
+    QTest::addColumn<QString>("string");
+    QTest::addColumn<double>("expected");
+
+    QTest::newRow("0") << u"0"_s << 0.0;
+    QTest::newRow("0.1") << u"0.1"_s << 0.1;
+    QTest::newRow("-1234.5678") << u"-1234.5678"_s << -1234.5678;
+    QTest::newRow("1.618033988749895") << u"1.618033988749895"_s << 0.5 + qSqrt(1.25);
+    QTest::newRow("3.3e-300") << u"3.3e-300"_s << 3.3e-300;
+    QTest::newRow("1.7976931348623157e+308") << u"1.7976931348623157e+308"_s
+                                               << std::numeric_limits<double>::max();
+}
+
+void tst_QString::toDouble()
+{
+    QFETCH(QString, string);
+    QFETCH(double, expected);
+
+    double actual = 0;
+    bool ok = false;
+    QBENCHMARK {
+        actual = string.toDouble(&ok);
+    }
+    QVERIFY(ok);
+    QCOMPARE(actual, expected);
+}
+
+void tst_QString::fromUtf8_data()
+{
+    QTest::addColumn<QByteArray>("utf8");
+
+    auto addRow = [](const char *name, const char *sample) {
+        QByteArray text;
+        while (text.size() < 4096)
+            text += sample;
+        QTest::newRow(name) << text;
+    };
+    addRow("ascii", "The quick brown fox jumps over the lazy dog. ");
+    addRow("latin1", "Pöschl Düsseldorf Ærøskøbing señor café naïve. ");
+    addRow("greek", "Ξεσκεπάζω την ψυχοφθόρα βδελυγμία. ");
+    addRow("cyrillic", "Съешь же ещё этих мягких французских булок. ");
+    addRow("arabic", "نص حكيم له سر قاطع وذو شأن عظيم. ");
+    addRow("hindi", "ऋषियों को सताने वाले दुष्ट राक्षसों के राजा। ");
+    addRow("chinese", "我能吞下玻璃而不伤身体。");
+    addRow("japanese", "いろはにほへと ちりぬるを わかよたれそ つねならむ。");
+    addRow("emoji", "Emoji 😀🎉 mixed with text. ");
+}
+
+void tst_QString::fromUtf8()
+{
+    QFETCH(QByteArray, utf8);
+
+    QBENCHMARK {
+        [[maybe_unused]] auto r = QString::fromUtf8(utf8);
+    }
+}
+
+void tst_QString::toUtf8()
+{
+    QFETCH(QByteArray, utf8);
+    const QString s = QString::fromUtf8(utf8);
+
+    QByteArray actual;
+    QBENCHMARK {
+        actual = s.toUtf8();
+    }
+    QCOMPARE(actual, utf8);
+}
+
+static const QString formatName = u"report.txt"_s;
+static const QString formatState = u"done"_s;
+static constexpr int formatCount = 1234;
+static constexpr int formatTotal = 56789;
+static const QString formatExpected = u"report.txt: 1234 of 56789 items (done)"_s;
+
+void tst_QString::format_argChain()
+{
+    QString actual;
+    QBENCHMARK {
+        actual = u"%1: %2 of %3 items (%4)"_s.arg(formatName).arg(formatCount).arg(formatTotal)
+                         .arg(formatState);
+    }
+    QCOMPARE(actual, formatExpected);
+}
+
+void tst_QString::format_argMulti()
+{
+    QString actual;
+    QBENCHMARK {
+        actual = u"%1: %2 of %3 items (%4)"_s.arg(formatName, QString::number(formatCount),
+                                                  QString::number(formatTotal), formatState);
+    }
+    QCOMPARE(actual, formatExpected);
+}
+
+void tst_QString::format_qFormat()
+{
+    QString actual;
+    QBENCHMARK {
+        actual = qFormat("%1: %2 of %3 items (%4)").arg(formatName, formatCount, formatTotal,
+                                                        formatState);
+    }
+    QCOMPARE(actual, formatExpected);
+}
+
+void tst_QString::format_qFormatStringBuilder()
+{
+    QString actual;
+    QBENCHMARK {
+        actual = qFormat("%1: %2").arg(formatName, formatCount) % u" of "
+                % qFormat("%1 items (%2)").arg(formatTotal, formatState);
+    }
+    QCOMPARE(actual, formatExpected);
+}
+
 QTEST_APPLESS_MAIN(tst_QString)
 
 #include "tst_bench_qstring.moc"
@@ -40,6 +40,12 @@ public:
 private slots:
     void startRunnables();
     void activeThreadCount();
+    void startFromPoolThreads_data();
+    void startFromPoolThreads();
+    void recursiveSplit_data();
+    void recursiveSplit();
+    void tryStartFromPoolThreads_data();
+    void tryStartFromPoolThreads();
 };
 
 tst_QThreadPool::tst_QThreadPool()
@@ -75,6 +81,162 @@ void tst_QThreadPool::activeThreadCount()
     }
 }
 
+/*
+    The following cases compare the pool's queue with work stealing
+    (QT_THREADPOOL_WORK_STEALING=1) for 1 to 64 threads. On a machine with
+    few cores they only show the overhead per task. On a many-core machine,
+    the expected results are:
+
+    \list
+    \li With the queue, every task takes the pool's mutex twice: once to
+        be queued, once to be taken by a thread. Throughput stops growing
+        once these critical sections keep the mutex busy, typically
+        somewhere between 4 and 16 threads, and then goes down as the
+        mutex's cache line moves between cores.
+    \li With work stealing, a task started from a pool thread takes no
+        lock but its thread's local queue lock, which is uncontended unless
+        another thread steals from it. The pool's mutex is only taken to
+        wake up an idle thread. Throughput is expected to keep growing with
+        the number of threads, up to the number of cores.
+    \endlist
+*/
+static void threadCountData()
+{
+    QTest::addColumn<bool>("workStealing");
+    QTest::addColumn<int>("threadCount");
+
+    for (int threadCount = 1; threadCount <= 64; threadCount *= 2) {
+        QTest::addRow("queue-%d", threadCount) << false << threadCount;
+        QTest::addRow("stealing-%d", threadCount) << true << threadCount;
+    }
+}
+
+static void createThreadPool(std::unique_ptr<QThreadPool> &threadPool)
+{
+    QFETCH(bool, workStealing);
+    QFETCH(int, threadCount);
+
+    if (workStealing)
+        qputenv("QT_THREADPOOL_WORK_STEALING", "1");
+    threadPool = std::make_unique<QThreadPool>();
+    qunsetenv("QT_THREADPOOL_WORK_STEALING");
+    threadPool->setMaxThreadCount(threadCount);
+}
+
+static void spinWork()
+{
+    volatile int sink = 0;
+    for (int i = 0; i < 100; ++i)
+        sink = sink + i;
+}
+
+void tst_QThreadPool::startFromPoolThreads_data()
+{
+    threadCountData();
+}
+
+// a few pool threads each start many small tasks, like QtConcurrent::map
+// over many items
+void tst_QThreadPool::startFromPoolThreads()
+{
+    std::unique_ptr<QThreadPool> threadPool;
+    createThreadPool(threadPool);
+
+    constexpr int Producers = 8;
+    constexpr int TasksPerProducer = 10000;
+    QSemaphore done;
+    QBENCHMARK {
+        for (int i = 0; i < Producers; ++i) {
+            threadPool->start([&] {
+                for (int j = 0; j < TasksPerProducer; ++j) {
+                    threadPool->start([&done] {
+                        spinWork();
+                        done.release();
+                    });
+                }
+            });
+        }
+        done.acquire(Producers * TasksPerProducer);
+    }
+}
+
+void tst_QThreadPool::recursiveSplit_data()
+{
+    threadCountData();
+}
+
+static void split(QThreadPool *threadPool, QSemaphore *done, int size)
+{
+    // divide and conquer down to single items
+    while (size > 1) {
+        const int half = size / 2;
+        threadPool->start([=] { split(threadPool, done, half); });
+        size -= half;
+    }
+    spinWork();
+    done->release();
+}
+
+void tst_QThreadPool::recursiveSplit()
+{
+    std::unique_ptr<QThreadPool> threadPool;
+    createThreadPool(threadPool);
+
+    constexpr int Items = 1 << 16;
+    QSemaphore done;
+    QBENCHMARK {
+        threadPool->start([&] { split(threadPool.get(), &done, Items); });
+        done.acquire(Items);
+    }
+}
+
+void tst_QThreadPool::tryStartFromPoolThreads_data()
+{
+    threadCountData();
+}
+
+// QtConcurrent's thread engines call tryStart() from every worker after
+// every block of items, to start more workers while the pool has room
+void tst_QThreadPool::tryStartFromPoolThreads()
+{
+    std::unique_ptr<QThreadPool> threadPool;
+    createThreadPool(threadPool);
+
+    struct Engine : QRunnable
+    {
+        QThreadPool *threadPool = nullptr;
+        QAtomicInt next = 0;
+        QAtomicInt workers = 1;
+        QSemaphore finished;
+        int items = 0;
+
+        void run() override
+        {
+            for (int i; (i = next.fetchAndAddRelaxed(1)) < items; ) {
+                if (next.loadRelaxed() < items) {
+                    workers.ref();
+                    if (!threadPool->tryStart(this))
+                        workers.deref();
+                }
+                spinWork();
+            }
+            if (!workers.deref())
+                finished.release();
+        }
+    } engine;
+    engine.setAutoDelete(false);
+    engine.threadPool = threadPool.get();
+    engine.items = 100000;
+
+    QBENCHMARK {
+        engine.next.storeRelaxed(0);
+        engine.workers.storeRelaxed(1);
+        threadPool->start(&engine);
+        engine.finished.acquire();
+        QVERIFY(threadPool->waitForDone());
+    }
+}
+
 QTEST_MAIN(tst_QThreadPool)
 
 #include "tst_bench_qthreadpool.moc"
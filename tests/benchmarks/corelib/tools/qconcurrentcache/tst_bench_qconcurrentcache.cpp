@@ -0,0 +1,122 @@
+/****************************************************************************
+**
+** Copyright (C) 2022 The Qt Company Ltd.
+** Contact: https://www.qt.io/licensing/
+**
+** This file is part of the test suite of the Qt Toolkit.
+**
+** $QT_BEGIN_LICENSE:GPL-EXCEPT$
+** Commercial License Usage
+** Licensees holding valid commercial Qt licenses may use this file in
+** accordance with the commercial license agreement provided with the
+** Software or, alternatively, in accordance with the terms contained in
+** a written agreement between you and The Qt Company. For licensing terms
+** and conditions see https://www.qt.io/terms-conditions. For further
+** information use the contact form at https://www.qt.io/contact-us.
+**
+** GNU General Public License Usage
+** Alternatively, this file may be used under the terms of the GNU
+** General Public License version 3 as published by the Free Software
+** Foundation with exceptions as appearing in the file LICENSE.GPL3-EXCEPT
+** included in the packaging of this file. Please review the following
+** information to ensure the GNU General Public License requirements will
+** be met: https://www.gnu.org/licenses/gpl-3.0.html.
+**
+** $QT_END_LICENSE$
+**
+****************************************************************************/
+
+
+#include <QTest>
+#include <QCache>
+#include <QConcurrentCache>
+#include <QMutex>
+#include <QThread>
+
+#include <memory>
+#include <vector>
+
+// Several threads look up keys in a cache and insert the missing ones, the
+// typical use of a cache shared by worker threads. A QCache needs a mutex
+// around it, which all threads contend on; QConcurrentCache spreads them
+// over its shards. With fewer cores than threads, the difference shrinks.
+
+class tst_QConcurrentCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void mutexCache_data() { data(); }
+    void mutexCache();
+    void concurrentCache_data() { data(); }
+    void concurrentCache();
+
+private:
+    void data();
+};
+
+static constexpr int KeyCount = 20000;
+static constexpr int LookupsPerThread = 200000;
+static constexpr int MaxCost = KeyCount * 3 / 4;
+
+struct Value
+{
+    explicit Value(int k) : key(k) {}
+    int key;
+};
+
+template <typename Lookup>
+static void runThreads(int threadCount, Lookup lookup)
+{
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back(QThread::create([&lookup, t] {
+            uint key = uint(t) * 7919u;
+            for (int i = 0; i < LookupsPerThread; ++i) {
+                key = (key * 1103515245u + 12345u) & 0x7fffffff;
+                lookup(int(key % KeyCount));
+            }
+        }));
+        threads.back()->start();
+    }
+    for (auto &thread : threads)
+        thread->wait();
+}
+
+void tst_QConcurrentCache::data()
+{
+    QTest::addColumn<int>("threadCount");
+    for (int n : { 1, 2, 4, 8, 16 })
+        QTest::addRow("%d-threads", n) << n;
+}
+
+void tst_QConcurrentCache::mutexCache()
+{
+    QFETCH(int, threadCount);
+    QCache<int, Value> cache(MaxCost);
+    QMutex mutex;
+    QBENCHMARK {
+        runThreads(threadCount, [&](int key) {
+            QMutexLocker locker(&mutex);
+            if (!cache.object(key))
+                cache.insert(key, new Value(key));
+        });
+    }
+}
+
+void tst_QConcurrentCache::concurrentCache()
+{
+    QFETCH(int, threadCount);
+    QConcurrentCache<int, Value> cache(MaxCost);
+    QBENCHMARK {
+        runThreads(threadCount, [&](int key) {
+            if (!cache.object(key))
+                cache.insert(key, new Value(key));
+        });
+    }
+    qDebug("hits %llu, misses %llu, evictions %llu", cache.hitCount(), cache.missCount(),
+           cache.evictionCount());
+}
+
+QTEST_MAIN(tst_QConcurrentCache)
+
+#include "tst_bench_qconcurrentcache.moc"
@@ -31,6 +31,7 @@
 #include <QFile>
 #include <QRandomGenerator>
 #include <QString>
+#include <QTemporaryFile>
 #include <QTest>
 
 #include <time.h>
@@ -50,6 +51,10 @@ private Q_SLOTS:
     void addData();
     void addDataChunked_data() { hash_data(); }
     void addDataChunked();
+    void hashMany_data();
+    void hashMany();
+    void addDataDevice_data();
+    void addDataDevice();
 };
 
 const int MaxCryptoAlgorithm = QCryptographicHash::Sha3_512;
@@ -183,6 +188,68 @@ void tst_QCryptographicHash::addDataChunked()
     }
 }
 
+void tst_QCryptographicHash::hashMany_data()
+{
+    QTest::addColumn<int>("algorithm");
+    QTest::addColumn<int>("messageSize");
+
+    // many small independent messages, as in a content-addressed store
+    static const int messageSizes[] = { 32, 256, 4096 };
+    for (int messageSize : messageSizes) {
+        for (int algo = QCryptographicHash::Md4; algo <= MaxCryptoAlgorithm; ++algo)
+            QTest::newRow(algoname(algo) + QByteArray::number(messageSize)) << algo << messageSize;
+    }
+}
+
+void tst_QCryptographicHash::hashMany()
+{
+    QFETCH(int, algorithm);
+    QFETCH(int, messageSize);
+
+    const int MessageCount = MaxBlockSize / messageSize;
+    QList<QByteArrayView> messages;
+    for (int i = 0; i < MessageCount; ++i)
+        messages.append(QByteArrayView(blockOfData.constData() + i * messageSize, messageSize));
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QBENCHMARK {
+        QCryptographicHash::hashMany(messages, algo);
+    }
+}
+
+void tst_QCryptographicHash::addDataDevice_data()
+{
+    QTest::addColumn<int>("algorithm");
+
+    static const QCryptographicHash::Algorithm algorithms[] = {
+        QCryptographicHash::Md5, QCryptographicHash::Sha1, QCryptographicHash::Sha256,
+        QCryptographicHash::Sha512, QCryptographicHash::Blake2b_512, QCryptographicHash::Blake2s_256
+    };
+    for (QCryptographicHash::Algorithm algo : algorithms)
+        QTest::newRow(algoname(algo) + QByteArray("file")) << int(algo);
+}
+
+void tst_QCryptographicHash::addDataDevice()
+{
+    QFETCH(int, algorithm);
+
+    // a file large enough for the read loop to matter, but still in the page cache
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    for (int i = 0; i < 256; ++i)
+        QCOMPARE(file.write(blockOfData), qint64(blockOfData.size()));
+    QVERIFY(file.flush());
+
+    QCryptographicHash::Algorithm algo = QCryptographicHash::Algorithm(algorithm);
+    QCryptographicHash hash(algo);
+    QBENCHMARK {
+        QVERIFY(file.seek(0));
+        hash.reset();
+        QVERIFY(hash.addData(&file));
+        hash.result();
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_QCryptographicHash)
 
 #include "tst_bench_qcryptographichash.moc"
@@ -61,10 +61,17 @@ private slots:
     void hashing_javaString_data() { data(); }
     void hashing_javaString() { hashing_template<JavaString>(); }
 
+    void lookup_int_data() { lookupData(); }
+    void lookup_int() { lookup_template<int>(); }
+    void lookup_string_data() { lookupData(); }
+    void lookup_string() { lookup_template<QString>(); }
+
 private:
     void data();
+    void lookupData();
     template <typename String> void qhash_template();
     template <typename String> void hashing_template();
+    template <typename Key> void lookup_template();
 
     QStringList smallFilePaths;
     QStringList uuids;
@@ -169,6 +176,47 @@ template <typename String> void tst_QHash::hashing_template()
     }
 }
 
+void tst_QHash::lookupData()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("hits");
+    for (int size : { 1000, 100000, 1000000, 10000000 }) {
+        QTest::addRow("hit-%d", size) << size << true;
+        QTest::addRow("miss-%d", size) << size << false;
+    }
+}
+
+template <typename Key> static Key makeKey(int i);
+template <> int makeKey<int>(int i) { return i; }
+template <> QString makeKey<QString>(int i) { return QLatin1String("symbol_") + QString::number(i); }
+
+// Lookups in a table too large for the caches are dominated by the memory
+// accesses of probing; misses probe until the next unused bucket.
+template <typename Key> void tst_QHash::lookup_template()
+{
+    QFETCH(int, size);
+    QFETCH(bool, hits);
+
+    QHash<Key, int> hash;
+    hash.reserve(size);
+    for (int i = 0; i < size; ++i)
+        hash.insert(makeKey<Key>(2 * i), i);
+
+    // visit the table in a random order, so that the prefetcher can't help
+    constexpr int Lookups = 100000;
+    QList<Key> keys;
+    keys.reserve(Lookups);
+    for (int i = 0; i < Lookups; ++i)
+        keys.append(makeKey<Key>(2 * ((i * 7919) % size) + (hits ? 0 : 1)));
+
+    int found = 0;
+    QBENCHMARK {
+        for (const Key &key : std::as_const(keys))
+            found += hash.contains(key);
+    }
+    QCOMPARE(found > 0, hits);
+}
+
 QTEST_MAIN(tst_QHash)
 
 #include "tst_bench_qhash.moc"
@@ -36,6 +36,7 @@
 #include <QtCore/qbytearray.h>
 #include <QtCore/qvector.h>
 #include <QtCore/qelapsedtimer.h>
+#include <QtCore/qfile.h>
 #include <QtNetwork/qlocalsocket.h>
 #include <QtNetwork/qlocalserver.h>
 
@@ -48,6 +49,8 @@ private slots:
     void pingPong();
     void dataExchange_data();
     void dataExchange();
+    void manySmallWrites_data();
+    void manySmallWrites();
 };
 
 class ServerThread : public QThread
@@ -232,6 +235,84 @@ void tst_QLocalSocket::dataExchange()
     serverThread.wait();
 }
 
+// Returns the number of write system calls the process has made so far, or
+// -1 if the platform doesn't tell.
+static qint64 writeSyscalls()
+{
+#ifdef Q_OS_LINUX
+    QFile io(QStringLiteral("/proc/self/io"));
+    if (io.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        for (QByteArray line = io.readLine(); !line.isEmpty(); line = io.readLine()) {
+            if (line.startsWith("syscw:"))
+                return line.mid(6).trimmed().toLongLong();
+        }
+    }
+#endif
+    return -1;
+}
+
+void tst_QLocalSocket::manySmallWrites_data()
+{
+    QTest::addColumn<int>("bodySize");
+    for (int bodySize : {4096, 16384, 65536})
+        QTest::addRow("body size: %d", bodySize) << bodySize;
+}
+
+void tst_QLocalSocket::manySmallWrites()
+{
+    QFETCH(int, bodySize);
+
+    QLocalServer server;
+    QVERIFY2(server.listen("foo"), qPrintable(server.errorString()));
+
+    QLocalSocket client;
+    client.connectToServer("foo");
+    QVERIFY(client.waitForConnected());
+    QVERIFY(server.waitForNewConnection(5000));
+    QLocalSocket *peer = server.nextPendingConnection();
+    QVERIFY(peer);
+
+    // Queue messages made of a small header and a body, as an HTTP/1.1 proxy
+    // does; each ends up in a chunk of its own in the socket's write buffer.
+    const QByteArray header(200, 'h');
+    const QByteArray body(bodySize, 'b');
+    const int MessagesPerBatch = 16;
+    const qint64 totalSize = 128 * 1024 * 1024;
+    qint64 queued = 0;
+    qint64 received = 0;
+    QTestEventLoop eventLoop;
+
+    auto queueBatch = [&]() {
+        for (int i = 0; i < MessagesPerBatch; ++i) {
+            client.write(header.constData(), header.size());
+            client.write(body);
+            queued += header.size() + body.size();
+        }
+    };
+    connect(&client, &QLocalSocket::bytesWritten, [&]() {
+        if (client.bytesToWrite() == 0 && queued < totalSize)
+            queueBatch();
+    });
+    connect(peer, &QLocalSocket::readyRead, [&]() {
+        received += peer->skip(peer->bytesAvailable());
+        if (received >= totalSize)
+            eventLoop.exitLoop();
+    });
+
+    const qint64 syscallsBefore = writeSyscalls();
+    QElapsedTimer timer;
+    timer.start();
+    queueBatch();
+    eventLoop.enterLoop(60);
+    QVERIFY(!eventLoop.timeout());
+    const qint64 elapsed = qMax(timer.elapsed(), qint64(1));
+    const qint64 syscalls = writeSyscalls() - syscallsBefore;
+
+    qDebug("Transfer rate: %.1f MB/s, %.1f write system calls per MB",
+           received / 1048.576 / elapsed,
+           syscallsBefore < 0 ? qQNaN() : syscalls / (received / (1024.0 * 1024.0)));
+}
+
 QTEST_MAIN(tst_QLocalSocket)
 
 #include "tst_qlocalsocket.moc"
@@ -41,6 +41,8 @@ public:
 private slots:
     void pendingDatagramSize_data();
     void pendingDatagramSize();
+    void sendAndReceive_data();
+    void sendAndReceive();
 };
 
 tst_QUdpSocket::tst_QUdpSocket()
@@ -76,5 +78,57 @@ void tst_QUdpSocket::pendingDatagramSize()
     }
 }
 
+void tst_QUdpSocket::sendAndReceive_data()
+{
+    QTest::addColumn<bool>("batched");
+    QTest::addColumn<int>("size");
+    for (int size : {64, 512, 1400}) {
+        QTest::addRow("single-%d", size) << false << size;
+        QTest::addRow("batched-%d", size) << true << size;
+    }
+}
+
+// Each iteration moves 1024 datagrams over the loopback interface, so
+// the number of packets per second is 1024 divided by the time reported.
+void tst_QUdpSocket::sendAndReceive()
+{
+    QFETCH(bool, batched);
+    QFETCH(int, size);
+
+    constexpr int Packets = 1024;
+    // sent in rounds, so they fit into the socket's receive buffer
+    constexpr int Round = 64;
+
+    QUdpSocket server;
+    QVERIFY(server.bind(QHostAddress::LocalHost, 0));
+    QUdpSocket client;
+    QVERIFY(client.bind(QHostAddress::LocalHost, 0));
+
+    QNetworkDatagram datagram(QByteArray(size, 'a'), QHostAddress::LocalHost, server.localPort());
+    const QList<QNetworkDatagram> datagrams(Round, datagram);
+
+    QBENCHMARK {
+        for (int sent = 0; sent < Packets; sent += Round) {
+            if (batched) {
+                QCOMPARE(client.writeDatagrams(datagrams), Round);
+            } else {
+                for (const QNetworkDatagram &d : datagrams)
+                    QCOMPARE(client.writeDatagram(d), qint64(size));
+            }
+
+            int received = 0;
+            while (received < Round) {
+                if (batched) {
+                    received += server.receiveDatagrams(Round - received, size).size();
+                } else if (server.receiveDatagram(size).isValid()) {
+                    ++received;
+                }
+                if (received < Round && !server.hasPendingDatagrams())
+                    QVERIFY(server.waitForReadyRead(1000));
+            }
+        }
+    }
+}
+
 QTEST_MAIN(tst_QUdpSocket)
 #include "tst_qudpsocket.moc"
@@ -52,6 +52,8 @@ private slots:
     void benchmark();
     void benchmarkSelectPrepared_data() { generic_data(); }
     void benchmarkSelectPrepared();
+    void benchmarkRepeatedPrepare_data();
+    void benchmarkRepeatedPrepare();
 
 private:
     // returns all database connections
@@ -293,4 +295,52 @@ void tst_QSqlQuery::benchmarkSelectPrepared()
     tst_Databases::safeDropTable(db, tableName);
 }
 
+void tst_QSqlQuery::benchmarkRepeatedPrepare_data()
+{
+    QTest::addColumn<QString>("dbName");
+    QTest::addColumn<int>("cacheSize");
+
+    int count = 0;
+    for (const QString &dbName : std::as_const(dbs.dbNames)) {
+        const QSqlDatabase db = QSqlDatabase::database(dbName);
+        if (!db.isValid() || !db.driverName().startsWith("QSQLITE"))
+            continue;
+        for (int cacheSize : { 0, 64 }) {
+            QTest::addRow("%s:cache-%d", qPrintable(dbName), cacheSize)
+                    << dbName << cacheSize;
+        }
+        ++count;
+    }
+    if (count == 0)
+        QSKIP("No database drivers of type QSQLITE are available in this Qt configuration");
+}
+
+// ORM-style access: a fresh QSqlQuery prepares the same text for every call
+void tst_QSqlQuery::benchmarkRepeatedPrepare()
+{
+    QFETCH(QString, dbName);
+    QFETCH(int, cacheSize);
+    QSqlDatabase db = QSqlDatabase::database(dbName);
+    CHECK_DATABASE(db);
+
+    db.close();
+    db.setConnectOptions(QString("QSQLITE_STMT_CACHE_SIZE=%1").arg(cacheSize));
+    QVERIFY_SQL(db, open());
+
+    const QString select = "SELECT t_varchar, t_char FROM " + qtest + " WHERE id = ?";
+    int id = 0;
+    QBENCHMARK {
+        QSqlQuery q(db);
+        QVERIFY_SQL(q, prepare(select));
+        q.addBindValue(id % 5 + 1);
+        QVERIFY_SQL(q, exec());
+        QVERIFY(q.next());
+        ++id;
+    }
+
+    db.close();
+    db.setConnectOptions();
+    QVERIFY_SQL(db, open());
+}
+
 #include "main.moc"